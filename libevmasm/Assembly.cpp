@@ -9,6 +9,7 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/VitePeepholeOptimiser.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
@@ -19,6 +20,7 @@
 #include <libsolidity/codegen/CompilerContext.h>
 
 #include <fstream>
+#include <string_view>
 #include <json/json.h>
 
 using namespace std;
@@ -65,31 +67,32 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 namespace
 {
 
-string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
+string locationFromSources(Assembly::SourceCodeLookup const& _sourceCodes, SourceLocation const& _location)
 {
-	if (!_location.hasText() || _sourceCodes.empty())
+	if (!_location.hasText() || !_sourceCodes)
 		return "";
 
-	auto it = _sourceCodes.find(_location.source->name());
-	if (it == _sourceCodes.end())
+	string const* sourceCode = _sourceCodes(_location.source->name());
+	if (!sourceCode)
 		return "";
 
-	string const& source = it->second;
+	string const& source = *sourceCode;
 	if (static_cast<size_t>(_location.start) >= source.size())
 		return "";
 
-	string cut = source.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
-	auto newLinePos = cut.find_first_of("\n");
-	if (newLinePos != string::npos)
-		cut = cut.substr(0, newLinePos) + "...";
+	// Solidity++: only the first line of the snippet is copied.
+	string_view cut = string_view(source).substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
+	auto newLinePos = cut.find_first_of('\n');
+	if (newLinePos != string_view::npos)
+		return string(cut.substr(0, newLinePos)) + "...";
 
-	return cut;
+	return string(cut);
 }
 
 class Functionalizer
 {
 public:
-	Functionalizer (ostream& _out, string const& _prefix, StringMap const& _sourceCodes, Assembly const& _assembly):
+	Functionalizer (ostream& _out, string const& _prefix, Assembly::SourceCodeLookup const& _sourceCodes, Assembly const& _assembly):
 		m_out(_out), m_prefix(_prefix), m_sourceCodes(_sourceCodes), m_assembly(_assembly)
 	{}
 
@@ -166,13 +169,13 @@ private:
 
 	ostream& m_out;
 	string const& m_prefix;
-	StringMap const& m_sourceCodes;
+	Assembly::SourceCodeLookup const& m_sourceCodes;
 	Assembly const& m_assembly;
 };
 
 }
 
-void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap const& _sourceCodes) const
+void Assembly::assemblyStream(ostream& _out, string const& _prefix, SourceCodeLookup const& _sourceCodes) const
 {
 	Functionalizer f(_out, _prefix, _sourceCodes, *this);
 
@@ -210,7 +213,7 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		_out << endl << _prefix << "auxdata: 0x" << toHex(m_auxiliaryData) << endl;
 }
 
-string Assembly::assemblyString(StringMap const& _sourceCodes) const
+string Assembly::assemblyString(SourceCodeLookup const& _sourceCodes) const
 {
 	ostringstream tmp;
 	assemblyStream(tmp, "", _sourceCodes);
@@ -385,6 +388,25 @@ AssemblyItem Assembly::newImmutableAssignment(string const& _identifier)
 	return AssemblyItem{AssignImmutable, h};
 }
 
+AssemblyItem Assembly::newTagTable(vector<AssemblyItem> const& _tags)
+{
+	vector<size_t> tagIds;
+	string identifier = "tag table";
+	for (AssemblyItem const& tag: _tags)
+	{
+		assertThrow(tag.type() == Tag || tag.type() == PushTag, AssemblyException, "Tag expected.");
+		auto [subId, tagId] = tag.splitForeignPushTag();
+		assertThrow(subId == numeric_limits<size_t>::max(), AssemblyException, "Foreign tag in tag table.");
+		tagIds.push_back(tagId);
+		identifier += " " + to_string(tagId);
+	}
+	h256 h(util::blake2b(identifier));
+	m_tagTables[h] = move(tagIds);
+	// Placeholder, the positions are filled in by assemble().
+	m_data[h] = bytes(4 * _tags.size(), 0);
+	return AssemblyItem(PushData, h);
+}
+
 Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreation, size_t _runs)
 {
 	OptimiserSettings settings;
@@ -429,6 +451,10 @@ map<u256, u256> Assembly::optimiseInternal(
 		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
 	}
 
+	// Solidity++: tags in tag tables are only referenced from the data section.
+	for (auto const& table: m_tagTables)
+		_tagsReferencedFromOutside += table.second;
+
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
@@ -450,6 +476,14 @@ map<u256, u256> Assembly::optimiseInternal(
 				count++;
 				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
 			}
+
+			// Solidity++: rules for Vite specific patterns
+			VitePeepholeOptimiser vitePeepOpt{m_items};
+			while (vitePeepOpt.optimise())
+			{
+				count++;
+				assertThrow(count < 64000, OptimizerException, "Vite peephole optimizer seems to be stuck.");
+			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
@@ -471,6 +505,10 @@ map<u256, u256> Assembly::optimiseInternal(
 						"Replacement already known."
 					);
 					tagReplacements[replacement.first] = replacement.second;
+					for (auto& table: m_tagTables)
+						for (size_t& tagId: table.second)
+							if (tagId == replacement.first)
+								tagId = static_cast<size_t>(replacement.second);
 					if (_tagsReferencedFromOutside.erase(static_cast<size_t>(replacement.first)))
 						_tagsReferencedFromOutside.insert(static_cast<size_t>(replacement.second));
 				}
@@ -776,7 +814,19 @@ LinkerObject const& Assembly::assemble() const
 			bytesRef r(ret.bytecode.data() + ref->second, bytesPerDataRef);
 			toBigEndian(ret.bytecode.size(), r);
 		}
-		ret.bytecode += dataItem.second;
+		// Solidity++: fill in the positions of tag tables.
+		if (auto table = m_tagTables.find(dataItem.first); table != m_tagTables.end())
+			for (size_t tagId: table->second)
+			{
+				size_t pos = m_tagPositionsInBytecode.at(tagId);
+				assertThrow(pos != numeric_limits<size_t>::max(), AssemblyException, "Tag table entry without position.");
+				assertThrow(util::bytesRequired(pos) <= 4, AssemblyException, "Tag too large for tag table.");
+				bytes entry(4);
+				toBigEndian(pos, entry);
+				ret.bytecode += entry;
+			}
+		else
+			ret.bytecode += dataItem.second;
 	}
 
 	ret.bytecode += m_auxiliaryData;
@@ -17,6 +17,7 @@
 
 #include <json/json.h>
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <memory>
@@ -36,6 +37,10 @@ public:
 	// Solidity++: keccak256 -> blake2b
 	AssemblyItem newData(bytes const& _data) { util::h256 h(util::blake2b(util::asString(_data))); m_data[h] = _data; return AssemblyItem(PushData, h); }
 	bytes const& data(util::h256 const& _i) const { return m_data.at(_i); }
+	/// Solidity++: Creates a data item holding the bytecode positions of @a _tags as 4-byte
+	/// big-endian entries, so that code can jump through it via CODECOPY.
+	/// The tags are kept alive by the optimiser. @returns the PushData item of the table.
+	AssemblyItem newTagTable(std::vector<AssemblyItem> const& _tags);
 	AssemblyItem newSub(AssemblyPointer const& _sub) { m_subs.push_back(_sub); return AssemblyItem(PushSub, m_subs.size() - 1); }
 	Assembly const& sub(size_t _sub) const { return *m_subs.at(_sub); }
 	Assembly& sub(size_t _sub) { return *m_subs.at(_sub); }
@@ -116,14 +121,18 @@ public:
 	/// If @a _enable is not set, will perform some simple peephole optimizations.
 	Assembly& optimise(bool _enable, langutil::EVMVersion _evmVersion, bool _isCreation, size_t _runs);
 
+	/// Solidity++: @returns the source code of the given source or nullptr, used to print
+	/// snippets without copying the sources into a map.
+	using SourceCodeLookup = std::function<std::string const*(std::string const&)>;
+
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
-		StringMap const& _sourceCodes = StringMap()
+		SourceCodeLookup const& _sourceCodes = {}
 	) const;
 	void assemblyStream(
 		std::ostream& _out,
 		std::string const& _prefix = "",
-		StringMap const& _sourceCodes = StringMap()
+		SourceCodeLookup const& _sourceCodes = {}
 	) const;
 
 	/// Create a JSON representation of the assembly.
@@ -172,6 +181,8 @@ protected:
 	std::map<util::h256, std::string> m_strings;
 	std::map<util::h256, std::string> m_libraries; ///< Identifiers of libraries to be linked.
 	std::map<util::h256, std::string> m_immutables; ///< Identifiers of immutables.
+	/// Solidity++: Tag tables stored in the data section, see @a newTagTable.
+	std::map<util::h256, std::vector<size_t>> m_tagTables;
 
 	/// Map from a vector representing a path to a particular sub assembly to sub assembly id.
 	/// This map is used only for sub-assemblies which are not direct sub-assemblies (where path is having more than one value).
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Peephole optimiser rules for patterns emitted by the Solidity++ code generator.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libevmasm/VitePeepholeOptimiser.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <algorithm>
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+u256 const c_addressMask = (u256(1) << 168) - 1;
+
+/// @returns true if @a _item pushes a mask of the lowest k bits, k > 0.
+bool isLowBitMask(AssemblyItem const& _item)
+{
+	return _item.type() == Push && _item.data() != 0 && (_item.data() & (_item.data() + 1)) == 0;
+}
+
+/// @returns true if all bits of @a _value are within @a _mask.
+bool withinMask(u256 const& _value, u256 const& _mask)
+{
+	return (_value & _mask) == _value;
+}
+
+/// @returns true if @a _item always pushes a 168-bit address.
+bool pushesAddress(AssemblyItem const& _item)
+{
+	return _item == Instruction::ADDRESS || _item == Instruction::CALLER;
+}
+
+/// @returns true if the stack contents are not known after @a _item.
+bool endsBasicBlock(AssemblyItem const& _item)
+{
+	if (_item.type() == Tag)
+		return true;
+	if (_item.type() != Operation)
+		return false;
+	switch (_item.instruction())
+	{
+	case Instruction::JUMP:
+	case Instruction::JUMPI:
+	case Instruction::STOP:
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+	case Instruction::INVALID:
+	case Instruction::SELFDESTRUCT:
+	case Instruction::SYNCCALL:
+	case Instruction::CALLBACKDEST:
+		return true;
+	default:
+		return false;
+	}
+}
+
+}
+
+bool VitePeepholeOptimiser::optimise()
+{
+	bool changed = removeRedundantMasks();
+	changed = deduplicateConstants() || changed;
+	return changed;
+}
+
+bool VitePeepholeOptimiser::removeRedundantMasks()
+{
+	bool changed = false;
+	AssemblyItems optimised;
+	optimised.reserve(m_items.size());
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		AssemblyItem const& item = m_items[i];
+		if (isLowBitMask(item) && i + 1 < m_items.size() && m_items[i + 1] == Instruction::AND && !optimised.empty())
+		{
+			u256 const& mask = item.data();
+			AssemblyItem const& previous = optimised.back();
+			bool clean = false;
+			// PUSH c PUSH mask AND
+			if (previous.type() == Push)
+				clean = withinMask(previous.data(), mask);
+			// CALLER PUSH addressMask AND
+			else if (pushesAddress(previous))
+				clean = withinMask(c_addressMask, mask);
+			// PUSH mask' AND PUSH mask AND
+			else if (previous == Instruction::AND && optimised.size() >= 2 && isLowBitMask(optimised[optimised.size() - 2]))
+				clean = withinMask(optimised[optimised.size() - 2].data(), mask);
+
+			if (clean)
+			{
+				// Skip the mask and the AND.
+				++i;
+				changed = true;
+				continue;
+			}
+		}
+		optimised.push_back(item);
+	}
+	if (changed)
+		m_items = move(optimised);
+	return changed;
+}
+
+bool VitePeepholeOptimiser::deduplicateConstants()
+{
+	bool changed = false;
+	// Known constants on the stack of the current basic block, top at the back.
+	// Slots below the start of the block are not tracked.
+	vector<optional<u256>> stack;
+	for (AssemblyItem& item: m_items)
+	{
+		if (item.type() == Push && item.data() > 0xff)
+			for (size_t depth = 1; depth <= min<size_t>(16, stack.size()); ++depth)
+				if (stack[stack.size() - depth] == item.data())
+				{
+					item = AssemblyItem(dupInstruction(static_cast<unsigned>(depth)), item.location());
+					changed = true;
+					break;
+				}
+
+		if (endsBasicBlock(item))
+			stack.clear();
+		else if (item.type() == Operation && isDupInstruction(item.instruction()))
+		{
+			size_t depth = getDupNumber(item.instruction());
+			stack.push_back(depth <= stack.size() ? stack[stack.size() - depth] : nullopt);
+		}
+		else if (item.type() == Operation && isSwapInstruction(item.instruction()))
+		{
+			size_t depth = getSwapNumber(item.instruction());
+			if (stack.size() < depth + 1)
+				stack.insert(stack.begin(), depth + 1 - stack.size(), nullopt);
+			swap(stack.back(), stack[stack.size() - 1 - depth]);
+		}
+		else
+		{
+			stack.resize(stack.size() - min(stack.size(), item.arguments()));
+			if (item.type() == Push)
+				stack.emplace_back(item.data());
+			else
+				stack.resize(stack.size() + item.returnValues(), nullopt);
+		}
+	}
+	return changed;
+}
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Peephole optimiser rules for patterns emitted by the Solidity++ code generator.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Vite specific peephole rules, run after the upstream PeepholeOptimiser:
+ *  - masks that cannot change the value below them are removed, e.g. the 168-bit address
+ *    cleanup after CALLER, after a constant, or after an identical mask;
+ *  - a constant of two or more bytes that is still on the stack of the same basic block,
+ *    like the default token id of consecutive calls, is duplicated instead of pushed again.
+ *    DUP costs the same quota as PUSH but is one byte instead of up to 33.
+ */
+class VitePeepholeOptimiser
+{
+public:
+	explicit VitePeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
+
+	/// @returns true if the items were changed.
+	bool optimise();
+
+private:
+	bool removeRedundantMasks();
+	bool deduplicateConstants();
+
+	AssemblyItems& m_items;
+};
+
+}
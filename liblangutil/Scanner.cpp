@@ -0,0 +1,1189 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Solidity++ scanner.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ * Solidity++: whitespace, comment bodies and identifiers are scanned in blocks of sixteen
+ * characters where SSE2 is available. Sources are mostly NatSpec and indentation, which the
+ * upstream scanner consumed one character at a time.
+ */
+
+#include <liblangutil/Common.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/Scanner.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <tuple>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace solidity::langutil
+{
+
+string to_string(ScannerError _errorCode)
+{
+	switch (_errorCode)
+	{
+		case ScannerError::NoError: return "No error.";
+		case ScannerError::IllegalToken: return "Invalid token.";
+		case ScannerError::IllegalHexString: return "Expected even number of hex-nibbles.";
+		case ScannerError::IllegalHexDigit: return "Hexadecimal digit missing or invalid.";
+		case ScannerError::IllegalCommentTerminator: return "Expected multi-line comment-terminator.";
+		case ScannerError::IllegalEscapeSequence: return "Invalid escape sequence.";
+		case ScannerError::IllegalCharacterInString: return "Invalid character in string.";
+		case ScannerError::IllegalStringEndQuote: return "Expected string end-quote.";
+		case ScannerError::IllegalNumberSeparator: return "Invalid use of number separator '_'.";
+		case ScannerError::IllegalExponent: return "Invalid exponent.";
+		case ScannerError::IllegalNumberEnd: return "Identifier-start is not allowed at end of a number.";
+		case ScannerError::OctalNotAllowed: return "Octal numbers not allowed.";
+		case ScannerError::DirectionalOverrideUnderflow: return "Unicode direction override underflow in comment or string literal.";
+		case ScannerError::DirectionalOverrideMismatch: return "Mismatching directional override markers in comment or string literal.";
+		default:
+			solAssert(false, "Unhandled case in to_string(ScannerError)");
+			return "";
+	}
+}
+
+ostream& operator<<(ostream& os, ScannerError _errorCode)
+{
+	return os << to_string(_errorCode);
+}
+
+/// Scoped helper for literal recording. Automatically drops the literal
+/// if aborting the scanning before it's complete.
+enum LiteralType
+{
+	LITERAL_TYPE_STRING,
+	LITERAL_TYPE_NUMBER, // not really different from string type in behaviour
+	LITERAL_TYPE_COMMENT
+};
+
+class LiteralScope
+{
+public:
+	explicit LiteralScope(Scanner* _self, enum LiteralType _type):
+		m_type(_type),
+		m_scanner(_self),
+		m_complete(false)
+	{
+		if (_type == LITERAL_TYPE_COMMENT)
+			m_scanner->m_skippedComments[Scanner::NextNext].literal.clear();
+		else
+			m_scanner->m_tokens[Scanner::NextNext].literal.clear();
+	}
+	~LiteralScope()
+	{
+		if (!m_complete)
+		{
+			if (m_type == LITERAL_TYPE_COMMENT)
+				m_scanner->m_skippedComments[Scanner::NextNext].literal.clear();
+			else
+				m_scanner->m_tokens[Scanner::NextNext].literal.clear();
+		}
+	}
+	void complete() { m_complete = true; }
+
+private:
+	enum LiteralType m_type;
+	Scanner* m_scanner;
+	bool m_complete;
+};
+
+namespace
+{
+
+// Solidity++: character classes for skipWhile(). Each class tests single characters and, with
+// SSE2, sixteen characters at once, setting all bits of the bytes that belong to the class.
+
+#if defined(__SSE2__)
+__m128i equalTo(__m128i _chunk, char _c)
+{
+	return _mm_cmpeq_epi8(_chunk, _mm_set1_epi8(_c));
+}
+
+/// Unsigned range check: x >= low iff max(x, low) == x, and x <= high iff min(x, high) == x.
+__m128i inRange(__m128i _chunk, uint8_t _low, uint8_t _high)
+{
+	__m128i atLeastLow = _mm_cmpeq_epi8(_mm_max_epu8(_chunk, _mm_set1_epi8(static_cast<char>(_low))), _chunk);
+	__m128i atMostHigh = _mm_cmpeq_epi8(_mm_min_epu8(_chunk, _mm_set1_epi8(static_cast<char>(_high))), _chunk);
+	return _mm_and_si128(atLeastLow, atMostHigh);
+}
+
+__m128i complement(__m128i _mask)
+{
+	return _mm_xor_si128(_mask, _mm_set1_epi8(-1));
+}
+#endif
+
+/// Space, tab, LF and CR.
+struct Whitespace
+{
+	static bool matches(char _c) { return isWhiteSpace(_c); }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _chunk)
+	{
+		return _mm_or_si128(
+			_mm_or_si128(equalTo(_chunk, ' '), equalTo(_chunk, '\t')),
+			_mm_or_si128(equalTo(_chunk, '\n'), equalTo(_chunk, '\r'))
+		);
+	}
+#endif
+};
+
+/// Letters, digits, '_' and '$'.
+struct IdentifierPart
+{
+	static bool matches(char _c) { return isIdentifierPart(_c); }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _chunk)
+	{
+		// Setting bit 5 maps upper case letters to lower case ones and nothing else into a-z.
+		__m128i lower = _mm_or_si128(_chunk, _mm_set1_epi8(0x20));
+		return _mm_or_si128(
+			_mm_or_si128(inRange(lower, 'a', 'z'), inRange(_chunk, '0', '9')),
+			_mm_or_si128(equalTo(_chunk, '_'), equalTo(_chunk, '$'))
+		);
+	}
+#endif
+};
+
+/// Identifier characters of Yul, which may also contain periods.
+struct YulIdentifierPart
+{
+	static bool matches(char _c) { return isIdentifierPart(_c) || _c == '.'; }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _chunk)
+	{
+		return _mm_or_si128(IdentifierPart::matches(_chunk), equalTo(_chunk, '.'));
+	}
+#endif
+};
+
+/// Characters of a single-line comment that cannot start a line break: everything but
+/// LF, VT, FF, CR and the first bytes of NEL (C2 85), LS (E2 80 A8) and PS (E2 80 A9).
+struct SingleLineCommentText
+{
+	static bool matches(char _c)
+	{
+		auto c = static_cast<uint8_t>(_c);
+		return (c < 0x0a || c > 0x0d) && c != 0xc2 && c != 0xe2;
+	}
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _chunk)
+	{
+		return complement(_mm_or_si128(
+			inRange(_chunk, 0x0a, 0x0d),
+			_mm_or_si128(equalTo(_chunk, '\xc2'), equalTo(_chunk, '\xe2'))
+		));
+	}
+#endif
+};
+
+/// Characters of a multi-line documentation comment that need no special handling.
+struct MultiLineDocCommentText
+{
+	static bool matches(char _c) { return _c != '\n' && _c != '\r' && _c != '*'; }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _chunk)
+	{
+		return complement(_mm_or_si128(
+			_mm_or_si128(equalTo(_chunk, '\n'), equalTo(_chunk, '\r')),
+			equalTo(_chunk, '*')
+		));
+	}
+#endif
+};
+
+/// Characters of a multi-line comment that cannot start its terminator.
+struct MultiLineCommentText
+{
+	static bool matches(char _c) { return _c != '*'; }
+#if defined(__SSE2__)
+	static __m128i matches(__m128i _chunk) { return complement(equalTo(_chunk, '*')); }
+#endif
+};
+
+/// Solidity++: @returns the position of the first character at or after @a _position in @a _text
+/// that is not in the character class @a Class, or the size of @a _text.
+template <class Class>
+size_t skipWhile(string const& _text, size_t _position)
+{
+#if defined(__SSE2__)
+	for (; _position + 16 <= _text.size(); _position += 16)
+	{
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_text.data() + _position));
+		auto mismatches = static_cast<unsigned>(~_mm_movemask_epi8(Class::matches(chunk))) & 0xffffu;
+		if (mismatches)
+			return _position + static_cast<size_t>(__builtin_ctz(mismatches));
+	}
+#endif
+	while (_position < _text.size() && Class::matches(_text[_position]))
+		++_position;
+	return _position;
+}
+
+/// Checks that the unicode direction overrides (LRE, RLE, LRO and RLO, closed by PDF) between
+/// @a _startPosition and @a _endPosition in @a _text are balanced. On an underflow, @a _endPosition
+/// is set to the offending PDF.
+/// Solidity++: all markers start with E2, which is searched with memchr.
+ScannerError validateBiDiMarkup(string const& _text, size_t _startPosition, size_t& _endPosition)
+{
+	int directionOverrideDepth = 0;
+	for (size_t position = _startPosition; position < _endPosition; ++position)
+	{
+		auto found = static_cast<char const*>(memchr(_text.data() + position, '\xe2', _endPosition - position));
+		if (!found)
+			break;
+		position = static_cast<size_t>(found - _text.data());
+		if (position + 2 >= _text.size() || static_cast<uint8_t>(_text[position + 1]) != 0x80)
+			continue;
+		switch (static_cast<uint8_t>(_text[position + 2]))
+		{
+		case 0xaa: // U+202A (LRE = Left-to-Right Embedding)
+		case 0xab: // U+202B (RLE = Right-to-Left Embedding)
+		case 0xad: // U+202D (LRO = Left-to-Right Override)
+		case 0xae: // U+202E (RLO = Right-to-Left Override)
+			++directionOverrideDepth;
+			break;
+		case 0xac: // U+202C (PDF = Pop Directional Format)
+			if (--directionOverrideDepth < 0)
+			{
+				_endPosition = position;
+				return ScannerError::DirectionalOverrideUnderflow;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	return directionOverrideDepth > 0 ? ScannerError::DirectionalOverrideMismatch : ScannerError::NoError;
+}
+
+}
+
+bool Scanner::skipWhitespace()
+{
+	size_t const startPosition = sourcePos();
+	advanceTo(skipWhile<Whitespace>(source(), startPosition));
+	// Return whether or not we skipped any characters.
+	return sourcePos() != startPosition;
+}
+
+bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
+{
+	size_t const startPosition = sourcePos();
+	while (isWhiteSpace(m_char) && !isUnicodeLinebreak())
+		advance();
+	// Return whether or not we skipped any characters.
+	return sourcePos() != startPosition;
+}
+
+void Scanner::reset(CharStream _source)
+{
+	m_source = make_shared<CharStream>(std::move(_source));
+	reset();
+}
+
+void Scanner::reset(shared_ptr<CharStream> _source)
+{
+	solAssert(_source.get() != nullptr, "You MUST provide a CharStream when resetting.");
+	m_source = std::move(_source);
+	reset();
+}
+
+void Scanner::reset()
+{
+	m_source->reset();
+	m_kind = ScannerKind::Solidity;
+	m_char = m_source->get();
+	skipWhitespace();
+	next();
+	next();
+	next();
+}
+
+void Scanner::setPosition(size_t _offset)
+{
+	advanceTo(_offset);
+	scanToken();
+	next();
+	next();
+}
+
+void Scanner::advanceTo(size_t _position)
+{
+	m_source->setPosition(_position);
+	m_char = _position < source().size() ? source()[_position] : 0;
+}
+
+void Scanner::rescan()
+{
+	size_t rollbackTo = 0;
+	if (m_skippedComments[Current].literal.empty())
+		rollbackTo = static_cast<size_t>(m_tokens[Current].location.start);
+	else
+		rollbackTo = static_cast<size_t>(m_skippedComments[Current].location.start);
+	advanceTo(rollbackTo);
+	next();
+	next();
+	next();
+}
+
+Token Scanner::next()
+{
+	m_tokens[Current] = std::move(m_tokens[Next]);
+	m_tokens[Next] = std::move(m_tokens[NextNext]);
+	m_skippedComments[Current] = std::move(m_skippedComments[Next]);
+	m_skippedComments[Next] = std::move(m_skippedComments[NextNext]);
+
+	scanToken();
+
+	return m_tokens[Current].token;
+}
+
+Token Scanner::selectToken(char _next, Token _then, Token _else)
+{
+	advance();
+	if (m_char == _next)
+		return selectToken(_then);
+	else
+		return _else;
+}
+
+bool Scanner::scanHexByte(char& o_scannedByte)
+{
+	char x = 0;
+	for (size_t i = 0; i < 2; i++)
+	{
+		int d = hexValue(m_char);
+		if (d < 0)
+		{
+			rollback(i);
+			return false;
+		}
+		x = static_cast<char>(x * 16 + d);
+		advance();
+	}
+	o_scannedByte = x;
+	return true;
+}
+
+std::optional<unsigned> Scanner::scanUnicode()
+{
+	unsigned x = 0;
+	for (size_t i = 0; i < 4; i++)
+	{
+		int d = hexValue(m_char);
+		if (d < 0)
+		{
+			rollback(i);
+			return {};
+		}
+		x = x * 16 + static_cast<unsigned>(d);
+		advance();
+	}
+	return x;
+}
+
+// This supports codepoints between 0000 and FFFF.
+void Scanner::addUnicodeAsUTF8(unsigned codepoint)
+{
+	if (codepoint <= 0x7f)
+		addLiteralChar(char(codepoint));
+	else if (codepoint <= 0x7ff)
+	{
+		addLiteralChar(char(0xc0u | (codepoint >> 6)));
+		addLiteralChar(char(0x80u | (codepoint & 0x3fu)));
+	}
+	else
+	{
+		addLiteralChar(char(0xe0u | (codepoint >> 12)));
+		addLiteralChar(char(0x80u | ((codepoint >> 6) & 0x3fu)));
+		addLiteralChar(char(0x80u | (codepoint & 0x3fu)));
+	}
+}
+
+bool Scanner::isUnicodeLinebreak()
+{
+	if (0x0a <= m_char && m_char <= 0x0d)
+		// line feed, vertical tab, form feed, carriage return
+		return true;
+	if (!m_source->isPastEndOfInput(1) && uint8_t(m_source->get(0)) == 0xc2 && uint8_t(m_source->get(1)) == 0x85)
+		// NEL - U+0085, C2 85 in utf8
+		return true;
+	if (!m_source->isPastEndOfInput(2) && uint8_t(m_source->get(0)) == 0xe2 && uint8_t(m_source->get(1)) == 0x80 && (
+		uint8_t(m_source->get(2)) == 0xa8 || uint8_t(m_source->get(2)) == 0xa9
+	))
+		// LS - U+2028, E2 80 A8  in utf8
+		// PS - U+2029, E2 80 A9  in utf8
+		return true;
+	return false;
+}
+
+Token Scanner::skipSingleLineComment()
+{
+	// Line terminator is not part of the comment. If it is a
+	// non-ascii line terminator, it will result in a parser error.
+	size_t startPosition = m_source->position();
+	while (true)
+	{
+		// Solidity++: only the first bytes of line breaks are checked one by one.
+		advanceTo(skipWhile<SingleLineCommentText>(source(), sourcePos()));
+		if (isSourcePastEndOfInput() || isUnicodeLinebreak())
+			break;
+		advance();
+	}
+
+	size_t endPosition = sourcePos();
+	ScannerError unicodeDirectionError = validateBiDiMarkup(source(), startPosition, endPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+	{
+		advanceTo(endPosition);
+		return setError(unicodeDirectionError);
+	}
+
+	return Token::Whitespace;
+}
+
+bool Scanner::atEndOfLine() const
+{
+	return m_char == '\n' || m_char == '\r';
+}
+
+bool Scanner::tryScanEndOfLine()
+{
+	if (m_char == '\n')
+	{
+		advance();
+		return true;
+	}
+
+	if (m_char == '\r')
+	{
+		if (advance() && m_char == '\n')
+			advance();
+		return true;
+	}
+
+	return false;
+}
+
+size_t Scanner::scanSingleLineDocComment()
+{
+	LiteralScope literal(this, LITERAL_TYPE_COMMENT);
+	size_t endPosition = m_source->position();
+
+	skipWhitespaceExceptUnicodeLinebreak();
+
+	while (!isSourcePastEndOfInput())
+	{
+		endPosition = m_source->position();
+		if (tryScanEndOfLine())
+		{
+			// Check if next line is also a single-line comment.
+			// If any whitespaces were skipped, use source position before.
+			if (!skipWhitespaceExceptUnicodeLinebreak())
+				endPosition = m_source->position();
+
+			if (!m_source->isPastEndOfInput(3) &&
+				m_source->get(0) == '/' &&
+				m_source->get(1) == '/' &&
+				m_source->get(2) == '/')
+			{
+				if (!m_source->isPastEndOfInput(4) && m_source->get(3) == '/')
+					break; // "////" is not a documentation comment
+				m_char = m_source->advanceAndGet(3);
+				if (atEndOfLine())
+					continue;
+				addCommentLiteralChar('\n');
+			}
+			else
+				break; // next line is not a documentation comment, we are done
+		}
+		else if (isUnicodeLinebreak())
+			// Any line terminator that is not '\n' is considered to end the
+			// comment.
+			break;
+
+		// Solidity++: the text up to the next possible line break is copied at once. As when
+		// copying it character by character, the end position is that of the last character.
+		size_t textEnd = skipWhile<SingleLineCommentText>(source(), sourcePos());
+		if (textEnd > sourcePos() + 1)
+		{
+			m_skippedComments[NextNext].literal.append(source(), sourcePos(), textEnd - sourcePos());
+			endPosition = textEnd - 1;
+			advanceTo(textEnd);
+			continue;
+		}
+		addCommentLiteralChar(m_char);
+		advance();
+	}
+	literal.complete();
+	return endPosition;
+}
+
+Token Scanner::skipMultiLineComment()
+{
+	size_t startPosition = m_source->position();
+	while (!isSourcePastEndOfInput())
+	{
+		// Solidity++: only stars can start the terminator.
+		advanceTo(skipWhile<MultiLineCommentText>(source(), sourcePos()));
+		if (isSourcePastEndOfInput())
+			break;
+
+		char prevChar = m_char;
+		advance();
+
+		// If we have reached the end of the multi-line comment, we
+		// consume the '/' and return a whitespace. This way all
+		// multi-line comments are treated as whitespace.
+		if (prevChar == '*' && m_char == '/')
+		{
+			size_t endPosition = sourcePos();
+			ScannerError unicodeDirectionError = validateBiDiMarkup(source(), startPosition, endPosition);
+			if (unicodeDirectionError != ScannerError::NoError)
+			{
+				advanceTo(endPosition);
+				return setError(unicodeDirectionError);
+			}
+
+			advance();
+			return Token::Whitespace;
+		}
+	}
+	// Unterminated multi-line comment.
+	return setError(ScannerError::IllegalCommentTerminator);
+}
+
+Token Scanner::scanMultiLineDocComment()
+{
+	LiteralScope literal(this, LITERAL_TYPE_COMMENT);
+	bool endFound = false;
+	bool charsAdded = false;
+
+	skipWhitespaceExceptUnicodeLinebreak();
+
+	while (!isSourcePastEndOfInput())
+	{
+		//handle newlines in multiline comments
+		if (atEndOfLine())
+		{
+			skipWhitespace();
+			if (!m_source->isPastEndOfInput(1) && m_source->get(0) == '*' && m_source->get(1) == '*')
+			{ // it is unknown if this leads to the end of the comment
+				addCommentLiteralChar('*');
+				advance();
+			}
+			else if (!m_source->isPastEndOfInput(1) && m_source->get(0) == '*' && m_source->get(1) != '/')
+			{ // skip first '*' in subsequent lines
+				m_char = m_source->advanceAndGet(1);
+				if (atEndOfLine()) // ignores empty lines
+					continue;
+				if (charsAdded)
+					addCommentLiteralChar('\n'); // corresponds to the end of previous line
+			}
+			else if (!m_source->isPastEndOfInput(1) && m_source->get(0) == '*' && m_source->get(1) == '/')
+			{ // if after newline the comment ends, don't insert the newline
+				m_char = m_source->advanceAndGet(2);
+				endFound = true;
+				break;
+			}
+			else if (charsAdded)
+				addCommentLiteralChar('\n');
+		}
+
+		if (!m_source->isPastEndOfInput(1) && m_source->get(0) == '*' && m_source->get(1) == '/')
+		{
+			m_char = m_source->advanceAndGet(2);
+			endFound = true;
+			break;
+		}
+
+		// Solidity++: the text up to the next line break or star is copied at once.
+		size_t textEnd = skipWhile<MultiLineDocCommentText>(source(), sourcePos());
+		if (textEnd > sourcePos() + 1)
+		{
+			m_skippedComments[NextNext].literal.append(source(), sourcePos(), textEnd - sourcePos());
+			charsAdded = true;
+			advanceTo(textEnd);
+			continue;
+		}
+		addCommentLiteralChar(m_char);
+		charsAdded = true;
+		advance();
+	}
+	literal.complete();
+	if (!endFound)
+		return setError(ScannerError::IllegalCommentTerminator);
+	else
+		return Token::CommentLiteral;
+}
+
+Token Scanner::scanSlash()
+{
+	int firstSlashPosition = static_cast<int>(sourcePos());
+	advance();
+	if (m_char == '/')
+	{
+		if (!advance()) /* double slash comment directly before EOS */
+			return Token::Whitespace;
+		else if (m_char == '/')
+		{
+			advance(); //consume the last '/' at ///
+
+			// "////"
+			if (m_char == '/')
+				return skipSingleLineComment();
+			// doxygen style /// comment
+			m_skippedComments[NextNext].location.start = firstSlashPosition;
+			m_skippedComments[NextNext].location.source = m_source;
+			m_skippedComments[NextNext].token = Token::CommentLiteral;
+			m_skippedComments[NextNext].location.end = static_cast<int>(scanSingleLineDocComment());
+			return Token::Whitespace;
+		}
+		else
+			return skipSingleLineComment();
+	}
+	else if (m_char == '*')
+	{
+		// doxygen style /** natspec comment
+		if (!advance()) /* slash star comment before EOS */
+			return setError(ScannerError::IllegalCommentTerminator);
+		else if (m_char == '*')
+		{
+			advance(); //consume the last '*' at /**
+
+			// "/**/"
+			if (m_char == '/')
+			{
+				advance(); //skip the closing slash
+				return Token::Whitespace;
+			}
+			// "/***"
+			if (m_char == '*')
+				// "/***/" may be interpreted as empty natspec or skipped; skipping is simpler
+				return skipMultiLineComment();
+			// we actually have a multiline documentation comment
+			m_skippedComments[NextNext].location.start = firstSlashPosition;
+			m_skippedComments[NextNext].location.source = m_source;
+			Token comment = scanMultiLineDocComment();
+			m_skippedComments[NextNext].location.end = static_cast<int>(sourcePos());
+			m_skippedComments[NextNext].token = comment;
+			if (comment == Token::Illegal)
+				return Token::Illegal; // error already set
+			else
+				return Token::Whitespace;
+		}
+		else
+			return skipMultiLineComment();
+	}
+	else if (m_char == '=')
+		return selectToken(Token::AssignDiv);
+	else
+		return Token::Div;
+}
+
+void Scanner::scanToken()
+{
+	m_tokens[NextNext] = {};
+	m_skippedComments[NextNext] = {};
+
+	Token token;
+	// M and N are for the purposes of grabbing different type sizes
+	unsigned m = 0;
+	unsigned n = 0;
+	do
+	{
+		// Remember the position of the next token
+		m_tokens[NextNext].location.start = static_cast<int>(sourcePos());
+		switch (m_char)
+		{
+		case '\n':
+		case '\r':
+		case '\t':
+		case ' ':
+			skipWhitespace();
+			token = Token::Whitespace;
+			break;
+		case '"':
+		case '\'':
+			token = scanString(false);
+			break;
+		case '<':
+			// < <= << <<=
+			advance();
+			if (m_char == '=')
+				token = selectToken(Token::LessThanOrEqual);
+			else if (m_char == '<')
+				token = selectToken('=', Token::AssignShl, Token::SHL);
+			else
+				token = Token::LessThan;
+			break;
+		case '>':
+			// > >= >> >>= >>> >>>=
+			advance();
+			if (m_char == '=')
+				token = selectToken(Token::GreaterThanOrEqual);
+			else if (m_char == '>')
+			{
+				// >> >>= >>> >>>=
+				advance();
+				if (m_char == '=')
+					token = selectToken(Token::AssignSar);
+				else if (m_char == '>')
+					token = selectToken('=', Token::AssignShr, Token::SHR);
+				else
+					token = Token::SAR;
+			}
+			else
+				token = Token::GreaterThan;
+			break;
+		case '=':
+			// = == =>
+			advance();
+			if (m_char == '=')
+				token = selectToken(Token::Equal);
+			else if (m_char == '>')
+				token = selectToken(Token::DoubleArrow);
+			else
+				token = Token::Assign;
+			break;
+		case '!':
+			// ! !=
+			advance();
+			if (m_char == '=')
+				token = selectToken(Token::NotEqual);
+			else
+				token = Token::Not;
+			break;
+		case '+':
+			// + ++ +=
+			advance();
+			if (m_char == '+')
+				token = selectToken(Token::Inc);
+			else if (m_char == '=')
+				token = selectToken(Token::AssignAdd);
+			else
+				token = Token::Add;
+			break;
+		case '-':
+			// - -- -= ->
+			advance();
+			if (m_char == '-')
+				token = selectToken(Token::Dec);
+			else if (m_char == '=')
+				token = selectToken(Token::AssignSub);
+			else if (m_char == '>')
+				token = selectToken(Token::RightArrow);
+			else
+				token = Token::Sub;
+			break;
+		case '*':
+			// * ** *=
+			advance();
+			if (m_char == '*')
+				token = selectToken(Token::Exp);
+			else if (m_char == '=')
+				token = selectToken(Token::AssignMul);
+			else
+				token = Token::Mul;
+			break;
+		case '%':
+			// % %=
+			token = selectToken('=', Token::AssignMod, Token::Mod);
+			break;
+		case '/':
+			// /  // /* /=
+			token = scanSlash();
+			break;
+		case '&':
+			// & && &=
+			advance();
+			if (m_char == '&')
+				token = selectToken(Token::And);
+			else if (m_char == '=')
+				token = selectToken(Token::AssignBitAnd);
+			else
+				token = Token::BitAnd;
+			break;
+		case '|':
+			// | || |=
+			advance();
+			if (m_char == '|')
+				token = selectToken(Token::Or);
+			else if (m_char == '=')
+				token = selectToken(Token::AssignBitOr);
+			else
+				token = Token::BitOr;
+			break;
+		case '^':
+			// ^ ^=
+			token = selectToken('=', Token::AssignBitXor, Token::BitXor);
+			break;
+		case '.':
+			// . Number
+			advance();
+			if (isDecimalDigit(m_char))
+				token = scanNumber('.');
+			else
+				token = Token::Period;
+			break;
+		case ':':
+			// : :=
+			advance();
+			if (m_char == '=')
+				token = selectToken(Token::AssemblyAssign);
+			else
+				token = Token::Colon;
+			break;
+		case ';':
+			token = selectToken(Token::Semicolon);
+			break;
+		case ',':
+			token = selectToken(Token::Comma);
+			break;
+		case '(':
+			token = selectToken(Token::LParen);
+			break;
+		case ')':
+			token = selectToken(Token::RParen);
+			break;
+		case '[':
+			token = selectToken(Token::LBrack);
+			break;
+		case ']':
+			token = selectToken(Token::RBrack);
+			break;
+		case '{':
+			token = selectToken(Token::LBrace);
+			break;
+		case '}':
+			token = selectToken(Token::RBrace);
+			break;
+		case '?':
+			token = selectToken(Token::Conditional);
+			break;
+		case '~':
+			token = selectToken(Token::BitNot);
+			break;
+		default:
+			if (isIdentifierStart(m_char))
+			{
+				tie(token, m, n) = scanIdentifierOrKeyword();
+
+				// Special case for hexadecimal literals
+				if (token == Token::Hex)
+				{
+					// reset
+					m = 0;
+					n = 0;
+
+					// Special quoted hex string must follow
+					if (m_char == '"' || m_char == '\'')
+						token = scanHexString();
+					else
+						token = setError(ScannerError::IllegalToken);
+				}
+				else if (token == Token::Unicode && m_kind != ScannerKind::Yul)
+				{
+					// reset
+					m = 0;
+					n = 0;
+
+					// Special quoted hex string must follow
+					if (m_char == '"' || m_char == '\'')
+						token = scanString(true);
+					else
+						token = setError(ScannerError::IllegalToken);
+				}
+			}
+			else if (isDecimalDigit(m_char))
+				token = scanNumber();
+			else if (isSourcePastEndOfInput())
+				token = Token::EOS;
+			else
+				token = selectErrorToken(ScannerError::IllegalToken);
+			break;
+		}
+		// Continue scanning for tokens as long as we're just skipping
+		// whitespace.
+	}
+	while (token == Token::Whitespace);
+	m_tokens[NextNext].location.end = static_cast<int>(sourcePos());
+	m_tokens[NextNext].location.source = m_source;
+	m_tokens[NextNext].token = token;
+	m_tokens[NextNext].extendedTokenInfo = make_tuple(m, n);
+}
+
+bool Scanner::scanEscape()
+{
+	char c = m_char;
+
+	// Skip escaped newlines.
+	if (tryScanEndOfLine())
+		return true;
+	advance();
+
+	switch (c)
+	{
+	case '\'':  // fall through
+	case '"':  // fall through
+	case '\\':
+		break;
+	case 'n':
+		c = '\n';
+		break;
+	case 'r':
+		c = '\r';
+		break;
+	case 't':
+		c = '\t';
+		break;
+	case 'u':
+	{
+		if (auto const codepoint = scanUnicode(); codepoint.has_value())
+			addUnicodeAsUTF8(*codepoint);
+		else
+			return false;
+		return true;
+	}
+	case 'x':
+		if (!scanHexByte(c))
+			return false;
+		break;
+	default:
+		return false;
+	}
+
+	addLiteralChar(c);
+	return true;
+}
+
+Token Scanner::scanString(bool const _isUnicode)
+{
+	size_t startPosition = m_source->position();
+	char const quote = m_char;
+	advance();  // consume quote
+	LiteralScope literal(this, LITERAL_TYPE_STRING);
+	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
+	{
+		char c = m_char;
+		advance();
+		if (c == '\\')
+		{
+			if (isSourcePastEndOfInput() || !scanEscape())
+				return setError(ScannerError::IllegalEscapeSequence);
+		}
+		else
+		{
+			// Report error on non-printable characters in string literals, however
+			// allow anything for unicode string literals, because their validity will
+			// be verified later (in the syntax checker).
+			//
+			// We are using a manual range and not isprint() to avoid
+			// any potential complications with locale.
+			if (!_isUnicode && (static_cast<unsigned>(c) <= 0x1f || static_cast<unsigned>(c) >= 0x7f))
+				return setError(ScannerError::IllegalCharacterInString);
+			addLiteralChar(c);
+		}
+	}
+	if (m_char != quote)
+		return setError(ScannerError::IllegalStringEndQuote);
+
+	if (_isUnicode)
+	{
+		size_t endPosition = sourcePos();
+		ScannerError unicodeDirectionError = validateBiDiMarkup(source(), startPosition, endPosition);
+		if (unicodeDirectionError != ScannerError::NoError)
+		{
+			advanceTo(endPosition);
+			return setError(unicodeDirectionError);
+		}
+	}
+
+	literal.complete();
+	advance();  // consume quote
+	return _isUnicode ? Token::UnicodeStringLiteral : Token::StringLiteral;
+}
+
+Token Scanner::scanHexString()
+{
+	char const quote = m_char;
+	advance();  // consume quote
+	LiteralScope literal(this, LITERAL_TYPE_STRING);
+	bool allowUnderscore = false;
+	while (m_char != quote && !isSourcePastEndOfInput())
+	{
+		char c = m_char;
+
+		if (scanHexByte(c))
+		{
+			addLiteralChar(c);
+			allowUnderscore = true;
+		}
+		else if (c == '_')
+		{
+			advance();
+			if (!allowUnderscore || m_char == quote)
+				return setError(ScannerError::IllegalNumberSeparator);
+			allowUnderscore = false;
+		}
+		else
+			return setError(ScannerError::IllegalHexString);
+	}
+
+	if (m_char != quote)
+		return setError(ScannerError::IllegalStringEndQuote);
+
+	literal.complete();
+	advance();  // consume quote
+	return Token::HexStringLiteral;
+}
+
+// Parse for regex [:digit:]+(_[:digit:]+)*
+void Scanner::scanDecimalDigits()
+{
+	// MUST begin with a decimal digit.
+	if (!isDecimalDigit(m_char))
+		return;
+
+	// May continue with decimal digit or underscore for grouping.
+	do
+		addLiteralCharAndAdvance();
+	while (!m_source->isPastEndOfInput() && (isDecimalDigit(m_char) || m_char == '_'));
+
+	// Defer further validation of underscore to SyntaxChecker.
+}
+
+Token Scanner::scanNumber(char _charSeen)
+{
+	enum { DECIMAL, HEX, BINARY } kind = DECIMAL;
+	LiteralScope literal(this, LITERAL_TYPE_NUMBER);
+	if (_charSeen == '.')
+	{
+		// we have already seen a decimal point of the float
+		addLiteralChar('.');
+		if (m_char == '_')
+			return setError(ScannerError::IllegalToken);
+		scanDecimalDigits();  // we know we have at least one digit
+	}
+	else
+	{
+		solAssert(_charSeen == 0, "");
+		// if the first character is '0' we must check for octals and hex
+		if (m_char == '0')
+		{
+			addLiteralCharAndAdvance();
+			// either 0, 0exxx, 0Exxx, 0.xxx or a hex number
+			if (m_char == 'x')
+			{
+				// hex number
+				kind = HEX;
+				addLiteralCharAndAdvance();
+				if (!isHexDigit(m_char))
+					return setError(ScannerError::IllegalHexDigit); // we must have at least one hex digit after 'x'
+
+				while (isHexDigit(m_char) || m_char == '_') // We keep the underscores for later validation
+					addLiteralCharAndAdvance();
+			}
+			else if (isDecimalDigit(m_char))
+				// We do not allow octal numbers
+				return setError(ScannerError::OctalNotAllowed);
+		}
+		// Parse decimal digits and allow trailing fraction.
+		if (kind == DECIMAL)
+		{
+			scanDecimalDigits();  // optional
+			if (m_char == '.')
+			{
+				if (!m_source->isPastEndOfInput(1) && m_source->get(1) == '_')
+				{
+					// Assume the input may be a floating point number with leading '_' in fraction part.
+					// Recover by consuming it all but returning `Illegal` right away.
+					addLiteralCharAndAdvance(); // '.'
+					addLiteralCharAndAdvance(); // '_'
+					scanDecimalDigits();
+				}
+				if (m_source->isPastEndOfInput() || !isDecimalDigit(m_source->get(1)))
+				{
+					// A '.' has to be followed by a number.
+					literal.complete();
+					return Token::Number;
+				}
+				addLiteralCharAndAdvance();
+				scanDecimalDigits();
+			}
+		}
+	}
+	// scan exponent, if any
+	if (m_char == 'e' || m_char == 'E')
+	{
+		solAssert(kind != HEX, "'e'/'E' must be scanned as part of the hex number");
+		if (kind != DECIMAL)
+			return setError(ScannerError::IllegalExponent);
+		else if (!m_source->isPastEndOfInput(1) && m_source->get(1) == '_')
+		{
+			// Recover from wrongly placed underscore as delimiter in literal with scientific
+			// notation by consuming until the end.
+			addLiteralCharAndAdvance(); // 'e'
+			addLiteralCharAndAdvance(); // '_'
+			scanDecimalDigits();
+			literal.complete();
+			return Token::Number;
+		}
+		// scan exponent
+		addLiteralCharAndAdvance(); // 'e' | 'E'
+		if (m_char == '+' || m_char == '-')
+			addLiteralCharAndAdvance();
+		if (!isDecimalDigit(m_char)) // we must have at least one decimal digit after 'e'/'E'
+			return setError(ScannerError::IllegalExponent);
+		scanDecimalDigits();
+	}
+	// The source character immediately following a numeric literal must
+	// not be an identifier start or a decimal digit; see ECMA-262
+	// section 7.8.3, page 17 (note that we read only one decimal digit
+	// if the value is 0).
+	if (isDecimalDigit(m_char) || isIdentifierStart(m_char))
+		return setError(ScannerError::IllegalNumberEnd);
+	literal.complete();
+	return Token::Number;
+}
+
+tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
+{
+	solAssert(isIdentifierStart(m_char), "");
+	// Solidity++: the rest of the identifier is found in blocks and copied at once.
+	size_t const start = sourcePos();
+	size_t const end = m_kind == ScannerKind::Yul ?
+		skipWhile<YulIdentifierPart>(source(), start + 1) :
+		skipWhile<IdentifierPart>(source(), start + 1);
+	string& literal = m_tokens[NextNext].literal;
+	literal.assign(source(), start, end - start);
+	advanceTo(end);
+
+	auto const token = TokenTraits::fromIdentifierOrKeyword(literal);
+	if (m_kind == ScannerKind::Yul)
+	{
+		// Turn Solidity identifier into a Yul keyword
+		if (literal == "leave")
+			return std::make_tuple(Token::Leave, 0, 0);
+		// Turn non-Yul keywords into identifiers.
+		if (!TokenTraits::isYulKeyword(std::get<0>(token)))
+			return std::make_tuple(Token::Identifier, 0, 0);
+	}
+	return token;
+}
+
+}
@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Solidity++ Tokens.
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <liblangutil/Token.h>
+#include <liblangutil/Exceptions.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+using namespace std;
+
+namespace solidity::langutil
+{
+
+void ElementaryTypeNameToken::assertDetails(Token _baseType, unsigned const& _first, unsigned const& _second)
+{
+	solAssert(TokenTraits::isElementaryTypeName(_baseType), "Expected elementary type name: " + string(TokenTraits::toString(_baseType)));
+	if (_baseType == Token::BytesM)
+	{
+		solAssert(_second == 0, "There should not be a second size argument to type bytesM.");
+		solAssert(_first <= 32, "No elementary type bytes" + to_string(_first) + ".");
+	}
+	else if (_baseType == Token::UIntM || _baseType == Token::IntM)
+	{
+		solAssert(_second == 0, "There should not be a second size argument to type " + string(TokenTraits::toString(_baseType)) + ".");
+		solAssert(
+			_first <= 256 && _first % 8 == 0,
+			"No elementary type " + string(TokenTraits::toString(_baseType)) + to_string(_first) + "."
+		);
+	}
+	else if (_baseType == Token::UFixedMxN || _baseType == Token::FixedMxN)
+	{
+		solAssert(
+			_first >= 8 && _first <= 256 && _first % 8 == 0 && _second <= 80,
+			"No elementary type " + string(TokenTraits::toString(_baseType)) + to_string(_first) + "x" + to_string(_second) + "."
+		);
+	}
+	m_token = _baseType;
+	m_firstNumber = _first;
+	m_secondNumber = _second;
+}
+
+namespace TokenTraits
+{
+
+char const* toString(Token tok)
+{
+	switch (tok)
+	{
+#define T(name, string, precedence) case Token::name: return string;
+		TOKEN_LIST(T, T)
+#undef T
+		default: // Token::NUM_TOKENS:
+			return "";
+	}
+}
+
+char const* name(Token tok)
+{
+#define T(name, string, precedence) #name,
+	static char const* const names[TokenTraits::count()] = { TOKEN_LIST(T, T) };
+#undef T
+
+	solAssert(static_cast<size_t>(tok) < TokenTraits::count(), "");
+	return names[static_cast<size_t>(tok)];
+}
+
+std::string friendlyName(Token tok)
+{
+	char const* ret = toString(tok);
+	if (ret)
+		return std::string(ret);
+
+	ret = name(tok);
+	solAssert(ret != nullptr, "");
+	return std::string(ret);
+}
+
+}
+
+namespace
+{
+
+// Solidity++: keywords are looked up in a perfect hash table instead of a std::map,
+// the scanner does this for every identifier.
+struct Keyword
+{
+	std::string_view name;
+	Token token;
+};
+
+#define KEYWORD(name, string, precedence) Keyword{string, Token::name},
+#define TOKEN(name, string, precedence)
+constexpr Keyword keywords[] = { TOKEN_LIST(TOKEN, KEYWORD) };
+#undef KEYWORD
+#undef TOKEN
+
+constexpr size_t keywordCount = sizeof(keywords) / sizeof(keywords[0]);
+constexpr size_t keywordTableSize = 2048;
+constexpr uint8_t noKeyword = 0xff;
+static_assert(keywordCount < noKeyword, "Keyword indices have to fit into the hash table.");
+
+constexpr size_t keywordHash(std::string_view _name, uint32_t _seed)
+{
+	uint32_t hash = 2166136261u ^ _seed;
+	for (char c: _name)
+		hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+	return (hash ^ (hash >> 16)) % keywordTableSize;
+}
+
+/// @returns the smallest seed for which keywordHash has no collisions between the keywords.
+constexpr uint32_t findKeywordSeed()
+{
+	// Slot i was last used by the seed stored at i; avoids clearing the table for every seed.
+	std::array<uint32_t, keywordTableSize> usedBySeed{};
+	for (uint32_t seed = 1; ; ++seed)
+	{
+		bool collision = false;
+		for (size_t i = 0; i < keywordCount && !collision; ++i)
+		{
+			size_t slot = keywordHash(keywords[i].name, seed);
+			collision = usedBySeed[slot] == seed;
+			usedBySeed[slot] = seed;
+		}
+		if (!collision)
+			return seed;
+	}
+}
+
+constexpr uint32_t keywordSeed = findKeywordSeed();
+
+constexpr std::array<uint8_t, keywordTableSize> makeKeywordTable()
+{
+	std::array<uint8_t, keywordTableSize> table{};
+	for (auto& entry: table)
+		entry = noKeyword;
+	for (size_t i = 0; i < keywordCount; ++i)
+		table[keywordHash(keywords[i].name, keywordSeed)] = static_cast<uint8_t>(i);
+	return table;
+}
+
+constexpr std::array<uint8_t, keywordTableSize> keywordTable = makeKeywordTable();
+
+Token keywordByName(std::string_view _name)
+{
+	uint8_t index = keywordTable[keywordHash(_name, keywordSeed)];
+	if (index != noKeyword && keywords[index].name == _name)
+		return keywords[index].token;
+	return Token::Identifier;
+}
+
+bool isDigit(char _c)
+{
+	return '0' <= _c && _c <= '9';
+}
+
+/// @returns the position of the first decimal digit in @a _literal or its size if there is none.
+/// Checks eight characters at a time, identifiers are mostly longer than a few characters.
+size_t findDigit(std::string_view _literal)
+{
+	constexpr uint64_t ones = 0x0101010101010101;
+	constexpr uint64_t highBits = 0x80 * ones;
+	size_t position = 0;
+	for (; position + 8 <= _literal.size(); position += 8)
+	{
+		uint64_t word;
+		memcpy(&word, _literal.data() + position, 8);
+		// The high bit of a byte is set in atLeastZero if it is >= '0' and in aboveNine if it
+		// is > '9'. Clearing the high bits first keeps the additions from carrying over.
+		uint64_t low = word & ~highBits;
+		uint64_t atLeastZero = low + (0x80 - '0') * ones;
+		uint64_t aboveNine = low + (0x80 - '9' - 1) * ones;
+		if (atLeastZero & ~aboveNine & ~word & highBits)
+			break;
+	}
+	for (; position < _literal.size(); ++position)
+		if (isDigit(_literal[position]))
+			break;
+	return position;
+}
+
+/// @returns the number written as @a _digits or -1 if that is not its shortest representation.
+/// M/N of the sized types can never have leading zeros, as in upstream, where bytes01, int01,
+/// fixed01x1 and fixed1x01 are identifiers (see test/syntax/solidity/types/weird_sized_types.sol).
+int parseSize(std::string_view _digits)
+{
+	if (_digits.empty() || (_digits.size() > 1 && _digits[0] == '0'))
+		return -1;
+	int size = 0;
+	for (char c: _digits)
+	{
+		// Overflow check. The largest acceptable value is 256 in the callers.
+		if (!isDigit(c) || size >= 256)
+			return -1;
+		size = size * 10 + (c - '0');
+	}
+	return size;
+}
+
+}
+
+namespace TokenTraits
+{
+
+bool isYulKeyword(string const& _literal)
+{
+	return _literal == "leave" || isYulKeyword(keywordByName(_literal));
+}
+
+tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _literal)
+{
+	std::string_view literal(_literal);
+	size_t positionM = findDigit(literal);
+	if (positionM != literal.size())
+	{
+		size_t positionX = positionM;
+		while (positionX < literal.size() && isDigit(literal[positionX]))
+			++positionX;
+		int m = parseSize(literal.substr(positionM, positionX - positionM));
+		Token keyword = keywordByName(literal.substr(0, positionM));
+		if (keyword == Token::Bytes)
+		{
+			if (0 < m && m <= 32 && positionX == literal.size())
+				return make_tuple(Token::BytesM, m, 0);
+		}
+		else if (keyword == Token::UInt || keyword == Token::Int)
+		{
+			if (0 < m && m <= 256 && m % 8 == 0 && positionX == literal.size())
+			{
+				if (keyword == Token::UInt)
+					return make_tuple(Token::UIntM, m, 0);
+				else
+					return make_tuple(Token::IntM, m, 0);
+			}
+		}
+		else if (keyword == Token::UFixed || keyword == Token::Fixed)
+		{
+			if (
+				positionM < positionX &&
+				positionX < literal.size() &&
+				literal[positionX] == 'x'
+			)
+			{
+				int n = parseSize(literal.substr(positionX + 1));
+				if (
+					8 <= m && m <= 256 && m % 8 == 0 &&
+					0 <= n && n <= 80
+				)
+				{
+					if (keyword == Token::UFixed)
+						return make_tuple(Token::UFixedMxN, m, n);
+					else
+						return make_tuple(Token::FixedMxN, m, n);
+				}
+			}
+		}
+		return make_tuple(Token::Identifier, 0, 0);
+	}
+
+	return make_tuple(keywordByName(literal), 0, 0);
+}
+
+}
+}
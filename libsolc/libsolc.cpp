@@ -30,6 +30,7 @@
 
 #include <cstdlib>
 #include <list>
+#include <optional>
 #include <string>
 
 #include "license.h"
@@ -134,6 +135,44 @@ extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCa
 	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
 }
 
+extern void solidity_compile_chunked(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleOutputCallback _outputCallback,
+	void* _outputContext
+) noexcept
+{
+	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	compiler.compile(_input, [&](string const& _chunk) {
+		_outputCallback(_outputContext, _chunk.data(), _chunk.size());
+	});
+}
+
+extern void solidity_compile_batch(
+	char const* const* _inputs,
+	size_t _count,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleOutputCallback _outputCallback,
+	void* _outputContext
+) noexcept
+{
+	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	// The inputs are already in memory, reading them ahead would only copy them.
+	compiler.setMaxInFlight(1);
+	size_t nextInput = 0;
+	compiler.compileBatch(
+		[&]() -> optional<string>
+		{
+			if (nextInput == _count)
+				return nullopt;
+			return string(_inputs[nextInput++]);
+		},
+		[&](string const& _chunk) { _outputCallback(_outputContext, _chunk.data(), _chunk.size()); }
+	);
+}
+
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
@@ -52,6 +52,13 @@ extern "C" {
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
+/// Callback used to receive the output of solidity_compile_chunked() and solidity_compile_batch().
+///
+/// @param _context The outputContext passed to solidity_compile_chunked or solidity_compile_batch. Can be NULL.
+/// @param _data The next chunk of the output. It is not zero terminated and only valid during the call.
+/// @param _length The length of the chunk in bytes.
+typedef void (*CStyleOutputCallback)(void* _context, char const* _data, size_t _length);
+
 /// Returns the complete license document.
 ///
 /// The pointer returned must NOT be freed by the caller.
@@ -90,6 +97,38 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Like solidity_compile(), but passes the "Standard Output JSON" to @p _outputCallback in
+/// consecutive chunks instead of returning it. The artifacts of every contract are passed on
+/// as soon as they are ready, so the complete output is never held in memory.
+///
+/// @param _outputCallback The callback receiving the output. Must not be NULL.
+/// @param _outputContext An optional context pointer passed to _outputCallback. Can be NULL.
+void solidity_compile_chunked(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleOutputCallback _outputCallback,
+	void* _outputContext
+) SOLC_NOEXCEPT;
+
+/// Compiles the @p _count independent "Standard Input JSON"s @p _inputs one after another, like
+/// solidity_compile(), and passes a JSON array of their "Standard Output JSON"s in input order to
+/// @p _outputCallback in consecutive chunks. Each output is passed on while it is produced, so
+/// the output of the batch is never held in memory.
+///
+/// Files read through @p _readCallback are cached for the whole batch, up to 64 MiB.
+///
+/// @param _outputCallback The callback receiving the output. Must not be NULL.
+/// @param _outputContext An optional context pointer passed to _outputCallback. Can be NULL.
+void solidity_compile_batch(
+	char const* const* _inputs,
+	size_t _count,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleOutputCallback _outputCallback,
+	void* _outputContext
+) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Liveness of local variables across await expressions.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolidity/analysis/AwaitLivenessAnalyser.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/SolidityppAST.h>
+#include <libsolidity/ast/Types.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// @returns true if @a _variable is declared in the body of @a _loop and thus
+/// initialized again in every iteration.
+bool declaredInLoopBody(ASTNode const& _loop, VariableDeclaration const& _variable)
+{
+	Statement const* body = nullptr;
+	if (auto forStatement = dynamic_cast<ForStatement const*>(&_loop))
+		body = &forStatement->body();
+	else if (auto whileStatement = dynamic_cast<WhileStatement const*>(&_loop))
+		body = &whileStatement->body();
+	solAssert(body, "");
+	return
+		body->location().start <= _variable.location().start &&
+		_variable.location().end <= body->location().end;
+}
+
+}
+
+vector<AwaitLiveness> AwaitLivenessAnalyser::analyse(ContractDefinition const& _contract)
+{
+	m_result.clear();
+	for (ContractDefinition const* contract: _contract.annotation().linearizedBaseContracts)
+	{
+		for (FunctionDefinition const* function: contract->definedFunctions())
+			function->accept(*this);
+		for (ModifierDefinition const* modifier: contract->functionModifiers())
+			modifier->accept(*this);
+	}
+	return move(m_result);
+}
+
+bool AwaitLivenessAnalyser::visit(FunctionDefinition const& _function)
+{
+	enterCallable(_function);
+	for (auto const& parameter: _function.returnParameters())
+		m_scopes.back().push_back(parameter.get());
+	return true;
+}
+
+void AwaitLivenessAnalyser::endVisit(FunctionDefinition const&)
+{
+	leaveCallable();
+}
+
+bool AwaitLivenessAnalyser::visit(ModifierDefinition const& _modifier)
+{
+	enterCallable(_modifier);
+	return true;
+}
+
+void AwaitLivenessAnalyser::endVisit(ModifierDefinition const&)
+{
+	leaveCallable();
+}
+
+bool AwaitLivenessAnalyser::visit(Block const&)
+{
+	m_scopes.emplace_back();
+	return true;
+}
+
+void AwaitLivenessAnalyser::endVisit(Block const&)
+{
+	m_scopes.pop_back();
+}
+
+bool AwaitLivenessAnalyser::visit(ForStatement const& _forStatement)
+{
+	// The scope holds the variables of the initialization expression.
+	m_scopes.emplace_back();
+	m_loops.push_back(&_forStatement);
+	return true;
+}
+
+void AwaitLivenessAnalyser::endVisit(ForStatement const&)
+{
+	m_loops.pop_back();
+	m_scopes.pop_back();
+}
+
+bool AwaitLivenessAnalyser::visit(WhileStatement const& _whileStatement)
+{
+	m_loops.push_back(&_whileStatement);
+	return true;
+}
+
+void AwaitLivenessAnalyser::endVisit(WhileStatement const&)
+{
+	m_loops.pop_back();
+}
+
+bool AwaitLivenessAnalyser::visit(TryCatchClause const& _clause)
+{
+	m_scopes.emplace_back();
+	if (_clause.parameters())
+		for (auto const& parameter: _clause.parameters()->parameters())
+			m_scopes.back().push_back(parameter.get());
+	return true;
+}
+
+void AwaitLivenessAnalyser::endVisit(TryCatchClause const&)
+{
+	m_scopes.pop_back();
+}
+
+void AwaitLivenessAnalyser::endVisit(VariableDeclarationStatement const& _statement)
+{
+	// The variables are only in scope after their initial value has been computed.
+	if (m_callable)
+		for (auto const& declaration: _statement.declarations())
+			if (declaration)
+				m_scopes.back().push_back(declaration.get());
+}
+
+bool AwaitLivenessAnalyser::visit(Assignment const& _assignment)
+{
+	// The value is computed before the left-hand side is evaluated, also for compound assignments.
+	_assignment.rightHandSide().accept(*this);
+	_assignment.leftHandSide().accept(*this);
+	return false;
+}
+
+bool AwaitLivenessAnalyser::visit(BinaryOperation const& _binaryOperation)
+{
+	// Only && and || evaluate their left operand first. Other operators evaluate the right one
+	// first, unless it is a literal, which reads nothing.
+	Token const op = _binaryOperation.getOperator();
+	if (op == Token::And || op == Token::Or)
+		return true;
+	_binaryOperation.rightExpression().accept(*this);
+	_binaryOperation.leftExpression().accept(*this);
+	return false;
+}
+
+bool AwaitLivenessAnalyser::visit(FunctionCall const& _functionCall)
+{
+	auto functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+	bool internalCall =
+		*_functionCall.annotation().kind == FunctionCallKind::FunctionCall &&
+		functionType &&
+		functionType->kind() == FunctionType::Kind::Internal;
+	if (!internalCall)
+		_functionCall.expression().accept(*this);
+	for (auto const& argument: _functionCall.sortedArguments())
+		argument->accept(*this);
+	// The called expression of an internal call, e.g. a local function pointer, is read last.
+	if (internalCall)
+		_functionCall.expression().accept(*this);
+	return false;
+}
+
+void AwaitLivenessAnalyser::endVisit(Identifier const& _identifier)
+{
+	if (!m_callable || _identifier.annotation().lValueOfOrdinaryAssignment)
+		return;
+	if (auto variable = dynamic_cast<VariableDeclaration const*>(_identifier.annotation().referencedDeclaration))
+		if (variable->isLocalVariable())
+			addRead(*variable);
+}
+
+bool AwaitLivenessAnalyser::visit(InlineAssembly const& _inlineAssembly)
+{
+	// References from inside the block are not ordered, count them all at the start of the block.
+	if (m_callable)
+		for (auto const& reference: _inlineAssembly.annotation().externalReferences)
+			if (auto variable = dynamic_cast<VariableDeclaration const*>(reference.second.declaration))
+				if (variable->isLocalVariable())
+					addRead(*variable);
+	return false;
+}
+
+void AwaitLivenessAnalyser::endVisit(AwaitExpression const& _await)
+{
+	if (!m_callable)
+		return;
+
+	Site site;
+	site.liveness.await = &_await;
+	site.liveness.callable = m_callable;
+	for (auto const& scope: m_scopes)
+		site.liveness.inScope += scope;
+	site.step = m_step++;
+	site.loops = m_loops;
+	m_sites.emplace_back(move(site));
+}
+
+void AwaitLivenessAnalyser::enterCallable(CallableDeclaration const& _callable)
+{
+	solAssert(!m_callable, "Nested callables are not supported.");
+	m_callable = &_callable;
+	m_scopes = {{}};
+	for (auto const& parameter: _callable.parameters())
+		m_scopes.back().push_back(parameter.get());
+	m_loops.clear();
+	m_step = 0;
+	m_reads.clear();
+	m_sites.clear();
+}
+
+void AwaitLivenessAnalyser::leaveCallable()
+{
+	for (Site& site: m_sites)
+	{
+		AwaitLiveness& liveness = site.liveness;
+		for (VariableDeclaration const* variable: liveness.inScope)
+		{
+			bool live = variable->isReturnParameter() || util::contains_if(m_reads, [&](Read const& _read) {
+				if (_read.variable != variable)
+					return false;
+				if (_read.step > site.step)
+					return true;
+				// A read earlier in a loop around the await happens again in the next iteration,
+				// unless the variable is re-declared in each iteration.
+				return util::contains_if(site.loops, [&](ASTNode const* _loop) {
+					return util::contains(_read.loops, _loop) && !declaredInLoopBody(*_loop, *variable);
+				});
+			});
+
+			solAssert(variable->annotation().type, "");
+			size_t slots = variable->annotation().type->sizeOnStack();
+			liveness.slotsInScope += slots;
+			if (!live)
+				continue;
+
+			liveness.live.push_back(variable);
+			liveness.liveSlots += slots;
+			if (auto referenceType = dynamic_cast<ReferenceType const*>(variable->annotation().type))
+				if (referenceType->location() == DataLocation::Memory)
+					liveness.liveMemory.push_back(variable);
+		}
+		m_result.emplace_back(move(liveness));
+	}
+
+	m_callable = nullptr;
+	m_scopes.clear();
+	m_loops.clear();
+	m_reads.clear();
+	m_sites.clear();
+}
+
+void AwaitLivenessAnalyser::addRead(VariableDeclaration const& _variable)
+{
+	m_reads.emplace_back(Read{&_variable, m_step++, m_loops});
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Liveness of local variables across await expressions.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/// Local variable state at a single await site.
+struct AwaitLiveness
+{
+	AwaitExpression const* await = nullptr;
+	/// Function or modifier containing the await.
+	CallableDeclaration const* callable = nullptr;
+	/// Local variables in scope at the await, in declaration order.
+	std::vector<VariableDeclaration const*> inScope;
+	/// Variables of @a inScope that may be read after execution resumes at the callback.
+	std::vector<VariableDeclaration const*> live;
+	/// Variables of @a live that reference memory, i.e. whose memory region has to survive as well.
+	std::vector<VariableDeclaration const*> liveMemory;
+	size_t slotsInScope = 0;
+	size_t liveSlots = 0;
+};
+
+/**
+ * Computes which local variables are live across each await of a contract.
+ *
+ * A sync call suspends the caller between SYNCCALL and CALLBACKDEST and its whole context
+ * is saved by the node. A local variable is live across the await if it may be read after
+ * the await, either later in evaluation order or in a later iteration of an enclosing loop
+ * it was declared outside of. The evaluation order is the one of the legacy code generator:
+ * the right operand of a binary operator other than && and || and the right-hand side of an
+ * assignment are evaluated first, and the arguments of an internal call before the called
+ * expression. Return parameters are always live. The analysis is conservative: branches are
+ * not distinguished and overwrites do not kill a variable.
+ *
+ * The result is only reported. Code generation still keeps every slot in scope across the
+ * suspension: SYNCCALL has no operand selecting what the node saves, and the legacy code
+ * generator addresses locals at fixed stack offsets, so dropping a dead slot would shift
+ * every later access to the slots below it.
+ */
+class AwaitLivenessAnalyser: private ASTConstVisitor
+{
+public:
+	/// @returns the liveness of all awaits in functions and modifiers of @a _contract and its bases.
+	/// Prerequisite: successful analysis.
+	std::vector<AwaitLiveness> analyse(ContractDefinition const& _contract);
+
+private:
+	struct Read
+	{
+		VariableDeclaration const* variable = nullptr;
+		/// Position of the read in evaluation order.
+		size_t step = 0;
+		std::vector<ASTNode const*> loops;
+	};
+
+	struct Site
+	{
+		AwaitLiveness liveness;
+		/// Position of the suspension in evaluation order.
+		size_t step = 0;
+		std::vector<ASTNode const*> loops;
+	};
+
+	bool visit(FunctionDefinition const& _function) override;
+	void endVisit(FunctionDefinition const& _function) override;
+	bool visit(ModifierDefinition const& _modifier) override;
+	void endVisit(ModifierDefinition const& _modifier) override;
+	bool visit(Block const& _block) override;
+	void endVisit(Block const& _block) override;
+	bool visit(ForStatement const& _forStatement) override;
+	void endVisit(ForStatement const& _forStatement) override;
+	bool visit(WhileStatement const& _whileStatement) override;
+	void endVisit(WhileStatement const& _whileStatement) override;
+	bool visit(TryCatchClause const& _clause) override;
+	void endVisit(TryCatchClause const& _clause) override;
+	void endVisit(VariableDeclarationStatement const& _statement) override;
+	bool visit(Assignment const& _assignment) override;
+	bool visit(BinaryOperation const& _binaryOperation) override;
+	bool visit(FunctionCall const& _functionCall) override;
+	void endVisit(Identifier const& _identifier) override;
+	bool visit(InlineAssembly const& _inlineAssembly) override;
+	void endVisit(AwaitExpression const& _await) override;
+
+	void enterCallable(CallableDeclaration const& _callable);
+	/// Resolves the liveness of all awaits of the current callable.
+	void leaveCallable();
+	void addRead(VariableDeclaration const& _variable);
+
+	CallableDeclaration const* m_callable = nullptr;
+	std::vector<std::vector<VariableDeclaration const*>> m_scopes;
+	std::vector<ASTNode const*> m_loops;
+	/// Number of reads and awaits of the current callable visited so far.
+	size_t m_step = 0;
+	std::vector<Read> m_reads;
+	std::vector<Site> m_sites;
+	std::vector<AwaitLiveness> m_result;
+};
+
+}
@@ -63,48 +63,45 @@ inline vector<shared_ptr<MagicVariableDeclaration const>> constructMagicVariable
 	static auto const magicVarDecl = [](string const& _name, Type const* _type) {
 		return make_shared<MagicVariableDeclaration>(magicVariableToID(_name), _name, _type);
 	};
+	// Solidity++: builtin function types are shared by all compilations.
+	using Builtin = TypeProvider::BuiltinFunction;
+	static auto const builtin = [](Builtin _function) { return TypeProvider::builtinFunction(_function); };
 
 	return {
 		magicVarDecl("abi", TypeProvider::magic(MagicType::Kind::ABI)),
-		magicVarDecl("addmod", TypeProvider::function(strings{"uint256", "uint256", "uint256"}, strings{"uint256"}, FunctionType::Kind::AddMod, false, StateMutability::Pure)),
-		magicVarDecl("assert", TypeProvider::function(strings{"bool"}, strings{}, FunctionType::Kind::Assert, false, StateMutability::Pure)),
+		magicVarDecl("addmod", builtin(Builtin::AddMod)),
+		magicVarDecl("assert", builtin(Builtin::Assert)),
 		magicVarDecl("block", TypeProvider::magic(MagicType::Kind::Block)),
-		magicVarDecl("blockhash", TypeProvider::function(strings{"uint256"}, strings{"bytes32"}, FunctionType::Kind::BlockHash, false, StateMutability::View)),
-		magicVarDecl("ecrecover", TypeProvider::function(strings{"bytes32", "uint8", "bytes32", "bytes32"}, strings{"address"}, FunctionType::Kind::ECRecover, false, StateMutability::Pure)),
-		magicVarDecl("gasleft", TypeProvider::function(strings(), strings{"uint256"}, FunctionType::Kind::GasLeft, false, StateMutability::View)),
-		magicVarDecl("keccak256", TypeProvider::function(strings{"bytes memory"}, strings{"bytes32"}, FunctionType::Kind::KECCAK256, false, StateMutability::Pure)),
+		magicVarDecl("blockhash", builtin(Builtin::BlockHash)),
+		magicVarDecl("ecrecover", builtin(Builtin::ECRecover)),
+		magicVarDecl("gasleft", builtin(Builtin::GasLeft)),
+		magicVarDecl("keccak256", builtin(Builtin::Keccak256)),
 		magicVarDecl("msg", TypeProvider::magic(MagicType::Kind::Message)),
-		magicVarDecl("mulmod", TypeProvider::function(strings{"uint256", "uint256", "uint256"}, strings{"uint256"}, FunctionType::Kind::MulMod, false, StateMutability::Pure)),
+		magicVarDecl("mulmod", builtin(Builtin::MulMod)),
 		magicVarDecl("now", TypeProvider::uint256()),
-		magicVarDecl("require", TypeProvider::function(strings{"bool"}, strings{}, FunctionType::Kind::Require, false, StateMutability::Pure)),
-		magicVarDecl("require", TypeProvider::function(strings{"bool", "string memory"}, strings{}, FunctionType::Kind::Require, false, StateMutability::Pure)),
-		magicVarDecl("revert", TypeProvider::function(strings(), strings(), FunctionType::Kind::Revert, false, StateMutability::Pure)),
-		magicVarDecl("revert", TypeProvider::function(strings{"string memory"}, strings(), FunctionType::Kind::Revert, false, StateMutability::Pure)),
-		magicVarDecl("ripemd160", TypeProvider::function(strings{"bytes memory"}, strings{"bytes20"}, FunctionType::Kind::RIPEMD160, false, StateMutability::Pure)),
-		magicVarDecl("selfdestruct", TypeProvider::function(strings{"address payable"}, strings{}, FunctionType::Kind::Selfdestruct)),
-		magicVarDecl("sha256", TypeProvider::function(strings{"bytes memory"}, strings{"bytes32"}, FunctionType::Kind::SHA256, false, StateMutability::Pure)),
-		magicVarDecl("sha3", TypeProvider::function(strings{"bytes memory"}, strings{"bytes32"}, FunctionType::Kind::KECCAK256, false, StateMutability::Pure)),
-		magicVarDecl("suicide", TypeProvider::function(strings{"address payable"}, strings{}, FunctionType::Kind::Selfdestruct)),
+		magicVarDecl("require", builtin(Builtin::Require)),
+		magicVarDecl("require", builtin(Builtin::RequireWithMessage)),
+		magicVarDecl("revert", builtin(Builtin::Revert)),
+		magicVarDecl("revert", builtin(Builtin::RevertWithMessage)),
+		magicVarDecl("ripemd160", builtin(Builtin::RIPEMD160)),
+		magicVarDecl("selfdestruct", builtin(Builtin::Selfdestruct)),
+		magicVarDecl("sha256", builtin(Builtin::SHA256)),
+		magicVarDecl("sha3", builtin(Builtin::Keccak256)),
+		magicVarDecl("suicide", builtin(Builtin::Selfdestruct)),
 		magicVarDecl("tx", TypeProvider::magic(MagicType::Kind::Transaction)),
 		// Accepts a MagicType that can be any contract type or an Integer type and returns a
 		// MagicType. The TypeChecker handles the correctness of the input and output types.
-		magicVarDecl("type", TypeProvider::function(
-			strings{},
-			strings{},
-			FunctionType::Kind::MetaType,
-			true,
-			StateMutability::Pure
-		)),
-		
+		magicVarDecl("type", builtin(Builtin::MetaType)),
+
 		// Solidity++: solidity++ magic variables
-		magicVarDecl("blake2b", TypeProvider::function(strings{"bytes memory"}, strings{"bytes32"}, FunctionType::Kind::BLAKE2B, false, StateMutability::Pure)),
-		magicVarDecl("balance", TypeProvider::function(strings{"vitetoken"}, strings{"uint"}, FunctionType::Kind::Balance, false, StateMutability::View)),
-        magicVarDecl("height", TypeProvider::function(strings(), strings{"uint256"}, FunctionType::Kind::Height, false, StateMutability::View)),
-		magicVarDecl("accountheight", TypeProvider::function(strings(), strings{"uint64"}, FunctionType::Kind::AccountHeight, false, StateMutability::View)),
-		magicVarDecl("prevhash", TypeProvider::function(strings(), strings{"bytes32"}, FunctionType::Kind::PrevHash, false, StateMutability::View)),
-		magicVarDecl("fromhash", TypeProvider::function(strings(), strings{"bytes32"}, FunctionType::Kind::FromHash, false, StateMutability::NonPayable)),
-		magicVarDecl("random64", TypeProvider::function(strings(), strings{"uint64"}, FunctionType::Kind::Random64, false, StateMutability::View)),
-		magicVarDecl("nextrandom", TypeProvider::function(strings(), strings{"uint64"}, FunctionType::Kind::NextRandom, false, StateMutability::View)),
+		magicVarDecl("blake2b", builtin(Builtin::BLAKE2B)),
+		magicVarDecl("balance", builtin(Builtin::Balance)),
+		magicVarDecl("height", builtin(Builtin::Height)),
+		magicVarDecl("accountheight", builtin(Builtin::AccountHeight)),
+		magicVarDecl("prevhash", builtin(Builtin::PrevHash)),
+		magicVarDecl("fromhash", builtin(Builtin::FromHash)),
+		magicVarDecl("random64", builtin(Builtin::Random64)),
+		magicVarDecl("nextrandom", builtin(Builtin::NextRandom)),
 	};
 }
 
@@ -127,6 +127,24 @@ bool SolidityppSyntaxChecker::visit(PragmaDirective const& _pragma)
 		else
 			m_sourceUnit->annotation().useABICoderV2 = (_pragma.literals()[1] == "v2");
 	}
+	else if (_pragma.literals()[0] == "storagelayout")  // Solidity++: opt-in storage packing
+	{
+		solAssert(m_sourceUnit, "");
+		if (_pragma.literals().size() != 2 || _pragma.literals()[1] != "packed")
+			m_errorReporter.syntaxError(
+				100401_error,
+				_pragma.location(),
+				"Expected \"pragma storagelayout packed\"."
+			);
+		else if (m_sourceUnit->annotation().packedStorage)
+			m_errorReporter.syntaxError(
+				100402_error,
+				_pragma.location(),
+				"Storage layout has already been selected for this source unit."
+			);
+		else
+			m_sourceUnit->annotation().packedStorage = true;
+	}
 	else if ( _pragma.literals()[0] == "soliditypp" || _pragma.literals()[0] == "solidity")
 	{
 		vector<Token> tokens(_pragma.tokens().begin() + 1, _pragma.tokens().end());
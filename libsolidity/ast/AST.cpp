@@ -92,18 +92,25 @@ bool ContractDefinition::derivesFrom(ContractDefinition const& _base) const
 
 map<util::FixedHash<4>, FunctionTypePointer> ContractDefinition::interfaceFunctions(bool _includeInheritedFunctions) const
 {
-	auto exportedFunctionList = interfaceFunctionList(_includeInheritedFunctions);
-
-	map<util::FixedHash<4>, FunctionTypePointer> exportedFunctions;
-	for (auto const& it: exportedFunctionList)
-		exportedFunctions.insert(it);
-
-	solAssert(
-		exportedFunctionList.size() == exportedFunctions.size(),
-		"Hash collision at Function Definition Hash calculation"
-	);
-
-	return exportedFunctions;
+	auto const& exportedFunctions = interfaceFunctionTable(_includeInheritedFunctions);
+	return {exportedFunctions.begin(), exportedFunctions.end()};
+}
+
+vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::interfaceFunctionTable(bool _includeInheritedFunctions) const
+{
+	return m_interfaceFunctionTable[_includeInheritedFunctions].init([&]{
+		auto exportedFunctions = interfaceFunctionList(_includeInheritedFunctions);
+		sort(exportedFunctions.begin(), exportedFunctions.end(), [](auto const& _a, auto const& _b) {
+			return _a.first < _b.first;
+		});
+		solAssert(
+			adjacent_find(exportedFunctions.begin(), exportedFunctions.end(), [](auto const& _a, auto const& _b) {
+				return _a.first == _b.first;
+			}) == exportedFunctions.end(),
+			"Hash collision at Function Definition Hash calculation"
+		);
+		return exportedFunctions;
+	});
 }
 
 FunctionDefinition const* ContractDefinition::constructor() const
@@ -33,6 +33,7 @@
 #include <libevmasm/Instruction.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/ViteAddress.h>
 
 #include <boost/noncopyable.hpp>
 #include <json/json.h>
@@ -514,6 +515,10 @@ public:
 	/// as intended for use by the ABI.
 	std::map<util::FixedHash<4>, FunctionTypePointer> interfaceFunctions(bool _includeInheritedFunctions = true) const;
 	std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> const& interfaceFunctionList(bool _includeInheritedFunctions = true) const;
+	/// Solidity++: @returns the interface functions sorted by selector. Built once, after type
+	/// checking, and shared by the dispatcher, the method identifiers and the gas estimates.
+	/// The ABI output is generated from interfaceFunctionList() and sorted on its own.
+	std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> const& interfaceFunctionTable(bool _includeInheritedFunctions = true) const;
 	/// @returns the EIP-165 compatible interface identifier. This will exclude inherited functions.
 	uint32_t interfaceId() const;
 
@@ -553,6 +558,7 @@ protected:
 	bool m_abstract{false};
 
 	util::LazyInit<std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList[2];
+	util::LazyInit<std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionTable[2];
 	util::LazyInit<std::vector<EventDefinition const*>> m_interfaceEvents;
 };
 
@@ -2215,10 +2221,20 @@ public:
 	/// Solidity++: get vite token id in hex
 	ASTString getViteTokenIdHex() const;
 
+	/// Solidity++: @returns the decoded vite address, or nullopt if it fails the checksum test.
+	/// Decoded once, the checks of the type checker and the code generator share the result.
+	std::optional<util::h168> const& viteAddress() const;
+
+	/// Solidity++: @returns the decoded vite token id, or nullopt if it fails the checksum test.
+	std::optional<util::h80> const& viteTokenId() const;
+
 private:
 	Token m_token;
 	ASTPointer<ASTString> m_value;
 	SubDenomination m_subDenomination;
+	// Solidity++:
+	util::LazyInit<std::optional<util::h168>> m_viteAddress;
+	util::LazyInit<std::optional<util::h80>> m_viteTokenId;
 };
 
 /// @}
@@ -82,6 +82,9 @@ struct SourceUnitAnnotation: ASTAnnotation
 	SetOnce<bool> useABICoderV2;
 	/// Solidity++: The programing language of this source unit
 	SetOnce<SourceLanguage> sourceLanguage;
+	/// Solidity++: State variables of the contracts in this source unit may be reordered
+	/// to use fewer storage slots ("pragma storagelayout packed").
+	bool packedStorage = false;
 };
 
 struct ScopableAnnotation
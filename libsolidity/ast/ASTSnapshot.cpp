@@ -0,0 +1,1277 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Binary snapshot of source units, an alternative to importing the JSON AST that keeps the
+ * Solidity++ parts of the AST.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolidity/ast/ASTSnapshot.h>
+
+#include <libsolidity/ast/SolidityppAST.h>
+#include <libsolidity/interface/Version.h>
+
+#include <libyul/AsmParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+/*
+ * Layout of a snapshot, all integers are LEB128 encoded, signed ones zig-zag encoded first:
+ *
+ *   magic "SOLPPAST", format version, compiler version (length and bytes),
+ *   string table (count, then length and bytes of each string),
+ *   sources (count, then per source: name, source text, source language and the source unit).
+ *
+ * A node is written as its kind, id, start and end of its location, followed by its fields
+ * in constructor order. Child nodes are written in place, kind 0 stands for a null node.
+ * Strings are written as their index in the string table plus one, 0 is a null string.
+ * Inline assembly is written as the offset and length of its Yul block in the source text.
+ */
+
+namespace
+{
+
+string_view const c_magic = "SOLPPAST";
+uint64_t const c_formatVersion = 2;
+
+enum NodeKind: uint8_t
+{
+	Null = 0,
+	SourceUnitKind,
+	PragmaDirectiveKind,
+	ImportDirectiveKind,
+	ContractDefinitionKind,
+	IdentifierPathKind,
+	InheritanceSpecifierKind,
+	UsingForDirectiveKind,
+	StructDefinitionKind,
+	EnumDefinitionKind,
+	EnumValueKind,
+	ParameterListKind,
+	OverrideSpecifierKind,
+	FunctionDefinitionKind,
+	VariableDeclarationKind,
+	ModifierDefinitionKind,
+	ModifierInvocationKind,
+	EventDefinitionKind,
+	ElementaryTypeNameKind,
+	UserDefinedTypeNameKind,
+	FunctionTypeNameKind,
+	MappingKind,
+	ArrayTypeNameKind,
+	InlineAssemblyKind,
+	BlockKind,
+	PlaceholderStatementKind,
+	IfStatementKind,
+	TryCatchClauseKind,
+	TryStatementKind,
+	WhileStatementKind,
+	ForStatementKind,
+	ContinueKind,
+	BreakKind,
+	ReturnKind,
+	ThrowKind,
+	EmitStatementKind,
+	VariableDeclarationStatementKind,
+	ExpressionStatementKind,
+	ConditionalKind,
+	AssignmentKind,
+	TupleExpressionKind,
+	UnaryOperationKind,
+	BinaryOperationKind,
+	FunctionCallKind,
+	FunctionCallOptionsKind,
+	NewExpressionKind,
+	MemberAccessKind,
+	IndexAccessKind,
+	IndexRangeAccessKind,
+	IdentifierKind,
+	ElementaryTypeNameExpressionKind,
+	LiteralKind,
+	StructuredDocumentationKind,
+	AwaitExpressionKind  // Solidity++
+};
+
+/// @returns the visibility as given in the source, i.e. Default if none was specified.
+Visibility specifiedVisibility(Declaration const& _declaration)
+{
+	return _declaration.noVisibilitySpecified() ? Visibility::Default : _declaration.visibility();
+}
+
+}
+
+void ASTSnapshotWriter::addSource(string const& _name, string const& _text, SourceUnit const& _ast)
+{
+	++m_sourceCount;
+	writeString(_name);
+	writeString(_text);
+	writeUnsigned(static_cast<uint64_t>(*_ast.annotation().sourceLanguage));
+	writeNode(&_ast);
+}
+
+string ASTSnapshotWriter::snapshot() const
+{
+	ASTSnapshotWriter header;
+	header.m_data = c_magic;
+	header.writeUnsigned(c_formatVersion);
+	header.writeUnsigned(SolidityppVersionString.size());
+	header.m_data += SolidityppVersionString;
+	header.writeUnsigned(m_strings.size());
+	for (string const* str: m_strings)
+	{
+		header.writeUnsigned(str->size());
+		header.m_data += *str;
+	}
+	header.writeUnsigned(m_sourceCount);
+	return header.m_data + m_data;
+}
+
+bool ASTSnapshotWriter::visit(SourceUnit const& _node)
+{
+	writeHeader(_node, SourceUnitKind);
+	writeBool(_node.licenseString().has_value());
+	if (_node.licenseString())
+		writeString(*_node.licenseString());
+	writeNodes(_node.nodes());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(PragmaDirective const& _node)
+{
+	writeHeader(_node, PragmaDirectiveKind);
+	writeUnsigned(_node.tokens().size());
+	for (Token token: _node.tokens())
+		writeUnsigned(static_cast<uint64_t>(token));
+	writeUnsigned(_node.literals().size());
+	for (ASTString const& literal: _node.literals())
+		writeString(literal);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ImportDirective const& _node)
+{
+	writeHeader(_node, ImportDirectiveKind);
+	writeString(_node.path());
+	writeString(_node.name());
+	writeUnsigned(_node.symbolAliases().size());
+	for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
+	{
+		writeNode(symbolAlias.symbol.get());
+		writeOptionalString(symbolAlias.alias);
+		writeSigned(symbolAlias.location.start);
+		writeSigned(symbolAlias.location.end);
+	}
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ContractDefinition const& _node)
+{
+	writeHeader(_node, ContractDefinitionKind);
+	writeString(_node.name());
+	writeNode(_node.documentation().get());
+	writeNodes(_node.baseContracts());
+	writeNodes(_node.subNodes());
+	writeUnsigned(static_cast<uint64_t>(_node.contractKind()));
+	writeBool(_node.abstract());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(IdentifierPath const& _node)
+{
+	writeHeader(_node, IdentifierPathKind);
+	writeUnsigned(_node.path().size());
+	for (ASTString const& name: _node.path())
+		writeString(name);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(InheritanceSpecifier const& _node)
+{
+	writeHeader(_node, InheritanceSpecifierKind);
+	writeNode(&_node.name());
+	writeBool(_node.arguments());
+	if (_node.arguments())
+		writeNodes(*_node.arguments());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(UsingForDirective const& _node)
+{
+	writeHeader(_node, UsingForDirectiveKind);
+	writeNode(&_node.libraryName());
+	writeNode(_node.typeName());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(StructDefinition const& _node)
+{
+	writeHeader(_node, StructDefinitionKind);
+	writeString(_node.name());
+	writeNodes(_node.members());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EnumDefinition const& _node)
+{
+	writeHeader(_node, EnumDefinitionKind);
+	writeString(_node.name());
+	writeNodes(_node.members());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EnumValue const& _node)
+{
+	writeHeader(_node, EnumValueKind);
+	writeString(_node.name());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ParameterList const& _node)
+{
+	writeHeader(_node, ParameterListKind);
+	writeNodes(_node.parameters());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(OverrideSpecifier const& _node)
+{
+	writeHeader(_node, OverrideSpecifierKind);
+	writeNodes(_node.overrides());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(FunctionDefinition const& _node)
+{
+	writeHeader(_node, FunctionDefinitionKind);
+	writeString(_node.name());
+	writeUnsigned(static_cast<uint64_t>(specifiedVisibility(_node)));
+	writeUnsigned(static_cast<uint64_t>(_node.stateMutability()));
+	writeBool(_node.isFree());
+	writeUnsigned(static_cast<uint64_t>(_node.kind()));
+	writeBool(_node.markedVirtual());
+	writeNode(_node.overrides().get());
+	writeNode(_node.documentation().get());
+	writeNode(&_node.parameterList());
+	writeNodes(_node.modifiers());
+	writeNode(_node.returnParameterList().get());
+	writeNode(_node.isImplemented() ? &_node.body() : nullptr);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(VariableDeclaration const& _node)
+{
+	writeHeader(_node, VariableDeclarationKind);
+	writeNode(&_node.typeName());
+	writeString(_node.name());
+	writeNode(_node.value().get());
+	writeUnsigned(static_cast<uint64_t>(specifiedVisibility(_node)));
+	writeNode(_node.documentation().get());
+	writeBool(_node.isIndexed());
+	writeUnsigned(static_cast<uint64_t>(_node.mutability()));
+	writeNode(_node.overrides().get());
+	writeUnsigned(static_cast<uint64_t>(_node.referenceLocation()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ModifierDefinition const& _node)
+{
+	writeHeader(_node, ModifierDefinitionKind);
+	writeString(_node.name());
+	writeNode(_node.documentation().get());
+	writeNode(&_node.parameterList());
+	writeBool(_node.markedVirtual());
+	writeNode(_node.overrides().get());
+	writeNode(_node.isImplemented() ? &_node.body() : nullptr);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ModifierInvocation const& _node)
+{
+	writeHeader(_node, ModifierInvocationKind);
+	writeNode(&_node.name());
+	writeBool(_node.arguments());
+	if (_node.arguments())
+		writeNodes(*_node.arguments());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EventDefinition const& _node)
+{
+	writeHeader(_node, EventDefinitionKind);
+	writeString(_node.name());
+	writeNode(_node.documentation().get());
+	writeNode(&_node.parameterList());
+	writeBool(_node.isAnonymous());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ElementaryTypeName const& _node)
+{
+	writeHeader(_node, ElementaryTypeNameKind);
+	writeUnsigned(static_cast<uint64_t>(_node.typeName().token()));
+	writeUnsigned(_node.typeName().firstNumber());
+	writeUnsigned(_node.typeName().secondNumber());
+	writeBool(_node.stateMutability().has_value());
+	if (_node.stateMutability())
+		writeUnsigned(static_cast<uint64_t>(*_node.stateMutability()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(UserDefinedTypeName const& _node)
+{
+	writeHeader(_node, UserDefinedTypeNameKind);
+	writeNode(&_node.pathNode());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(FunctionTypeName const& _node)
+{
+	writeHeader(_node, FunctionTypeNameKind);
+	writeNode(_node.parameterTypeList().get());
+	writeNode(_node.returnParameterTypeList().get());
+	writeUnsigned(static_cast<uint64_t>(_node.visibility()));
+	writeUnsigned(static_cast<uint64_t>(_node.stateMutability()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Mapping const& _node)
+{
+	writeHeader(_node, MappingKind);
+	writeNode(&_node.keyType());
+	writeNode(&_node.valueType());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ArrayTypeName const& _node)
+{
+	writeHeader(_node, ArrayTypeNameKind);
+	writeNode(&_node.baseType());
+	writeNode(_node.length());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(InlineAssembly const& _node)
+{
+	// The Yul code is parsed again from the source text when reading.
+	SourceLocation const& block = _node.operations().location;
+	writeHeader(_node, InlineAssemblyKind);
+	writeOptionalString(_node.documentation());
+	writeUnsigned(static_cast<uint64_t>(block.start));
+	writeUnsigned(static_cast<uint64_t>(block.end - block.start));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Block const& _node)
+{
+	writeHeader(_node, BlockKind);
+	writeOptionalString(_node.documentation());
+	writeBool(_node.unchecked());
+	writeNodes(_node.statements());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(PlaceholderStatement const& _node)
+{
+	writeHeader(_node, PlaceholderStatementKind);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(IfStatement const& _node)
+{
+	writeHeader(_node, IfStatementKind);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.condition());
+	writeNode(&_node.trueStatement());
+	writeNode(_node.falseStatement());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(TryCatchClause const& _node)
+{
+	writeHeader(_node, TryCatchClauseKind);
+	writeString(_node.errorName());
+	writeNode(_node.parameters());
+	writeNode(&_node.block());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(TryStatement const& _node)
+{
+	writeHeader(_node, TryStatementKind);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.externalCall());
+	writeNodes(_node.clauses());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(WhileStatement const& _node)
+{
+	writeHeader(_node, WhileStatementKind);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.condition());
+	writeNode(&_node.body());
+	writeBool(_node.isDoWhile());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ForStatement const& _node)
+{
+	writeHeader(_node, ForStatementKind);
+	writeOptionalString(_node.documentation());
+	writeNode(_node.initializationExpression());
+	writeNode(_node.condition());
+	writeNode(_node.loopExpression());
+	writeNode(&_node.body());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Continue const& _node)
+{
+	writeHeader(_node, ContinueKind);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Break const& _node)
+{
+	writeHeader(_node, BreakKind);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Return const& _node)
+{
+	writeHeader(_node, ReturnKind);
+	writeOptionalString(_node.documentation());
+	writeNode(_node.expression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Throw const& _node)
+{
+	writeHeader(_node, ThrowKind);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EmitStatement const& _node)
+{
+	writeHeader(_node, EmitStatementKind);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.eventCall());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(VariableDeclarationStatement const& _node)
+{
+	writeHeader(_node, VariableDeclarationStatementKind);
+	writeOptionalString(_node.documentation());
+	writeNodes(_node.declarations());
+	writeNode(_node.initialValue());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ExpressionStatement const& _node)
+{
+	writeHeader(_node, ExpressionStatementKind);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.expression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Conditional const& _node)
+{
+	writeHeader(_node, ConditionalKind);
+	writeNode(&_node.condition());
+	writeNode(&_node.trueExpression());
+	writeNode(&_node.falseExpression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Assignment const& _node)
+{
+	writeHeader(_node, AssignmentKind);
+	writeNode(&_node.leftHandSide());
+	writeUnsigned(static_cast<uint64_t>(_node.assignmentOperator()));
+	writeNode(&_node.rightHandSide());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(TupleExpression const& _node)
+{
+	writeHeader(_node, TupleExpressionKind);
+	writeNodes(_node.components());
+	writeBool(_node.isInlineArray());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(UnaryOperation const& _node)
+{
+	writeHeader(_node, UnaryOperationKind);
+	writeUnsigned(static_cast<uint64_t>(_node.getOperator()));
+	writeNode(&_node.subExpression());
+	writeBool(_node.isPrefixOperation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(BinaryOperation const& _node)
+{
+	writeHeader(_node, BinaryOperationKind);
+	writeNode(&_node.leftExpression());
+	writeUnsigned(static_cast<uint64_t>(_node.getOperator()));
+	writeNode(&_node.rightExpression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(FunctionCall const& _node)
+{
+	writeHeader(_node, FunctionCallKind);
+	writeNode(&_node.expression());
+	writeNodes(_node.arguments());
+	writeUnsigned(_node.names().size());
+	for (ASTPointer<ASTString> const& name: _node.names())
+		writeString(*name);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(FunctionCallOptions const& _node)
+{
+	writeHeader(_node, FunctionCallOptionsKind);
+	writeNode(&_node.expression());
+	writeNodes(_node.options());
+	writeUnsigned(_node.names().size());
+	for (ASTPointer<ASTString> const& name: _node.names())
+		writeString(*name);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(NewExpression const& _node)
+{
+	writeHeader(_node, NewExpressionKind);
+	writeNode(&_node.typeName());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(MemberAccess const& _node)
+{
+	writeHeader(_node, MemberAccessKind);
+	writeNode(&_node.expression());
+	writeString(_node.memberName());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(IndexAccess const& _node)
+{
+	writeHeader(_node, IndexAccessKind);
+	writeNode(&_node.baseExpression());
+	writeNode(_node.indexExpression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(IndexRangeAccess const& _node)
+{
+	writeHeader(_node, IndexRangeAccessKind);
+	writeNode(&_node.baseExpression());
+	writeNode(_node.startExpression());
+	writeNode(_node.endExpression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Identifier const& _node)
+{
+	writeHeader(_node, IdentifierKind);
+	writeString(_node.name());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ElementaryTypeNameExpression const& _node)
+{
+	writeHeader(_node, ElementaryTypeNameExpressionKind);
+	writeNode(&_node.type());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Literal const& _node)
+{
+	writeHeader(_node, LiteralKind);
+	writeUnsigned(static_cast<uint64_t>(_node.token()));
+	writeString(_node.value());
+	writeUnsigned(static_cast<uint64_t>(_node.subDenomination()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(StructuredDocumentation const& _node)
+{
+	writeHeader(_node, StructuredDocumentationKind);
+	writeString(*_node.text());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(AwaitExpression const& _node)
+{
+	writeHeader(_node, AwaitExpressionKind);
+	writeNode(&_node.expression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visitNode(ASTNode const&)
+{
+	astAssert(false, "AST node not supported by the AST snapshot.");
+	return false;
+}
+
+void ASTSnapshotWriter::writeHeader(ASTNode const& _node, uint8_t _kind)
+{
+	writeUnsigned(_kind);
+	writeSigned(_node.id());
+	writeSigned(_node.location().start);
+	writeSigned(_node.location().end);
+}
+
+void ASTSnapshotWriter::writeNode(ASTNode const* _node)
+{
+	if (_node)
+		_node->accept(*this);
+	else
+		writeUnsigned(Null);
+}
+
+template <class T>
+void ASTSnapshotWriter::writeNodes(vector<T> const& _nodes)
+{
+	writeUnsigned(_nodes.size());
+	for (T const& node: _nodes)
+		writeNode(node.get());
+}
+
+void ASTSnapshotWriter::writeUnsigned(uint64_t _value)
+{
+	for (; _value >= 0x80; _value >>= 7)
+		m_data.push_back(static_cast<char>((_value & 0x7f) | 0x80));
+	m_data.push_back(static_cast<char>(_value));
+}
+
+void ASTSnapshotWriter::writeSigned(int64_t _value)
+{
+	writeUnsigned((static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63));
+}
+
+void ASTSnapshotWriter::writeString(string const& _string)
+{
+	auto [it, inserted] = m_stringIndices.emplace(_string, m_strings.size());
+	if (inserted)
+		m_strings.push_back(&it->first);
+	writeUnsigned(it->second + 1);
+}
+
+void ASTSnapshotWriter::writeOptionalString(ASTPointer<ASTString> const& _string)
+{
+	if (_string)
+		writeString(*_string);
+	else
+		writeUnsigned(0);
+}
+
+bool ASTSnapshotReader::isSnapshot(string_view _data)
+{
+	return _data.substr(0, c_magic.size()) == c_magic;
+}
+
+map<string, ASTSnapshotReader::Source> ASTSnapshotReader::read(string_view _data)
+{
+	astAssert(isSnapshot(_data), "Not an AST snapshot.");
+	m_data = _data;
+	m_position = c_magic.size();
+	m_strings.clear();
+	m_usedIds.clear();
+
+	astAssert(readUnsigned() == c_formatVersion, "Unsupported AST snapshot format.");
+	string_view version = readBytes(readSize());
+	astAssert(
+		version == SolidityppVersionString,
+		"AST snapshot was written by compiler version " + string(version) + "."
+	);
+
+	m_strings.resize(readSize());
+	for (auto& str: m_strings)
+	{
+		string_view bytes = readBytes(readSize());
+		str = make_shared<ASTString>(bytes.begin(), bytes.end());
+	}
+
+	map<string, Source> sources;
+	for (size_t count = readSize(); count > 0; --count)
+	{
+		m_sourceName = *readString();
+		m_scanner = make_shared<Scanner>(CharStream(*readString(), m_sourceName));
+		m_charStream = m_scanner->charStream();
+		m_assemblyScanner.reset();
+		SourceLanguage language = readEnum(SourceLanguage::Soliditypp);
+		ASTPointer<SourceUnit> ast = readNode<SourceUnit>();
+		ast->annotation().sourceLanguage = language;
+		astAssert(!sources.count(m_sourceName), "Duplicate source in AST snapshot.");
+		sources[m_sourceName] = Source{m_scanner, move(ast)};
+	}
+	astAssert(m_position == m_data.size(), "Trailing data in AST snapshot.");
+
+	m_scanner.reset();
+	m_charStream.reset();
+	m_assemblyScanner.reset();
+	return sources;
+}
+
+ASTPointer<ASTNode> ASTSnapshotReader::readNode()
+{
+	// Function arguments are evaluated in unspecified order, so all fields are read into
+	// variables before the node is created.
+	auto kind = static_cast<NodeKind>(readUnsigned());
+	if (kind == Null)
+		return nullptr;
+	int64_t id = readSigned();
+	astAssert(m_usedIds.insert(id).second, "Duplicate node id in AST snapshot.");
+	SourceLocation location = readLocation();
+
+	switch (kind)
+	{
+	case SourceUnitKind:
+	{
+		optional<string> license;
+		if (readBool())
+			license = *readString();
+		auto nodes = readNodes<ASTNode>();
+		return make_shared<SourceUnit>(id, location, move(license), move(nodes));
+	}
+	case PragmaDirectiveKind:
+	{
+		vector<Token> tokens(readSize());
+		for (Token& token: tokens)
+			token = readToken();
+		vector<ASTString> literals(readSize());
+		for (ASTString& literal: literals)
+			literal = *readString();
+		return make_shared<PragmaDirective>(id, location, move(tokens), move(literals));
+	}
+	case ImportDirectiveKind:
+	{
+		auto path = readString();
+		auto unitAlias = readString();
+		ImportDirective::SymbolAliasList symbolAliases(readSize());
+		for (ImportDirective::SymbolAlias& symbolAlias: symbolAliases)
+		{
+			symbolAlias.symbol = readNode<Identifier>();
+			symbolAlias.alias = readOptionalString();
+			symbolAlias.location = readLocation();
+		}
+		return make_shared<ImportDirective>(id, location, path, unitAlias, move(symbolAliases));
+	}
+	case ContractDefinitionKind:
+	{
+		auto name = readString();
+		auto documentation = readNode<StructuredDocumentation>(true);
+		auto baseContracts = readNodes<InheritanceSpecifier>();
+		auto subNodes = readNodes<ASTNode>();
+		auto contractKind = readEnum(ContractKind::Library);
+		bool abstract = readBool();
+		return make_shared<ContractDefinition>(
+			id,
+			location,
+			name,
+			documentation,
+			move(baseContracts),
+			move(subNodes),
+			contractKind,
+			abstract
+		);
+	}
+	case IdentifierPathKind:
+	{
+		vector<ASTString> path(readSize());
+		for (ASTString& name: path)
+			name = *readString();
+		return make_shared<IdentifierPath>(id, location, move(path));
+	}
+	case InheritanceSpecifierKind:
+	{
+		auto baseName = readNode<IdentifierPath>();
+		auto arguments = readOptionalNodes();
+		return make_shared<InheritanceSpecifier>(id, location, move(baseName), move(arguments));
+	}
+	case UsingForDirectiveKind:
+	{
+		auto libraryName = readNode<IdentifierPath>();
+		auto typeName = readNode<TypeName>(true);
+		return make_shared<UsingForDirective>(id, location, move(libraryName), move(typeName));
+	}
+	case StructDefinitionKind:
+	{
+		auto name = readString();
+		auto members = readNodes<VariableDeclaration>();
+		return make_shared<StructDefinition>(id, location, name, move(members));
+	}
+	case EnumDefinitionKind:
+	{
+		auto name = readString();
+		auto members = readNodes<EnumValue>();
+		return make_shared<EnumDefinition>(id, location, name, move(members));
+	}
+	case EnumValueKind:
+		return make_shared<EnumValue>(id, location, readString());
+	case ParameterListKind:
+		return make_shared<ParameterList>(id, location, readNodes<VariableDeclaration>());
+	case OverrideSpecifierKind:
+		return make_shared<OverrideSpecifier>(id, location, readNodes<IdentifierPath>());
+	case FunctionDefinitionKind:
+	{
+		auto name = readString();
+		auto visibility = readEnum(Visibility::External);
+		auto stateMutability = readEnum(StateMutability::Payable);
+		bool free = readBool();
+		Token functionKind = readToken();
+		bool isVirtual = readBool();
+		auto overrides = readNode<OverrideSpecifier>(true);
+		auto documentation = readNode<StructuredDocumentation>(true);
+		auto parameters = readNode<ParameterList>();
+		auto modifiers = readNodes<ModifierInvocation>();
+		auto returnParameters = readNode<ParameterList>(true);
+		auto body = readNode<Block>(true);
+		return make_shared<FunctionDefinition>(
+			id,
+			location,
+			name,
+			visibility,
+			stateMutability,
+			free,
+			functionKind,
+			isVirtual,
+			overrides,
+			documentation,
+			parameters,
+			move(modifiers),
+			returnParameters,
+			body
+		);
+	}
+	case VariableDeclarationKind:
+	{
+		auto typeName = readNode<TypeName>();
+		auto name = readString();
+		auto value = readNode<Expression>(true);
+		auto visibility = readEnum(Visibility::External);
+		auto documentation = readNode<StructuredDocumentation>(true);
+		bool isIndexed = readBool();
+		auto mutability = readEnum(VariableDeclaration::Mutability::Constant);
+		auto overrides = readNode<OverrideSpecifier>(true);
+		auto referenceLocation = readEnum(VariableDeclaration::Location::CallData);
+		return make_shared<VariableDeclaration>(
+			id,
+			location,
+			move(typeName),
+			name,
+			move(value),
+			visibility,
+			documentation,
+			isIndexed,
+			mutability,
+			move(overrides),
+			referenceLocation
+		);
+	}
+	case ModifierDefinitionKind:
+	{
+		auto name = readString();
+		auto documentation = readNode<StructuredDocumentation>(true);
+		auto parameters = readNode<ParameterList>();
+		bool isVirtual = readBool();
+		auto overrides = readNode<OverrideSpecifier>(true);
+		auto body = readNode<Block>(true);
+		return make_shared<ModifierDefinition>(id, location, name, documentation, parameters, isVirtual, overrides, body);
+	}
+	case ModifierInvocationKind:
+	{
+		auto name = readNode<IdentifierPath>();
+		auto arguments = readOptionalNodes();
+		return make_shared<ModifierInvocation>(id, location, move(name), move(arguments));
+	}
+	case EventDefinitionKind:
+	{
+		auto name = readString();
+		auto documentation = readNode<StructuredDocumentation>(true);
+		auto parameters = readNode<ParameterList>();
+		bool anonymous = readBool();
+		return make_shared<EventDefinition>(id, location, name, documentation, parameters, anonymous);
+	}
+	case ElementaryTypeNameKind:
+	{
+		Token token = readToken();
+		auto firstNumber = static_cast<unsigned>(readUnsigned());
+		auto secondNumber = static_cast<unsigned>(readUnsigned());
+		optional<StateMutability> stateMutability;
+		if (readBool())
+			stateMutability = readEnum(StateMutability::Payable);
+		return make_shared<ElementaryTypeName>(
+			id,
+			location,
+			ElementaryTypeNameToken(token, firstNumber, secondNumber),
+			stateMutability
+		);
+	}
+	case UserDefinedTypeNameKind:
+		return make_shared<UserDefinedTypeName>(id, location, readNode<IdentifierPath>());
+	case FunctionTypeNameKind:
+	{
+		auto parameterTypes = readNode<ParameterList>();
+		auto returnTypes = readNode<ParameterList>();
+		auto visibility = readEnum(Visibility::External);
+		auto stateMutability = readEnum(StateMutability::Payable);
+		return make_shared<FunctionTypeName>(id, location, move(parameterTypes), move(returnTypes), visibility, stateMutability);
+	}
+	case MappingKind:
+	{
+		auto keyType = readNode<TypeName>();
+		auto valueType = readNode<TypeName>();
+		return make_shared<Mapping>(id, location, move(keyType), move(valueType));
+	}
+	case ArrayTypeNameKind:
+	{
+		auto baseType = readNode<TypeName>();
+		auto length = readNode<Expression>(true);
+		return make_shared<ArrayTypeName>(id, location, move(baseType), move(length));
+	}
+	case InlineAssemblyKind:
+		return readInlineAssembly(id, location, readOptionalString());
+	case BlockKind:
+	{
+		auto documentation = readOptionalString();
+		bool unchecked = readBool();
+		auto statements = readNodes<Statement>();
+		return make_shared<Block>(id, location, documentation, unchecked, move(statements));
+	}
+	case PlaceholderStatementKind:
+		return make_shared<PlaceholderStatement>(id, location, readOptionalString());
+	case IfStatementKind:
+	{
+		auto documentation = readOptionalString();
+		auto condition = readNode<Expression>();
+		auto trueBody = readNode<Statement>();
+		auto falseBody = readNode<Statement>(true);
+		return make_shared<IfStatement>(id, location, documentation, move(condition), move(trueBody), move(falseBody));
+	}
+	case TryCatchClauseKind:
+	{
+		auto errorName = readString();
+		auto parameters = readNode<ParameterList>(true);
+		auto block = readNode<Block>();
+		return make_shared<TryCatchClause>(id, location, errorName, move(parameters), move(block));
+	}
+	case TryStatementKind:
+	{
+		auto documentation = readOptionalString();
+		auto externalCall = readNode<Expression>();
+		auto clauses = readNodes<TryCatchClause>();
+		return make_shared<TryStatement>(id, location, documentation, move(externalCall), move(clauses));
+	}
+	case WhileStatementKind:
+	{
+		auto documentation = readOptionalString();
+		auto condition = readNode<Expression>();
+		auto body = readNode<Statement>();
+		bool isDoWhile = readBool();
+		return make_shared<WhileStatement>(id, location, documentation, move(condition), move(body), isDoWhile);
+	}
+	case ForStatementKind:
+	{
+		auto documentation = readOptionalString();
+		auto initialization = readNode<Statement>(true);
+		auto condition = readNode<Expression>(true);
+		auto loopExpression = readNode<ExpressionStatement>(true);
+		auto body = readNode<Statement>();
+		return make_shared<ForStatement>(
+			id,
+			location,
+			documentation,
+			move(initialization),
+			move(condition),
+			move(loopExpression),
+			move(body)
+		);
+	}
+	case ContinueKind:
+		return make_shared<Continue>(id, location, readOptionalString());
+	case BreakKind:
+		return make_shared<Break>(id, location, readOptionalString());
+	case ReturnKind:
+	{
+		auto documentation = readOptionalString();
+		auto expression = readNode<Expression>(true);
+		return make_shared<Return>(id, location, documentation, move(expression));
+	}
+	case ThrowKind:
+		return make_shared<Throw>(id, location, readOptionalString());
+	case EmitStatementKind:
+	{
+		auto documentation = readOptionalString();
+		auto eventCall = readNode<FunctionCall>();
+		return make_shared<EmitStatement>(id, location, documentation, move(eventCall));
+	}
+	case VariableDeclarationStatementKind:
+	{
+		auto documentation = readOptionalString();
+		auto variables = readNodes<VariableDeclaration>(true);
+		auto initialValue = readNode<Expression>(true);
+		return make_shared<VariableDeclarationStatement>(id, location, documentation, move(variables), move(initialValue));
+	}
+	case ExpressionStatementKind:
+	{
+		auto documentation = readOptionalString();
+		auto expression = readNode<Expression>();
+		return make_shared<ExpressionStatement>(id, location, documentation, move(expression));
+	}
+	case ConditionalKind:
+	{
+		auto condition = readNode<Expression>();
+		auto trueExpression = readNode<Expression>();
+		auto falseExpression = readNode<Expression>();
+		return make_shared<Conditional>(id, location, move(condition), move(trueExpression), move(falseExpression));
+	}
+	case AssignmentKind:
+	{
+		auto leftHandSide = readNode<Expression>();
+		Token assignmentOperator = readToken();
+		astAssert(TokenTraits::isAssignmentOp(assignmentOperator), "Invalid assignment operator in AST snapshot.");
+		auto rightHandSide = readNode<Expression>();
+		return make_shared<Assignment>(id, location, move(leftHandSide), assignmentOperator, move(rightHandSide));
+	}
+	case TupleExpressionKind:
+	{
+		auto components = readNodes<Expression>(true);
+		bool isArray = readBool();
+		return make_shared<TupleExpression>(id, location, move(components), isArray);
+	}
+	case UnaryOperationKind:
+	{
+		Token unaryOperator = readToken();
+		astAssert(TokenTraits::isUnaryOp(unaryOperator), "Invalid unary operator in AST snapshot.");
+		auto subExpression = readNode<Expression>();
+		bool isPrefix = readBool();
+		return make_shared<UnaryOperation>(id, location, unaryOperator, move(subExpression), isPrefix);
+	}
+	case BinaryOperationKind:
+	{
+		auto left = readNode<Expression>();
+		Token binaryOperator = readToken();
+		astAssert(
+			TokenTraits::isBinaryOp(binaryOperator) || TokenTraits::isCompareOp(binaryOperator),
+			"Invalid binary operator in AST snapshot."
+		);
+		auto right = readNode<Expression>();
+		return make_shared<BinaryOperation>(id, location, move(left), binaryOperator, move(right));
+	}
+	case FunctionCallKind:
+	case FunctionCallOptionsKind:
+	{
+		auto expression = readNode<Expression>();
+		auto arguments = readNodes<Expression>();
+		vector<ASTPointer<ASTString>> names(readSize());
+		for (ASTPointer<ASTString>& name: names)
+			name = readString();
+		if (kind == FunctionCallKind)
+			return make_shared<FunctionCall>(id, location, move(expression), move(arguments), move(names));
+		return make_shared<FunctionCallOptions>(id, location, move(expression), move(arguments), move(names));
+	}
+	case NewExpressionKind:
+		return make_shared<NewExpression>(id, location, readNode<TypeName>());
+	case MemberAccessKind:
+	{
+		auto expression = readNode<Expression>();
+		auto memberName = readString();
+		return make_shared<MemberAccess>(id, location, move(expression), memberName);
+	}
+	case IndexAccessKind:
+	{
+		auto base = readNode<Expression>();
+		auto index = readNode<Expression>(true);
+		return make_shared<IndexAccess>(id, location, move(base), move(index));
+	}
+	case IndexRangeAccessKind:
+	{
+		auto base = readNode<Expression>();
+		auto start = readNode<Expression>(true);
+		auto end = readNode<Expression>(true);
+		return make_shared<IndexRangeAccess>(id, location, move(base), move(start), move(end));
+	}
+	case IdentifierKind:
+		return make_shared<Identifier>(id, location, readString());
+	case ElementaryTypeNameExpressionKind:
+		return make_shared<ElementaryTypeNameExpression>(id, location, readNode<ElementaryTypeName>());
+	case LiteralKind:
+	{
+		Token token = readToken();
+		auto value = readString();
+		auto subDenomination = static_cast<Literal::SubDenomination>(readToken());
+		return make_shared<Literal>(id, location, token, value, subDenomination);
+	}
+	case StructuredDocumentationKind:
+		return make_shared<StructuredDocumentation>(id, location, readString());
+	case AwaitExpressionKind:
+		return make_shared<AwaitExpression>(id, location, readNode<Expression>());
+	default:
+		break;
+	}
+	astAssert(false, "Unknown node kind in AST snapshot.");
+	return nullptr;
+}
+
+template <class T>
+ASTPointer<T> ASTSnapshotReader::readNode(bool _optional)
+{
+	ASTPointer<ASTNode> node = readNode();
+	if (!node)
+	{
+		astAssert(_optional, "Missing node in AST snapshot.");
+		return nullptr;
+	}
+	ASTPointer<T> typedNode = dynamic_pointer_cast<T>(node);
+	astAssert(typedNode, "Unexpected node type in AST snapshot.");
+	return typedNode;
+}
+
+template <class T>
+vector<ASTPointer<T>> ASTSnapshotReader::readNodes(bool _optionalElements)
+{
+	vector<ASTPointer<T>> nodes(readSize());
+	for (ASTPointer<T>& node: nodes)
+		node = readNode<T>(_optionalElements);
+	return nodes;
+}
+
+unique_ptr<vector<ASTPointer<Expression>>> ASTSnapshotReader::readOptionalNodes()
+{
+	if (!readBool())
+		return nullptr;
+	return make_unique<vector<ASTPointer<Expression>>>(readNodes<Expression>());
+}
+
+ASTPointer<InlineAssembly> ASTSnapshotReader::readInlineAssembly(
+	int64_t _id,
+	SourceLocation const& _location,
+	ASTPointer<ASTString> const& _docString
+)
+{
+	uint64_t offset = readUnsigned();
+	uint64_t length = readUnsigned();
+	astAssert(
+		_location.start >= 0 && _location.end >= _location.start &&
+		offset >= static_cast<uint64_t>(_location.start) && offset <= static_cast<uint64_t>(_location.end) &&
+		length <= static_cast<uint64_t>(_location.end) - offset,
+		"Inline assembly outside of its location in the AST snapshot."
+	);
+
+	// One scanner per source is positioned at each block, so the source is not scanned
+	// again from the start.
+	if (!m_assemblyScanner)
+		m_assemblyScanner = make_shared<Scanner>(CharStream(m_scanner->source(), m_sourceName));
+	m_assemblyScanner->setPosition(static_cast<size_t>(offset));
+	astAssert(
+		m_assemblyScanner->currentToken() == Token::LBrace &&
+		m_assemblyScanner->currentLocation().start == static_cast<int>(offset),
+		"Inline assembly of the AST snapshot not found in the source."
+	);
+
+	yul::Dialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	shared_ptr<yul::Block> block = yul::Parser(errorReporter, dialect).parse(m_assemblyScanner, true);
+	astAssert(
+		block && !errorReporter.hasErrors() && block->location.end == static_cast<int>(offset + length),
+		"Invalid inline assembly in AST snapshot."
+	);
+	return make_shared<InlineAssembly>(_id, _location, _docString, dialect, move(block));
+}
+
+uint64_t ASTSnapshotReader::readUnsigned()
+{
+	uint64_t value = 0;
+	for (unsigned shift = 0; ; shift += 7)
+	{
+		astAssert(m_position < m_data.size() && shift < 64, "Truncated AST snapshot.");
+		auto byte = static_cast<uint8_t>(m_data[m_position++]);
+		value |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+}
+
+int64_t ASTSnapshotReader::readSigned()
+{
+	uint64_t value = readUnsigned();
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+bool ASTSnapshotReader::readBool()
+{
+	uint64_t value = readUnsigned();
+	astAssert(value <= 1, "Invalid boolean in AST snapshot.");
+	return value == 1;
+}
+
+size_t ASTSnapshotReader::readSize()
+{
+	uint64_t size = readUnsigned();
+	// Every element takes at least one byte.
+	astAssert(size <= m_data.size() - m_position, "Truncated AST snapshot.");
+	return static_cast<size_t>(size);
+}
+
+template <class E>
+E ASTSnapshotReader::readEnum(E _last)
+{
+	uint64_t value = readUnsigned();
+	astAssert(value <= static_cast<uint64_t>(_last), "Invalid enum value in AST snapshot.");
+	return static_cast<E>(value);
+}
+
+Token ASTSnapshotReader::readToken()
+{
+	uint64_t value = readUnsigned();
+	astAssert(value < static_cast<uint64_t>(Token::NUM_TOKENS), "Invalid token in AST snapshot.");
+	return static_cast<Token>(value);
+}
+
+string_view ASTSnapshotReader::readBytes(size_t _length)
+{
+	astAssert(_length <= m_data.size() - m_position, "Truncated AST snapshot.");
+	string_view bytes = m_data.substr(m_position, _length);
+	m_position += _length;
+	return bytes;
+}
+
+ASTPointer<ASTString> const& ASTSnapshotReader::readString()
+{
+	uint64_t index = readUnsigned();
+	astAssert(index > 0 && index <= m_strings.size(), "Invalid string in AST snapshot.");
+	return m_strings[index - 1];
+}
+
+ASTPointer<ASTString> ASTSnapshotReader::readOptionalString()
+{
+	uint64_t index = readUnsigned();
+	astAssert(index <= m_strings.size(), "Invalid string in AST snapshot.");
+	return index ? m_strings[index - 1] : nullptr;
+}
+
+SourceLocation ASTSnapshotReader::readLocation()
+{
+	int64_t start = readSigned();
+	int64_t end = readSigned();
+	return SourceLocation{static_cast<int>(start), static_cast<int>(end), m_charStream};
+}
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Binary snapshot of source units, an alternative to importing the JSON AST that keeps the
+ * Solidity++ parts of the AST.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/Scanner.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Writes the source units of a compilation, together with their source text, into a binary
+ * snapshot. The snapshot keeps the node ids, the source locations and the parts of the
+ * annotations set by the parser, like the source language. The string table comes first and
+ * all other data is read sequentially from one buffer.
+ *
+ * A snapshot can only be read by the same compiler version that wrote it.
+ */
+class ASTSnapshotWriter: private ASTConstVisitor
+{
+public:
+	/// Adds the source unit @a _ast of the source @a _name with the source text @a _text.
+	void addSource(std::string const& _name, std::string const& _text, SourceUnit const& _ast);
+
+	/// @returns the snapshot of all sources added so far.
+	std::string snapshot() const;
+
+private:
+	bool visit(SourceUnit const& _node) override;
+	bool visit(PragmaDirective const& _node) override;
+	bool visit(ImportDirective const& _node) override;
+	bool visit(ContractDefinition const& _node) override;
+	bool visit(IdentifierPath const& _node) override;
+	bool visit(InheritanceSpecifier const& _node) override;
+	bool visit(UsingForDirective const& _node) override;
+	bool visit(StructDefinition const& _node) override;
+	bool visit(EnumDefinition const& _node) override;
+	bool visit(EnumValue const& _node) override;
+	bool visit(ParameterList const& _node) override;
+	bool visit(OverrideSpecifier const& _node) override;
+	bool visit(FunctionDefinition const& _node) override;
+	bool visit(VariableDeclaration const& _node) override;
+	bool visit(ModifierDefinition const& _node) override;
+	bool visit(ModifierInvocation const& _node) override;
+	bool visit(EventDefinition const& _node) override;
+	bool visit(ElementaryTypeName const& _node) override;
+	bool visit(UserDefinedTypeName const& _node) override;
+	bool visit(FunctionTypeName const& _node) override;
+	bool visit(Mapping const& _node) override;
+	bool visit(ArrayTypeName const& _node) override;
+	bool visit(InlineAssembly const& _node) override;
+	bool visit(Block const& _node) override;
+	bool visit(PlaceholderStatement const& _node) override;
+	bool visit(IfStatement const& _node) override;
+	bool visit(TryCatchClause const& _node) override;
+	bool visit(TryStatement const& _node) override;
+	bool visit(WhileStatement const& _node) override;
+	bool visit(ForStatement const& _node) override;
+	bool visit(Continue const& _node) override;
+	bool visit(Break const& _node) override;
+	bool visit(Return const& _node) override;
+	bool visit(Throw const& _node) override;
+	bool visit(EmitStatement const& _node) override;
+	bool visit(VariableDeclarationStatement const& _node) override;
+	bool visit(ExpressionStatement const& _node) override;
+	bool visit(Conditional const& _node) override;
+	bool visit(Assignment const& _node) override;
+	bool visit(TupleExpression const& _node) override;
+	bool visit(UnaryOperation const& _node) override;
+	bool visit(BinaryOperation const& _node) override;
+	bool visit(FunctionCall const& _node) override;
+	bool visit(FunctionCallOptions const& _node) override;
+	bool visit(NewExpression const& _node) override;
+	bool visit(MemberAccess const& _node) override;
+	bool visit(IndexAccess const& _node) override;
+	bool visit(IndexRangeAccess const& _node) override;
+	bool visit(Identifier const& _node) override;
+	bool visit(ElementaryTypeNameExpression const& _node) override;
+	bool visit(Literal const& _node) override;
+	bool visit(StructuredDocumentation const& _node) override;
+	bool visit(AwaitExpression const& _node) override;  // Solidity++
+	bool visitNode(ASTNode const& _node) override;
+
+	/// Writes the kind, the id and the location of @a _node.
+	void writeHeader(ASTNode const& _node, uint8_t _kind);
+	/// Writes @a _node, which can be null.
+	void writeNode(ASTNode const* _node);
+	template <class T>
+	void writeNodes(std::vector<T> const& _nodes);
+	void writeUnsigned(uint64_t _value);
+	void writeSigned(int64_t _value);
+	void writeBool(bool _value) { m_data.push_back(_value ? 1 : 0); }
+	void writeString(std::string const& _string);
+	void writeOptionalString(ASTPointer<ASTString> const& _string);
+
+	/// Serialised sources.
+	std::string m_data;
+	size_t m_sourceCount = 0;
+	std::map<std::string, size_t> m_stringIndices;
+	std::vector<std::string const*> m_strings;
+};
+
+/**
+ * Reads the source units written by ASTSnapshotWriter. Malformed or incompatible snapshots
+ * cause an InvalidAstError.
+ */
+class ASTSnapshotReader
+{
+public:
+	struct Source
+	{
+		std::shared_ptr<langutil::Scanner> scanner;
+		ASTPointer<SourceUnit> ast;
+	};
+
+	explicit ASTSnapshotReader(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+
+	/// @returns true if @a _data starts like a snapshot.
+	static bool isSnapshot(std::string_view _data);
+
+	/// @returns the sources of the snapshot @a _data by source name.
+	std::map<std::string, Source> read(std::string_view _data);
+
+private:
+	ASTPointer<ASTNode> readNode();
+	/// Reads a node that has to be of type T, or null if @a _optional.
+	template <class T>
+	ASTPointer<T> readNode(bool _optional = false);
+	template <class T>
+	std::vector<ASTPointer<T>> readNodes(bool _optionalElements = false);
+	std::unique_ptr<std::vector<ASTPointer<Expression>>> readOptionalNodes();
+	ASTPointer<InlineAssembly> readInlineAssembly(
+		int64_t _id,
+		langutil::SourceLocation const& _location,
+		ASTPointer<ASTString> const& _docString
+	);
+
+	uint64_t readUnsigned();
+	int64_t readSigned();
+	bool readBool();
+	size_t readSize();
+	template <class E>
+	E readEnum(E _last);
+	Token readToken();
+	std::string_view readBytes(size_t _length);
+	ASTPointer<ASTString> const& readString();
+	ASTPointer<ASTString> readOptionalString();
+	langutil::SourceLocation readLocation();
+
+	langutil::EVMVersion m_evmVersion;
+	std::string_view m_data;
+	size_t m_position = 0;
+	std::vector<ASTPointer<ASTString>> m_strings;
+	std::set<int64_t> m_usedIds;
+	/// Scanner, character stream and name of the source that is currently read.
+	std::shared_ptr<langutil::Scanner> m_scanner;
+	std::shared_ptr<langutil::CharStream> m_charStream;
+	std::string m_sourceName;
+	/// Scanner for the inline assembly blocks of the current source, created on first use.
+	std::shared_ptr<langutil::Scanner> m_assemblyScanner;
+};
+
+}
@@ -50,24 +50,37 @@ bool Literal::looksLikeViteTokenId() const
 // Solidity++: check vite address checksum
 bool Literal::passesViteAddressChecksum() const
 {
-	return util::passesViteAddressChecksum(value());
+	return viteAddress().has_value();
 }
 
-// Solidity++: check vite address checksum
-
+// Solidity++: check vite token id checksum
 bool Literal::passesViteTokenIdChecksum() const
 {
-	return util::passesViteTokenIdChecksum(value());
+	return viteTokenId().has_value();
 }
 
 // Solidity++: get vite address hex value
 ASTString Literal::getViteAddressHex() const
 {
-	return util::getViteAddressHex(value());
+	solAssert(viteAddress(), "Invalid vite address literal.");
+	return "0x" + viteAddress()->hex();
 }
 
 // Solidity++: get vite token id hex value
 ASTString Literal::getViteTokenIdHex() const
 {
-	return util::getViteTokenIdHex(value());
+	solAssert(viteTokenId(), "Invalid vite token id literal.");
+	return "0x" + viteTokenId()->hex();
+}
+
+// Solidity++: decode the vite address only once
+optional<util::h168> const& Literal::viteAddress() const
+{
+	return m_viteAddress.init([&] { return util::decodeViteAddress(value()); });
+}
+
+// Solidity++: decode the vite token id only once
+optional<util::h80> const& Literal::viteTokenId() const
+{
+	return m_viteTokenId.init([&] { return util::decodeViteTokenId(value()); });
 }
@@ -147,6 +147,98 @@ array<unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
 	// MetaType is stored separately
 }};
 
+array<unique_ptr<FunctionType>, TypeProvider::c_numBuiltinFunctions> TypeProvider::m_builtinFunctions;
+
+namespace
+{
+
+/// Solidity++: parameter types of the builtin functions.
+enum class BuiltinType
+{
+	Bool, Uint8, Uint64, Uint256, Bytes20, Bytes32, Address, PayableAddress, BytesMemory, StringMemory, ViteTokenId
+};
+
+struct BuiltinFunctionSignature
+{
+	TypeProvider::BuiltinFunction function;
+	FunctionType::Kind kind;
+	vector<BuiltinType> parameterTypes;
+	vector<BuiltinType> returnParameterTypes;
+	StateMutability stateMutability;
+	bool arbitraryParameters = false;
+};
+
+/// Solidity++: @returns the signatures of the builtin functions, in the order of TypeProvider::BuiltinFunction.
+array<BuiltinFunctionSignature, TypeProvider::c_numBuiltinFunctions> const& builtinFunctionSignatures()
+{
+	using Builtin = TypeProvider::BuiltinFunction;
+	using Kind = FunctionType::Kind;
+	using T = BuiltinType;
+	static array<BuiltinFunctionSignature, TypeProvider::c_numBuiltinFunctions> const signatures{{
+		{Builtin::AddMod, Kind::AddMod, {T::Uint256, T::Uint256, T::Uint256}, {T::Uint256}, StateMutability::Pure},
+		{Builtin::Assert, Kind::Assert, {T::Bool}, {}, StateMutability::Pure},
+		{Builtin::BlockHash, Kind::BlockHash, {T::Uint256}, {T::Bytes32}, StateMutability::View},
+		{Builtin::ECRecover, Kind::ECRecover, {T::Bytes32, T::Uint8, T::Bytes32, T::Bytes32}, {T::Address}, StateMutability::Pure},
+		{Builtin::GasLeft, Kind::GasLeft, {}, {T::Uint256}, StateMutability::View},
+		{Builtin::Keccak256, Kind::KECCAK256, {T::BytesMemory}, {T::Bytes32}, StateMutability::Pure},
+		{Builtin::MulMod, Kind::MulMod, {T::Uint256, T::Uint256, T::Uint256}, {T::Uint256}, StateMutability::Pure},
+		{Builtin::Require, Kind::Require, {T::Bool}, {}, StateMutability::Pure},
+		{Builtin::RequireWithMessage, Kind::Require, {T::Bool, T::StringMemory}, {}, StateMutability::Pure},
+		{Builtin::Revert, Kind::Revert, {}, {}, StateMutability::Pure},
+		{Builtin::RevertWithMessage, Kind::Revert, {T::StringMemory}, {}, StateMutability::Pure},
+		{Builtin::RIPEMD160, Kind::RIPEMD160, {T::BytesMemory}, {T::Bytes20}, StateMutability::Pure},
+		{Builtin::Selfdestruct, Kind::Selfdestruct, {T::PayableAddress}, {}, StateMutability::NonPayable},
+		{Builtin::SHA256, Kind::SHA256, {T::BytesMemory}, {T::Bytes32}, StateMutability::Pure},
+		// Accepts a MagicType that can be any contract type or an Integer type and returns a
+		// MagicType. The TypeChecker handles the correctness of the input and output types.
+		{Builtin::MetaType, Kind::MetaType, {}, {}, StateMutability::Pure, true},
+		{Builtin::BLAKE2B, Kind::BLAKE2B, {T::BytesMemory}, {T::Bytes32}, StateMutability::Pure},
+		{Builtin::Balance, Kind::Balance, {T::ViteTokenId}, {T::Uint256}, StateMutability::View},
+		{Builtin::Height, Kind::Height, {}, {T::Uint256}, StateMutability::View},
+		{Builtin::AccountHeight, Kind::AccountHeight, {}, {T::Uint64}, StateMutability::View},
+		{Builtin::PrevHash, Kind::PrevHash, {}, {T::Bytes32}, StateMutability::View},
+		{Builtin::FromHash, Kind::FromHash, {}, {T::Bytes32}, StateMutability::NonPayable},
+		{Builtin::Random64, Kind::Random64, {}, {T::Uint64}, StateMutability::View},
+		{Builtin::NextRandom, Kind::NextRandom, {}, {T::Uint64}, StateMutability::View},
+		{Builtin::AddressCall, Kind::BareCall, {T::BytesMemory}, {T::Bool, T::BytesMemory}, StateMutability::Payable},
+		{Builtin::AddressCallCode, Kind::BareCallCode, {T::BytesMemory}, {T::Bool, T::BytesMemory}, StateMutability::Payable},
+		{Builtin::AddressDelegateCall, Kind::BareDelegateCall, {T::BytesMemory}, {T::Bool, T::BytesMemory}, StateMutability::NonPayable},
+		{Builtin::AddressStaticCall, Kind::BareStaticCall, {T::BytesMemory}, {T::Bool, T::BytesMemory}, StateMutability::View},
+		{Builtin::AddressSend, Kind::Send, {T::Uint256}, {T::Bool}, StateMutability::NonPayable},
+		{Builtin::AddressTransfer, Kind::Transfer, {T::ViteTokenId, T::Uint256}, {}, StateMutability::NonPayable},
+	}};
+	return signatures;
+}
+
+Type const* builtinType(BuiltinType _type)
+{
+	switch (_type)
+	{
+	case BuiltinType::Bool: return TypeProvider::boolean();
+	case BuiltinType::Uint8: return TypeProvider::uint(8);
+	case BuiltinType::Uint64: return TypeProvider::uint(64);
+	case BuiltinType::Uint256: return TypeProvider::uint256();
+	case BuiltinType::Bytes20: return TypeProvider::fixedBytes(20);
+	case BuiltinType::Bytes32: return TypeProvider::fixedBytes(32);
+	case BuiltinType::Address: return TypeProvider::address();
+	case BuiltinType::PayableAddress: return TypeProvider::payableAddress();
+	case BuiltinType::BytesMemory: return TypeProvider::bytesMemory();
+	case BuiltinType::StringMemory: return TypeProvider::stringMemory();
+	case BuiltinType::ViteTokenId: return TypeProvider::viteTokenId();
+	}
+	solAssert(false, "");
+}
+
+TypePointers builtinTypes(vector<BuiltinType> const& _types)
+{
+	TypePointers types;
+	for (BuiltinType type: _types)
+		types.push_back(builtinType(type));
+	return types;
+}
+
+}
+
 inline void clearCache(Type const& type)
 {
 	type.clearCache();
@@ -184,11 +276,14 @@ void TypeProvider::reset()
 	clearCaches(instance().m_uintM);
 	clearCaches(instance().m_bytesM);
 	clearCaches(instance().m_magics);
+	clearCaches(m_builtinFunctions);
 
 	instance().m_generalTypes.clear();
 	instance().m_stringLiteralTypes.clear();
 	instance().m_ufixedMxN.clear();
 	instance().m_fixedMxN.clear();
+	lock_guard<mutex> lock(instance().m_identifierIdsMutex);
+	instance().m_identifierIds.clear();
 }
 
 template <typename T, typename... Args>
@@ -308,36 +403,38 @@ TypePointer TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
+	// Solidity++: the lazy types are created under a once flag, because builtinFunction() and
+	// Type::members() may run concurrently.
+	static once_flag created;
+	call_once(created, []() { m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false); });
 	return m_bytesStorage.get();
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
+	static once_flag created;
+	call_once(created, []() { m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false); });
 	return m_bytesMemory.get();
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
+	static once_flag created;
+	call_once(created, []() { m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false); });
 	return m_bytesCalldata.get();
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
+	static once_flag created;
+	call_once(created, []() { m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true); });
 	return m_stringStorage.get();
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
+	static once_flag created;
+	call_once(created, []() { m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true); });
 	return m_stringMemory.get();
 }
 
@@ -576,3 +673,33 @@ MappingType const* TypeProvider::mapping(Type const* _keyType, Type const* _valu
 {
 	return createAndGet<MappingType>(_keyType, _valueType);
 }
+
+size_t TypeProvider::identifierId(string const& _identifier)
+{
+	lock_guard<mutex> lock(instance().m_identifierIdsMutex);
+	auto& identifierIds = instance().m_identifierIds;
+	return identifierIds.emplace(_identifier, identifierIds.size()).first->second;
+}
+
+FunctionType const* TypeProvider::builtinFunction(BuiltinFunction _function)
+{
+	// The whole table is created at once, so that concurrent Type::members() calls can use it.
+	static once_flag created;
+	call_once(created, []() {
+		for (size_t i = 0; i < c_numBuiltinFunctions; ++i)
+		{
+			BuiltinFunctionSignature const& signature = builtinFunctionSignatures().at(i);
+			solAssert(static_cast<size_t>(signature.function) == i, "Builtin function table out of order.");
+			m_builtinFunctions[i] = make_unique<FunctionType>(
+				builtinTypes(signature.parameterTypes),
+				builtinTypes(signature.returnParameterTypes),
+				strings(signature.parameterTypes.size(), ""),
+				strings(signature.returnParameterTypes.size(), ""),
+				signature.kind,
+				signature.arbitraryParameters,
+				signature.stateMutability
+			);
+		}
+	});
+	return m_builtinFunctions.at(static_cast<size_t>(_function)).get();
+}
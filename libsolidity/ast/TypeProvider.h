@@ -13,7 +13,9 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -193,6 +195,26 @@ public:
 
 	static MappingType const* mapping(Type const* _keyType, Type const* _valueType);
 
+	/// Solidity++: builtin functions whose type does not depend on the compiled sources.
+	enum class BuiltinFunction
+	{
+		AddMod, Assert, BlockHash, ECRecover, GasLeft, Keccak256, MulMod,
+		Require, RequireWithMessage, Revert, RevertWithMessage, RIPEMD160, Selfdestruct, SHA256, MetaType,
+		BLAKE2B, Balance, Height, AccountHeight, PrevHash, FromHash, Random64, NextRandom,
+		AddressCall, AddressCallCode, AddressDelegateCall, AddressStaticCall, AddressSend, AddressTransfer
+	};
+	static size_t constexpr c_numBuiltinFunctions = static_cast<size_t>(BuiltinFunction::AddressTransfer) + 1;
+
+	/// Solidity++: @returns the type of the builtin function @a _function. All types are created
+	/// from a static table on the first call and, like the elementary types, survive reset().
+	/// Thread-safe.
+	static FunctionType const* builtinFunction(BuiltinFunction _function);
+
+	/// Solidity++: @returns the interned id of the type identifier @a _identifier.
+	/// Ids are dense, start at zero and are only valid until the next reset().
+	/// Thread-safe, so that passes running concurrently may compare types.
+	static size_t identifierId(std::string const& _identifier);
+
 private:
 	/// Global TypeProvider instance.
 	static TypeProvider& instance()
@@ -225,11 +247,17 @@ private:
 	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
 	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
 	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
+	/// Solidity++: lazy-initialized, because they refer to the string and bytes types.
+	/// Created together under a once flag by builtinFunction().
+	static std::array<std::unique_ptr<FunctionType>, c_numBuiltinFunctions> m_builtinFunctions;
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	/// Solidity++: interned type identifiers, guarded by m_identifierIdsMutex.
+	std::unordered_map<std::string, size_t> m_identifierIds{};
+	std::mutex m_identifierIdsMutex{};
 };
 
 }
@@ -31,8 +31,7 @@
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/copy.hpp>
 
-#include <range/v3/view/enumerate.hpp>
-
+#include <algorithm>
 #include <limits>
 #include <unordered_set>
 #include <utility>
@@ -98,9 +97,15 @@ util::Result<TypePointers> transformParametersToExternal(TypePointers const& _pa
 
 void Type::clearCache() const
 {
-	m_members.clear();
+	{
+		lock_guard<mutex> lock(m_membersMutex);
+		m_members.clear();
+	}
 	m_stackItems.reset();
 	m_stackSize.reset();
+	m_richIdentifier.reset();
+	m_identifier.reset();
+	m_typeId.reset();
 }
 
 void StorageOffsets::computeOffsets(TypePointers const& _types)
@@ -137,6 +142,104 @@ void StorageOffsets::computeOffsets(TypePointers const& _types)
 	swap(m_offsets, offsets);
 }
 
+void StorageOffsets::computePackedOffsets(
+	TypePointers const& _types,
+	vector<bool> const& _movable,
+	vector<size_t> const& _groupSizes
+)
+{
+	solAssert(_types.size() == _movable.size(), "");
+	bigint slotOffset = 0;
+	unsigned byteOffset = 0;
+	map<size_t, pair<u256, unsigned>> offsets;
+	// Used bytes of the slots that can still take small elements.
+	map<bigint, unsigned> usedBytes;
+
+	auto placeNext = [&](size_t _index) {
+		Type const* type = _types[_index];
+		if (byteOffset + type->storageBytes() > 32)
+		{
+			++slotOffset;
+			byteOffset = 0;
+		}
+		solAssert(slotOffset < bigint(1) << 256 ,"Object too large for storage.");
+		offsets[_index] = make_pair(u256(slotOffset), byteOffset);
+		solAssert(type->storageSize() >= 1, "Invalid storage size.");
+		if (type->storageSize() == 1 && byteOffset + type->storageBytes() <= 32)
+		{
+			byteOffset += type->storageBytes();
+			usedBytes[slotOffset] = byteOffset;
+		}
+		else
+		{
+			slotOffset += type->storageSize();
+			byteOffset = 0;
+		}
+	};
+
+	size_t begin = 0;
+	for (size_t groupSize: _groupSizes)
+	{
+		size_t end = begin + groupSize;
+		solAssert(end <= _types.size(), "");
+		auto before = make_tuple(slotOffset, byteOffset, offsets, usedBytes);
+
+		vector<size_t> movable;
+		for (size_t i = begin; i < end; ++i)
+		{
+			Type const* type = _types[i];
+			if (!type->canBeStored())
+				continue;
+			if (_movable[i] && type->storageSize() == 1 && type->storageBytes() < 32)
+				movable.push_back(i);
+			else
+				placeNext(i);
+		}
+		if (movable.empty())
+		{
+			begin = end;
+			continue;
+		}
+
+		stable_sort(movable.begin(), movable.end(), [&](size_t _a, size_t _b) {
+			return _types[_a]->storageBytes() > _types[_b]->storageBytes();
+		});
+		for (size_t i: movable)
+		{
+			unsigned bytes = _types[i]->storageBytes();
+			auto slot = find_if(usedBytes.begin(), usedBytes.end(), [&](auto const& _slot) {
+				return _slot.second + bytes <= 32;
+			});
+			if (slot == usedBytes.end())
+				placeNext(i);
+			else
+			{
+				offsets[i] = make_pair(u256(slot->first), slot->second);
+				slot->second += bytes;
+				if (slot->first == slotOffset)
+					byteOffset = slot->second;
+			}
+		}
+
+		// Keep the declaration order unless reordering ends the group earlier.
+		auto packed = make_tuple(slotOffset, byteOffset, offsets, usedBytes);
+		tie(slotOffset, byteOffset, offsets, usedBytes) = before;
+		for (size_t i = begin; i < end; ++i)
+			if (_types[i]->canBeStored())
+				placeNext(i);
+		if (make_pair(get<0>(packed), get<1>(packed)) < make_pair(slotOffset, byteOffset))
+			tie(slotOffset, byteOffset, offsets, usedBytes) = move(packed);
+		begin = end;
+	}
+	solAssert(begin == _types.size(), "");
+
+	if (byteOffset > 0)
+		++slotOffset;
+	solAssert(slotOffset < bigint(1) << 256, "Object too large for storage.");
+	m_storageSize = u256(slotOffset);
+	swap(m_offsets, offsets);
+}
+
 pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 {
 	if (m_offsets.count(_index))
@@ -148,16 +251,50 @@ pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	indexMembers();
+}
+
+TypePointer MemberList::memberType(string const& _name) const
+{
+	auto it = m_firstMemberByName.find(_name);
+	if (it == m_firstMemberByName.end())
+		return nullptr;
+	solAssert(m_nextMemberWithSameName[it->second] == m_memberTypes.size(), "Requested member type by non-unique name.");
+	return m_memberTypes[it->second].type;
+}
+
+MemberList::MemberMap MemberList::membersByName(string const& _name) const
+{
+	MemberMap members;
+	auto it = m_firstMemberByName.find(_name);
+	if (it != m_firstMemberByName.end())
+		for (size_t index = it->second; index < m_memberTypes.size(); index = m_nextMemberWithSameName[index])
+			members.push_back(m_memberTypes[index]);
+	return members;
 }
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
-	StorageOffsets const& offsets = storageOffsets();
+	auto it = m_firstMemberByName.find(_name);
+	if (it == m_firstMemberByName.end())
+		return nullptr;
+	return storageOffsets().offset(it->second);
+}
 
-	for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
-		if (member.name == _name)
-			return offsets.offset(index);
-	return nullptr;
+void MemberList::indexMembers()
+{
+	m_firstMemberByName.clear();
+	m_firstMemberByName.reserve(m_memberTypes.size());
+	m_nextMemberWithSameName.assign(m_memberTypes.size(), m_memberTypes.size());
+	for (size_t index = m_memberTypes.size(); index-- > 0;)
+	{
+		auto [it, inserted] = m_firstMemberByName.try_emplace(m_memberTypes[index].name, index);
+		if (!inserted)
+		{
+			m_nextMemberWithSameName[index] = it->second;
+			it->second = index;
+		}
+	}
 }
 
 u256 const& MemberList::storageSize() const
@@ -194,9 +331,10 @@ string identifierList(Range const&& _list)
 	return parenthesizeIdentifier(boost::algorithm::join(_list, ","));
 }
 
-string richIdentifier(Type const* _type)
+string const& richIdentifier(Type const* _type)
 {
-	return _type ? _type->richIdentifier() : "";
+	static string const empty;
+	return _type ? _type->cachedRichIdentifier() : empty;
 }
 
 string identifierList(vector<TypePointer> const& _list)
@@ -226,24 +364,50 @@ string parenthesizeUserIdentifier(string const& _internal)
 
 string Type::escapeIdentifier(string const& _identifier)
 {
-	string ret = _identifier;
-	// FIXME: should be _$$$_
-	boost::algorithm::replace_all(ret, "$", "$$$");
-	boost::algorithm::replace_all(ret, ",", "_$_");
-	boost::algorithm::replace_all(ret, "(", "$_");
-	boost::algorithm::replace_all(ret, ")", "_$");
+	// Solidity++: single pass, equivalent to replacing "$", ",", "(" and ")" one after the other.
+	string ret;
+	ret.reserve(_identifier.size() + _identifier.size() / 4);
+	for (char c: _identifier)
+		switch (c)
+		{
+		// FIXME: should be _$$$_
+		case '$': ret += "$$$"; break;
+		case ',': ret += "_$_"; break;
+		case '(': ret += "$_"; break;
+		case ')': ret += "_$"; break;
+		default: ret += c;
+		}
 	return ret;
 }
 
-string Type::identifier() const
+string const& Type::cachedRichIdentifier() const
 {
-	string ret = escapeIdentifier(richIdentifier());
-	solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
-	solAssert(
-		ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
-		"Identifier contains invalid characters."
-	);
-	return ret;
+	if (!m_richIdentifier)
+		m_richIdentifier = richIdentifier();
+	return *m_richIdentifier;
+}
+
+string const& Type::identifier() const
+{
+	if (!m_identifier)
+	{
+		string ret = escapeIdentifier(cachedRichIdentifier());
+		solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
+		solAssert(
+			ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
+			"Identifier contains invalid characters."
+		);
+		m_typeId = TypeProvider::identifierId(ret);
+		m_identifier = move(ret);
+	}
+	return *m_identifier;
+}
+
+size_t Type::typeId() const
+{
+	if (!m_typeId)
+		identifier();
+	return *m_typeId;
 }
 
 TypePointer Type::commonType(Type const* _a, Type const* _b)
@@ -260,19 +424,39 @@ TypePointer Type::commonType(Type const* _a, Type const* _b)
 
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
-	if (!m_members[_currentScope])
 	{
-		solAssert(
-			_currentScope == nullptr ||
-			dynamic_cast<SourceUnit const*>(_currentScope) ||
-			dynamic_cast<ContractDefinition const*>(_currentScope),
-		"");
+		lock_guard<mutex> lock(m_membersMutex);
+		if (auto it = m_members.find(_currentScope); it != m_members.end())
+			return *it->second;
+	}
+
+	solAssert(
+		_currentScope == nullptr ||
+		dynamic_cast<SourceUnit const*>(_currentScope) ||
+		dynamic_cast<ContractDefinition const*>(_currentScope),
+	"");
+	// Solidity++: The list is built without holding the lock, because native members can
+	// query the members of other types.
+	MemberList::MemberMap boundMembers;
+	if (_currentScope)
+		boundMembers = boundFunctions(*this, *_currentScope);
+	shared_ptr<MemberList const> list;
+	if (_currentScope && boundMembers.empty() && !nativeMembersDependOnScope())
+	{
+		members(nullptr);
+		lock_guard<mutex> lock(m_membersMutex);
+		list = m_members.at(nullptr);
+	}
+	else
+	{
 		MemberList::MemberMap members = nativeMembers(_currentScope);
-		if (_currentScope)
-			members += boundFunctions(*this, *_currentScope);
-		m_members[_currentScope] = make_unique<MemberList>(move(members));
+		members += move(boundMembers);
+		list = make_shared<MemberList const>(move(members));
 	}
-	return *m_members[_currentScope];
+
+	lock_guard<mutex> lock(m_membersMutex);
+	// If another thread was faster, its list is kept and ours dropped.
+	return *m_members.emplace(_currentScope, move(list)).first->second;
 }
 
 TypePointer Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) const
@@ -416,7 +600,8 @@ u256 AddressType::literalValue(Literal const* _literal) const
 	solAssert(_literal, "");
 	solAssert(_literal->value().substr(0, 5) == "vite_", "Vite address must begin with vite_");
 
-	return u256(_literal->getViteAddressHex());
+	solAssert(_literal->viteAddress(), "Invalid vite address literal.");
+	return u256(util::h168::Arith(*_literal->viteAddress()));
 }
 
 TypeResult AddressType::unaryOperatorResult(Token _operator) const
@@ -447,18 +632,18 @@ MemberList::MemberMap AddressType::nativeMembers(ASTNode const*) const
 		{"balance", TypeProvider::uint256()},
 		{"code", TypeProvider::array(DataLocation::Memory)},
 		{"codehash",  TypeProvider::fixedBytes(32)},
-		{"call", TypeProvider::function(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCall, false, StateMutability::Payable)},
-		{"callcode", TypeProvider::function(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCallCode, false, StateMutability::Payable)},
-		{"delegatecall", TypeProvider::function(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareDelegateCall, false, StateMutability::NonPayable)},
-		{"staticcall", TypeProvider::function(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareStaticCall, false, StateMutability::View)}
+		{"call", TypeProvider::builtinFunction(TypeProvider::BuiltinFunction::AddressCall)},
+		{"callcode", TypeProvider::builtinFunction(TypeProvider::BuiltinFunction::AddressCallCode)},
+		{"delegatecall", TypeProvider::builtinFunction(TypeProvider::BuiltinFunction::AddressDelegateCall)},
+		{"staticcall", TypeProvider::builtinFunction(TypeProvider::BuiltinFunction::AddressStaticCall)}
 	};
 	if (m_stateMutability == StateMutability::Payable)
 	{
 		// Solidity++: redefine address.send()
-		members.emplace_back(MemberList::Member{"send", TypeProvider::function(strings{"uint"}, strings{"bool"}, FunctionType::Kind::Send, false, StateMutability::NonPayable)});
+		members.emplace_back(MemberList::Member{"send", TypeProvider::builtinFunction(TypeProvider::BuiltinFunction::AddressSend)});
 		// members.emplace_back(MemberList::Member{"send", TypeProvider::function(strings{"message"}, strings{}, FunctionType::Kind::Send, false, StateMutability::Payable)});
         // Solidity++: redefine address.transfer()
-		members.emplace_back(MemberList::Member{"transfer", TypeProvider::function(strings{"vitetoken", "uint"}, strings(), FunctionType::Kind::Transfer, false, StateMutability::NonPayable)});
+		members.emplace_back(MemberList::Member{"transfer", TypeProvider::builtinFunction(TypeProvider::BuiltinFunction::AddressTransfer)});
 	}
 	return members;
 }
@@ -479,7 +664,8 @@ u256 ViteTokenIdType::literalValue(Literal const* _literal) const
 	solAssert(_literal, "");
 	solAssert(_literal->value().substr(0, 4) == "tti_", "Vite Token Id must begin with tti_");
 
-	return u256(_literal->getViteTokenIdHex());
+	solAssert(_literal->viteTokenId(), "Invalid vite token id literal.");
+	return u256(util::h80::Arith(*_literal->viteTokenId()));
 }
 
 namespace
@@ -1431,15 +1617,12 @@ TypeResult ContractType::unaryOperatorResult(Token _operator) const
 vector<Type const*> CompositeType::fullDecomposition() const
 {
 	vector<Type const*> res = {this};
-	unordered_set<string> seen = {richIdentifier()};
+	unordered_set<size_t> seen = {typeId()};
 	for (size_t k = 0; k < res.size(); ++k)
 		if (auto composite = dynamic_cast<CompositeType const*>(res[k]))
 			for (Type const* next: composite->decomposition())
-				if (seen.count(next->richIdentifier()) == 0)
-				{
-					seen.insert(next->richIdentifier());
+				if (seen.insert(next->typeId()).second)
 					res.push_back(next);
-				}
 	return res;
 }
 
@@ -1609,17 +1792,9 @@ bool ArrayType::operator==(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
-	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
-	if (
-		!ReferenceType::operator==(other) ||
-		other.isByteArray() != isByteArray() ||
-		other.isString() != isString() ||
-		other.isDynamicallySized() != isDynamicallySized()
-	)
-		return false;
-	if (*other.baseType() != *baseType())
-		return false;
-	return isDynamicallySized() || length() == other.length();
+	// Solidity++: the identifier covers the location, the kind of array, the base type and
+	// the length, so the interned ids are compared instead of the structure.
+	return equalTypeIds(_other);
 }
 
 BoolResult ArrayType::validForLocation(DataLocation _loc) const
@@ -1933,7 +2108,7 @@ BoolResult ArraySliceType::isImplicitlyConvertibleTo(Type const& _other) const
 
 string ArraySliceType::richIdentifier() const
 {
-	return m_arrayType.richIdentifier() + "_slice";
+	return m_arrayType.cachedRichIdentifier() + "_slice";
 }
 
 bool ArraySliceType::operator==(Type const& _other) const
@@ -1997,7 +2172,7 @@ MemberList::MemberMap ContractType::nativeMembers(ASTNode const*) const
 	MemberList::MemberMap members;
 	solAssert(!m_super, "");
 	if (!m_contract.isLibrary())
-		for (auto const& it: m_contract.interfaceFunctions())
+		for (auto const& it: m_contract.interfaceFunctionTable())
 			members.emplace_back(
 				it.second->declaration().name(),
 				it.second->asExternallyCallableFunction(m_contract.isLibrary()),
@@ -2017,15 +2192,7 @@ FunctionType const* ContractType::newExpressionType() const
 vector<tuple<VariableDeclaration const*, u256, unsigned>> ContractType::stateVariables() const
 {
 	vector<VariableDeclaration const*> variables;
-	for (ContractDefinition const* contract: boost::adaptors::reverse(m_contract.annotation().linearizedBaseContracts))
-		for (VariableDeclaration const* variable: contract->stateVariables())
-			if (!(variable->isConstant() || variable->immutable()))
-				variables.push_back(variable);
-	TypePointers types;
-	for (auto variable: variables)
-		types.push_back(variable->annotation().type);
-	StorageOffsets offsets;
-	offsets.computeOffsets(types);
+	StorageOffsets offsets = stateVariableOffsets(variables, false);
 
 	vector<tuple<VariableDeclaration const*, u256, unsigned>> variablesAndOffsets;
 	for (size_t index = 0; index < variables.size(); ++index)
@@ -2034,6 +2201,46 @@ vector<tuple<VariableDeclaration const*, u256, unsigned>> ContractType::stateVar
 	return variablesAndOffsets;
 }
 
+u256 ContractType::storageSlots(bool _declarationOrder) const
+{
+	vector<VariableDeclaration const*> variables;
+	return stateVariableOffsets(variables, _declarationOrder).storageSize();
+}
+
+bool ContractType::hasPackedStorage() const
+{
+	for (ContractDefinition const* contract: m_contract.annotation().linearizedBaseContracts)
+		if (contract->sourceUnit().annotation().packedStorage)
+			return true;
+	return false;
+}
+
+StorageOffsets ContractType::stateVariableOffsets(vector<VariableDeclaration const*>& _variables, bool _declarationOrder) const
+{
+	// Solidity++: each contract of the hierarchy forms its own group, so that the layout
+	// of a base contract stays a prefix of the layout of the derived contract.
+	TypePointers types;
+	vector<bool> movable;
+	vector<size_t> groupSizes;
+	for (ContractDefinition const* contract: boost::adaptors::reverse(m_contract.annotation().linearizedBaseContracts))
+	{
+		bool packed = !_declarationOrder && contract->sourceUnit().annotation().packedStorage;
+		size_t groupSize = 0;
+		for (VariableDeclaration const* variable: contract->stateVariables())
+			if (!(variable->isConstant() || variable->immutable()))
+			{
+				_variables.push_back(variable);
+				types.push_back(variable->annotation().type);
+				movable.push_back(packed && variable->visibility() != Visibility::Public);
+				++groupSize;
+			}
+		groupSizes.push_back(groupSize);
+	}
+	StorageOffsets offsets;
+	offsets.computePackedOffsets(types, movable, groupSizes);
+	return offsets;
+}
+
 vector<VariableDeclaration const*> ContractType::immutableVariables() const
 {
 	vector<VariableDeclaration const*> variables;
@@ -2919,12 +3126,9 @@ bool FunctionType::operator==(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
-	FunctionType const& other = dynamic_cast<FunctionType const&>(_other);
-	if (!equalExcludingStateMutability(other))
-		return false;
-	if (m_stateMutability != other.stateMutability())
-		return false;
-	return true;
+	// Solidity++: the identifier covers everything equalExcludingStateMutability() compares
+	// and the state mutability.
+	return equalTypeIds(_other);
 }
 
 BoolResult FunctionType::isExplicitlyConvertibleTo(Type const& _convertTo) const
@@ -3625,8 +3829,8 @@ bool MappingType::operator==(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
-	MappingType const& other = dynamic_cast<MappingType const&>(_other);
-	return *other.m_keyType == *m_keyType && *other.m_valueType == *m_valueType;
+	// Solidity++: the identifier is built from the key and value types.
+	return equalTypeIds(_other);
 }
 
 string MappingType::toString(bool _short) const
@@ -3864,7 +4068,7 @@ string MagicType::richIdentifier() const
 		return "t_magic_abi";
 	case Kind::MetaType:
 		solAssert(m_typeArgument, "");
-		return "t_magic_meta_type_" + m_typeArgument->richIdentifier();
+		return "t_magic_meta_type_" + m_typeArgument->cachedRichIdentifier();
 	}
 	return "";
 }
@@ -3885,7 +4089,7 @@ MemberList::MemberMap MagicType::nativeMembers(ASTNode const*) const
 		return MemberList::MemberMap({
 			{"coinbase", TypeProvider::payableAddress()},
 			{"timestamp", TypeProvider::uint256()},
-			{"blockhash", TypeProvider::function(strings{"uint"}, strings{"bytes32"}, FunctionType::Kind::BlockHash, false, StateMutability::View)},
+			{"blockhash", TypeProvider::builtinFunction(TypeProvider::BuiltinFunction::BlockHash)},
 			{"difficulty", TypeProvider::uint256()},
 			{"number", TypeProvider::uint256()},
 			{"gaslimit", TypeProvider::uint256()},
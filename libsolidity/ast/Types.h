@@ -22,9 +22,12 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -67,6 +70,12 @@ public:
 	/// Resets the StorageOffsets objects and determines the position in storage for each
 	/// of the elements of @a _types.
 	void computeOffsets(TypePointers const& _types);
+	/// Solidity++: Like computeOffsets, but processes the elements in consecutive groups of
+	/// @a _groupSizes elements. Inside a group, the single-slot elements of less than 32 bytes with
+	/// @a _movable set are placed last, largest first, each into the first slot with enough free bytes.
+	/// A group keeps the declaration order if reordering does not make it end earlier.
+	/// The positions of the elements of a group only depend on the groups before it.
+	void computePackedOffsets(TypePointers const& _types, std::vector<bool> const& _movable, std::vector<size_t> const& _groupSizes);
 	/// @returns the offset of the given member, might be null if the member is not part of storage.
 	std::pair<u256, unsigned> const* offset(size_t _index) const;
 	/// @returns the total number of slots occupied by all members.
@@ -99,28 +108,15 @@ public:
 
 	using MemberMap = std::vector<Member>;
 
-	explicit MemberList(MemberMap _members): m_memberTypes(std::move(_members)) {}
+	explicit MemberList(MemberMap _members): m_memberTypes(std::move(_members)) { indexMembers(); }
+	/// Solidity++: The name index refers to the names in m_memberTypes.
+	MemberList(MemberList const&) = delete;
+	MemberList(MemberList&&) = default;
+	MemberList& operator=(MemberList const&) = delete;
 
 	void combine(MemberList const& _other);
-	TypePointer memberType(std::string const& _name) const
-	{
-		TypePointer type = nullptr;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
-		return type;
-	}
-	MemberMap membersByName(std::string const& _name) const
-	{
-		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
-		return members;
-	}
+	TypePointer memberType(std::string const& _name) const;
+	MemberMap membersByName(std::string const& _name) const;
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
 	/// a nullptr if the member is not part of storage.
 	std::pair<u256, unsigned> const* memberStorageOffset(std::string const& _name) const;
@@ -133,7 +129,14 @@ public:
 private:
 	StorageOffsets const& storageOffsets() const;
 
+	/// Solidity++: Rebuilds m_firstMemberByName and m_nextMemberWithSameName.
+	void indexMembers();
+
 	MemberMap m_memberTypes;
+	/// Solidity++: Index of the first member of every name, the others with the same name are
+	/// chained in declaration order through m_nextMemberWithSameName.
+	std::unordered_map<std::string_view, size_t> m_firstMemberByName;
+	std::vector<size_t> m_nextMemberWithSameName;
 	util::LazyInit<StorageOffsets> m_storageOffsets;
 };
 
@@ -171,11 +174,18 @@ public:
 	/// The identifier should start with "t_".
 	/// Can contain characters which are invalid in identifiers.
 	virtual std::string richIdentifier() const = 0;
+	/// Solidity++: @returns richIdentifier(), computed once per type instance. The identifiers
+	/// of composite types are built from the cached identifiers of their components.
+	std::string const& cachedRichIdentifier() const;
 	/// @returns a valid solidity identifier such that two types should compare equal if and
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Will not contain any character which would be invalid as an identifier.
-	std::string identifier() const;
+	/// Solidity++: computed once per type instance.
+	std::string const& identifier() const;
+	/// Solidity++: @returns a compact id that is equal for two types if and only if they have
+	/// the same identifier, suitable as a map key. Only valid until TypeProvider::reset().
+	size_t typeId() const;
 
 	/// More complex identifier strings use "parentheses", where $_ is interpreted as
 	/// "opening parenthesis", _$ as "closing parenthesis", _$_ as "comma" and any $ that
@@ -372,6 +382,9 @@ protected:
 	{
 		return MemberList::MemberMap();
 	}
+	/// Solidity++: @returns true if nativeMembers can depend on the scope. Otherwise all scopes
+	/// without applicable `using for` directives share the member list of the null scope.
+	virtual bool nativeMembersDependOnScope() const { return false; }
 	/// Generates the stack items to be returned by ``stackItems()``. Defaults
 	/// to exactly one unnamed and untyped stack item referring to a single stack slot.
 	virtual std::vector<std::tuple<std::string, TypePointer>> makeStackItems() const
@@ -381,9 +394,25 @@ protected:
 
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
-	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
+	/// Solidity++: Lists are shared between scopes and never replaced before clearCache, so
+	/// references returned by members() stay valid. Guarded by m_membersMutex.
+	mutable std::unordered_map<ASTNode const*, std::shared_ptr<MemberList const>> m_members;
+	mutable std::mutex m_membersMutex;
 	mutable std::optional<std::vector<std::tuple<std::string, TypePointer>>> m_stackItems;
 	mutable std::optional<size_t> m_stackSize;
+
+	/// Solidity++: @returns true if both types have the same identifier, computing the type ids
+	/// if they are not known yet. Only used by types whose identifier covers everything their
+	/// operator== compares.
+	bool equalTypeIds(Type const& _other) const { return typeId() == _other.typeId(); }
+
+private:
+	/// Solidity++: cached results of richIdentifier() and identifier() and the interned id.
+	/// Like the other caches, they are not guarded and are filled under the type system lock
+	/// of the compiler stack.
+	mutable std::optional<std::string> m_richIdentifier;
+	mutable std::optional<std::string> m_identifier;
+	mutable std::optional<size_t> m_typeId;
 };
 
 /**
@@ -972,12 +1001,22 @@ public:
 
 	/// @returns a list of all state variables (including inherited) of the contract and their
 	/// offsets in storage.
+	/// Solidity++: non-public variables of contracts in a source unit with "pragma storagelayout packed"
+	/// are reordered within their contract to use fewer slots.
 	std::vector<std::tuple<VariableDeclaration const*, u256, unsigned>> stateVariables() const;
+	/// Solidity++: @returns the number of storage slots used by the state variables, with the layout
+	/// of stateVariables() or, if @a _declarationOrder is true, with all variables in declaration order.
+	u256 storageSlots(bool _declarationOrder = false) const;
+	/// Solidity++: @returns true if the layout of any contract in the hierarchy is packed.
+	bool hasPackedStorage() const;
 	/// @returns a list of all immutable variables (including inherited) of the contract.
 	std::vector<VariableDeclaration const*> immutableVariables() const;
 protected:
 	std::vector<std::tuple<std::string, TypePointer>> makeStackItems() const override;
 private:
+	/// Solidity++: computes the storage offsets of the state variables, which are appended to @a _variables.
+	StorageOffsets stateVariableOffsets(std::vector<VariableDeclaration const*>& _variables, bool _declarationOrder) const;
+
 	ContractDefinition const& m_contract;
 	/// If true, this is a special "super" type of m_contract containing only members that m_contract inherited
 	bool m_super = false;
@@ -1295,6 +1334,7 @@ public:
 	bool nameable() const override;
 	bool hasSimpleZeroValueInMemory() const override { return false; }
 	MemberList::MemberMap nativeMembers(ASTNode const* _currentScope) const override;
+	bool nativeMembersDependOnScope() const override { return true; }
 	TypePointer encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override;
 	TypePointer mobileType() const override;
@@ -1471,6 +1511,7 @@ public:
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
 	std::string toString(bool _short) const override { return "type(" + m_actualType->toString(_short) + ")"; }
 	MemberList::MemberMap nativeMembers(ASTNode const* _currentScope) const override;
+	bool nativeMembersDependOnScope() const override { return true; }
 
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 protected:
@@ -9,7 +9,7 @@
 
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolutil/CommonData.h>
-#include <libsolutil/Whiskers.h>
+#include <libsolutil/CompiledWhiskers.h>
 #include <libsolutil/StringUtils.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -42,17 +42,23 @@ string ABIFunctions::tupleEncoder(
 
 	string functionName = string("abi_encode_tuple_");
 	for (auto const& t: _givenTypes)
-		functionName += t->identifier() + "_";
+	{
+		functionName += t->identifier();
+		functionName += '_';
+	}
 	functionName += "_to_";
 	for (auto const& t: _targetTypes)
-		functionName += t->identifier() + "_";
+	{
+		functionName += t->identifier();
+		functionName += '_';
+	}
 	functionName += options.toFunctionNameSuffix();
 	if (_reversed)
 		functionName += "_reversed";
 
 	return createFunction(functionName, [&]() {
 		// Note that the values are in reverse due to the difference in calling semantics.
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(headStart <valueParams>) -> tail {
 				tail := add(headStart, <headSize>)
 				<encodeElements>
@@ -70,21 +76,20 @@ string ABIFunctions::tupleEncoder(
 			solAssert(_targetTypes[i], "");
 			size_t sizeOnStack = _givenTypes[i]->sizeOnStack();
 			bool dynamic = _targetTypes[i]->isDynamicallyEncoded();
-			Whiskers elementTempl(
+			CompiledWhiskers elementTempl =
 				dynamic ?
-				string(R"(
+				CompiledWhiskers(R"(
 					mstore(add(headStart, <pos>), sub(tail, headStart))
 					tail := <abiEncode>(<values> tail)
 				)") :
-				string(R"(
+				CompiledWhiskers(R"(
 					<abiEncode>(<values> add(headStart, <pos>))
-				)")
-			);
+				)");
 			string values = suffixedVariableNameList("value", stackPos, stackPos + sizeOnStack);
 			elementTempl("values", values.empty() ? "" : values + ", ");
 			elementTempl("pos", to_string(headPos));
 			elementTempl("abiEncode", abiEncodingFunction(*_givenTypes[i], *_targetTypes[i], options));
-			encodeElements += elementTempl.render();
+			elementTempl.render(encodeElements);
 			headPos += _targetTypes[i]->calldataHeadSize();
 			stackPos += sizeOnStack;
 		}
@@ -121,17 +126,23 @@ string ABIFunctions::tupleEncoderPacked(
 
 	string functionName = string("abi_encode_tuple_packed_");
 	for (auto const& t: _givenTypes)
-		functionName += t->identifier() + "_";
+	{
+		functionName += t->identifier();
+		functionName += '_';
+	}
 	functionName += "_to_";
 	for (auto const& t: _targetTypes)
-		functionName += t->identifier() + "_";
+	{
+		functionName += t->identifier();
+		functionName += '_';
+	}
 	functionName += options.toFunctionNameSuffix();
 	if (_reversed)
 		functionName += "_reversed";
 
 	return createFunction(functionName, [&]() {
 		// Note that the values are in reverse due to the difference in calling semantics.
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(pos <valueParams>) -> end {
 				<encodeElements>
 				end := pos
@@ -146,22 +157,21 @@ string ABIFunctions::tupleEncoderPacked(
 			solAssert(_targetTypes[i], "");
 			size_t sizeOnStack = _givenTypes[i]->sizeOnStack();
 			bool dynamic = _targetTypes[i]->isDynamicallyEncoded();
-			Whiskers elementTempl(
+			CompiledWhiskers elementTempl =
 				dynamic ?
-				string(R"(
+				CompiledWhiskers(R"(
 					pos := <abiEncode>(<values> pos)
 				)") :
-				string(R"(
+				CompiledWhiskers(R"(
 					<abiEncode>(<values> pos)
 					pos := add(pos, <calldataEncodedSize>)
-				)")
-			);
+				)");
 			string values = suffixedVariableNameList("value", stackPos, stackPos + sizeOnStack);
 			elementTempl("values", values.empty() ? "" : values + ", ");
 			if (!dynamic)
 				elementTempl("calldataEncodedSize", to_string(_targetTypes[i]->calldataEncodedSize(false)));
 			elementTempl("abiEncode", abiEncodingFunction(*_givenTypes[i], *_targetTypes[i], options));
-			encodeElements += elementTempl.render();
+			elementTempl.render(encodeElements);
 			stackPos += sizeOnStack;
 		}
 		string valueParams =
@@ -187,7 +197,7 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 		for (auto const& t: _types)
 			decodingTypes.emplace_back(t->decodingType());
 
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(headStart, dataEnd) <arrow> <valueReturnParams> {
 				if slt(sub(dataEnd, headStart), <minimumSize>) { <revertString> }
 				<decodeElements>
@@ -215,7 +225,7 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 				valueReturnParams.emplace_back("value" + to_string(stackPos));
 				stackPos++;
 			}
-			Whiskers elementTempl(R"(
+			CompiledWhiskers elementTempl(R"(
 				{
 					<?dynamic>
 						let offset := <load>(add(headStart, <pos>))
@@ -233,7 +243,7 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 			elementTempl("values", boost::algorithm::join(valueNamesLocal, ", "));
 			elementTempl("pos", to_string(headPos));
 			elementTempl("abiDecode", abiDecodingFunction(*_types[i], _fromMemory, true));
-			decodeElements += elementTempl.render();
+			elementTempl.render(decodeElements);
 			headPos += decodingTypes[i]->calldataHeadSize();
 		}
 		templ("valueReturnParams", boost::algorithm::join(valueReturnParams, ", "));
@@ -342,7 +352,7 @@ string ABIFunctions::abiEncodingFunction(
 	return createFunction(functionName, [&]() {
 		solAssert(!to.isDynamicallyEncoded(), "");
 
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value, pos) {
 				mstore(pos, <cleanupConvert>)
 			}
@@ -391,7 +401,7 @@ string ABIFunctions::abiEncodeAndReturnUpdatedPosFunction(
 		Type const* targetEncoding = _targetType.fullEncodingType(_options.encodeAsLibraryTypes, true, false);
 		solAssert(targetEncoding, "");
 		if (targetEncoding->isDynamicallyEncoded())
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(<values>, pos) -> updatedPos {
 					updatedPos := <encode>(<values>, pos)
 				}
@@ -404,7 +414,7 @@ string ABIFunctions::abiEncodeAndReturnUpdatedPosFunction(
 		{
 			unsigned encodedSize = targetEncoding->calldataEncodedSize(_options.padded);
 			solAssert(encodedSize != 0, "Invalid encoded size.");
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(<values>, pos) -> updatedPos {
 					<encode>(<values>, pos)
 					updatedPos := add(pos, <encodedSize>)
@@ -455,7 +465,7 @@ string ABIFunctions::abiEncodingFunctionCalldataArrayWithoutCleanup(
 		bool needsPadding = _options.padded && fromArrayType.isByteArray();
 		if (fromArrayType.isDynamicallySized())
 		{
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				// <readableTypeNameFrom> -> <readableTypeNameTo>
 				function <functionName>(start, length, pos) -> end {
 					pos := <storeLength>(pos, length)
@@ -470,7 +480,7 @@ string ABIFunctions::abiEncodingFunctionCalldataArrayWithoutCleanup(
 				templ("scaleLengthByStride", "");
 			else
 				templ("scaleLengthByStride",
-					Whiskers(R"(
+					CompiledWhiskers(R"(
 						if gt(length, <maxLength>) { <revertString> }
 						length := mul(length, <stride>)
 					)")
@@ -489,7 +499,7 @@ string ABIFunctions::abiEncodingFunctionCalldataArrayWithoutCleanup(
 		else
 		{
 			solAssert(fromArrayType.calldataStride() == 32, "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				// <readableTypeNameFrom> -> <readableTypeNameTo>
 				function <functionName>(start, pos) {
 					<copyFun>(start, pos, <byteLength>)
@@ -532,7 +542,7 @@ string ABIFunctions::abiEncodingFunctionSimpleArray(
 		subOptions.encodeFunctionFromStack = false;
 		subOptions.padded = true;
 		string elementValues = suffixedVariableNameList("elementValue", 0, numVariablesForType(*_from.baseType(), subOptions));
-		Whiskers templ(
+		CompiledWhiskers templ(
 			usesTail ?
 			R"(
 				// <readableTypeNameFrom> -> <readableTypeNameTo>
@@ -635,7 +645,7 @@ string ABIFunctions::abiEncodingFunctionMemoryByteArray(
 
 	return createFunction(functionName, [&]() {
 		solAssert(_to.isByteArray(), "");
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value, pos) -> end {
 				let length := <lengthFun>(value)
 				pos := <storeLength>(pos, length)
@@ -673,7 +683,7 @@ string ABIFunctions::abiEncodingFunctionCompactStorageArray(
 		if (_from.isByteArray())
 		{
 			solAssert(_to.isByteArray(), "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				// <readableTypeNameFrom> -> <readableTypeNameTo>
 				function <functionName>(value, pos) -> ret {
 					let slotValue := sload(value)
@@ -720,7 +730,7 @@ string ABIFunctions::abiEncodingFunctionCompactStorageArray(
 			solAssert(itemsPerSlot > 0, "");
 			// The number of elements we need to handle manually after the loop.
 			size_t spill = static_cast<size_t>(_from.length() % itemsPerSlot);
-			Whiskers templ(
+			CompiledWhiskers templ(
 				R"(
 					// <readableTypeNameFrom> -> <readableTypeNameTo>
 					function <functionName>(value, pos) <return> {
@@ -820,7 +830,7 @@ string ABIFunctions::abiEncodingFunctionStruct(
 
 	return createFunction(functionName, [&]() {
 		bool dynamic = _to.isDynamicallyEncoded();
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			// <readableTypeNameFrom> -> <readableTypeNameTo>
 			function <functionName>(value, pos) <return> {
 				let tail := add(pos, <headSize>)
@@ -917,20 +927,19 @@ string ABIFunctions::abiEncodingFunctionStruct(
 
 			string encode;
 			if (_options.dynamicInplace)
-				encode = Whiskers{"pos := <encode>(<memberValues>, pos)"}
+				encode = CompiledWhiskers{"pos := <encode>(<memberValues>, pos)"}
 					("encode", abiEncodeAndReturnUpdatedPosFunction(*memberTypeFrom, *memberTypeTo, subOptions))
 					("memberValues", memberValues)
 					.render();
 			else
 			{
-				Whiskers encodeTempl(
+				CompiledWhiskers encodeTempl =
 					dynamicMember ?
-					string(R"(
+					CompiledWhiskers(R"(
 						mstore(add(pos, <encodingOffset>), sub(tail, pos))
 						tail := <abiEncode>(<memberValues>, tail)
 					)") :
-					"<abiEncode>(<memberValues>, add(pos, <encodingOffset>))"
-				);
+					CompiledWhiskers("<abiEncode>(<memberValues>, add(pos, <encodingOffset>))");
 				encodeTempl("memberValues", memberValues);
 				encodeTempl("encodingOffset", toCompactHexWithPrefix(encodingOffset));
 				encodingOffset += memberTypeTo->calldataHeadSize();
@@ -971,7 +980,7 @@ string ABIFunctions::abiEncodingFunctionStringLiteral(
 		if (_to.isDynamicallySized())
 		{
 			solAssert(_to.category() == Type::Category::Array, "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>(pos) -> end {
 					pos := <storeLength>(pos, <length>)
 					<storeLiteralInMemory>(pos)
@@ -994,7 +1003,7 @@ string ABIFunctions::abiEncodingFunctionStringLiteral(
 		{
 			solAssert(_to.category() == Type::Category::FixedBytes, "");
 			solAssert(value.size() <= 32, "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>(pos) {
 					mstore(pos, <wordValue>)
 				}
@@ -1024,7 +1033,7 @@ string ABIFunctions::abiEncodingFunctionFunctionType(
 
 	if (_options.encodeFunctionFromStack)
 		return createFunction(functionName, [&]() {
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(addr, function_id, pos) {
 					mstore(pos, <combineExtFun>(addr, function_id))
 				}
@@ -1035,7 +1044,7 @@ string ABIFunctions::abiEncodingFunctionFunctionType(
 		});
 	else
 		return createFunction(functionName, [&]() {
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(addr_and_function_id, pos) {
 					mstore(pos, <cleanExtFun>(addr_and_function_id))
 				}
@@ -1095,7 +1104,7 @@ string ABIFunctions::abiDecodingFunctionValueType(Type const& _type, bool _fromM
 		_type.identifier() +
 		(_fromMemory ? "_fromMemory" : "");
 	return createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(offset, end) -> value {
 				value := <load>(offset)
 				<validator>(value)
@@ -1122,7 +1131,7 @@ string ABIFunctions::abiDecodingFunctionArray(ArrayType const& _type, bool _from
 
 	return createFunction(functionName, [&]() {
 		string load = _fromMemory ? "mload" : "calldataload";
-		Whiskers templ(
+		CompiledWhiskers templ(
 			R"(
 				// <readableTypeName>
 				function <functionName>(offset, end) -> array {
@@ -1155,7 +1164,7 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			// <readableTypeName>
 			function <functionName>(offset, length, end) -> array {
 				array := <allocate>(<allocationSize>(length))
@@ -1215,10 +1224,10 @@ string ABIFunctions::abiDecodingFunctionCalldataArray(ArrayType const& _type)
 		"abi_decode_" +
 		_type.identifier();
 	return createFunction(functionName, [&]() {
-		Whiskers w;
+		CompiledWhiskers w;
 		if (_type.isDynamicallySized())
 		{
-			w = Whiskers(R"(
+			w = CompiledWhiskers(R"(
 				// <readableTypeName>
 				function <functionName>(offset, end) -> arrayPos, length {
 					if iszero(slt(add(offset, 0x1f), end)) { <revertStringOffset> }
@@ -1233,7 +1242,7 @@ string ABIFunctions::abiDecodingFunctionCalldataArray(ArrayType const& _type)
 		}
 		else
 		{
-			w = Whiskers(R"(
+			w = CompiledWhiskers(R"(
 				// <readableTypeName>
 				function <functionName>(offset, end) -> arrayPos {
 					arrayPos := offset
@@ -1263,7 +1272,7 @@ string ABIFunctions::abiDecodingFunctionByteArrayAvailableLength(ArrayType const
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(src, length, end) -> array {
 				array := <allocate>(<allocationSize>(length))
 				mstore(array, length)
@@ -1289,7 +1298,7 @@ string ABIFunctions::abiDecodingFunctionCalldataStruct(StructType const& _type)
 		_type.identifier();
 
 	return createFunction(functionName, [&]() {
-		Whiskers w{R"(
+		CompiledWhiskers w{R"(
 				// <readableTypeName>
 				function <functionName>(offset, end) -> value {
 					if slt(sub(end, offset), <minimumSize>) { <revertString> }
@@ -1314,7 +1323,7 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			// <readableTypeName>
 			function <functionName>(headStart, end) -> value {
 				if slt(sub(end, headStart), <minimumSize>) { <revertString> }
@@ -1342,7 +1351,7 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 			solAssert(!member.type->containsNestedMapping(), "");
 			auto decodingType = member.type->decodingType();
 			solAssert(decodingType, "");
-			Whiskers memberTempl(R"(
+			CompiledWhiskers memberTempl(R"(
 				<?dynamic>
 					let offset := <load>(add(headStart, <pos>))
 					if gt(offset, 0xffffffffffffffff) { <revertString> }
@@ -1383,7 +1392,7 @@ string ABIFunctions::abiDecodingFunctionFunctionType(FunctionType const& _type,
 	return createFunction(functionName, [&]() {
 		if (_forUseOnStack)
 		{
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(offset, end) -> addr, function_selector {
 					addr, function_selector := <splitExtFun>(<decodeFun>(offset, end))
 				}
@@ -1395,7 +1404,7 @@ string ABIFunctions::abiDecodingFunctionFunctionType(FunctionType const& _type,
 		}
 		else
 		{
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(offset, end) -> fun {
 					fun := <load>(offset)
 					<validateExtFun>(fun)
@@ -1418,7 +1427,7 @@ string ABIFunctions::calldataAccessFunction(Type const& _type)
 		{
 			unsigned int tailSize = _type.calldataEncodedTailSize();
 			solAssert(tailSize > 1, "");
-			Whiskers w(R"(
+			CompiledWhiskers w(R"(
 				function <functionName>(base_ref, ptr) -> <return> {
 					let rel_offset_of_tail := calldataload(ptr)
 					if iszero(slt(rel_offset_of_tail, sub(sub(calldatasize(), base_ref), sub(<neededLength>, 1)))) { <revertStringOffset> }
@@ -1430,7 +1439,7 @@ string ABIFunctions::calldataAccessFunction(Type const& _type)
 			{
 				auto const* arrayType = dynamic_cast<ArrayType const*>(&_type);
 				solAssert(!!arrayType, "");
-				w("handleLength", Whiskers(R"(
+				w("handleLength", CompiledWhiskers(R"(
 					length := calldataload(value)
 					value := add(value, 0x20)
 					if gt(length, 0xffffffffffffffff) { <revertStringLength> }
@@ -1462,7 +1471,7 @@ string ABIFunctions::calldataAccessFunction(Type const& _type)
 			else
 				decodingFunction = abiDecodingFunctionValueType(_type, false);
 			// Note that the second argument to the decoding function should be discarded after inlining.
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(baseRef, ptr) -> value {
 					value := <decodingFunction>(ptr, add(ptr, 32))
 				}
@@ -1478,7 +1487,7 @@ string ABIFunctions::calldataAccessFunction(Type const& _type)
 				_type.category() == Type::Category::Struct,
 				""
 			);
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(baseRef, ptr) -> value {
 					value := ptr
 				}
@@ -1494,7 +1503,7 @@ string ABIFunctions::arrayStoreLengthForEncodingFunction(ArrayType const& _type,
 	string functionName = "array_storeLengthForEncoding_" + _type.identifier() + _options.toFunctionNameSuffix();
 	return createFunction(functionName, [&]() {
 		if (_type.isDynamicallySized() && !_options.dynamicInplace)
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(pos, length) -> updated_pos {
 					mstore(pos, length)
 					updated_pos := add(pos, 0x20)
@@ -1503,7 +1512,7 @@ string ABIFunctions::arrayStoreLengthForEncodingFunction(ArrayType const& _type,
 			("functionName", functionName)
 			.render();
 		else
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(pos, length) -> updated_pos {
 					updated_pos := pos
 				}
@@ -21,12 +21,28 @@ namespace solidity::frontend {
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings, bool _verbose = false):
+	/// Solidity++: @param _inlineAssemblyCache is shared with other compilers of the same compilation,
+	/// a cache of this compiler is used if it is null.
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		bool _verbose = false,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_runtimeContext(_evmVersion, _revertStrings, nullptr, _verbose),
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext, _verbose),
 		m_verbose(_verbose)
-	{ }
+	{
+		if (_inlineAssemblyCache)
+		{
+			m_runtimeContext.setInlineAssemblyCache(_inlineAssemblyCache);
+			m_context.setInlineAssemblyCache(std::move(_inlineAssemblyCache));
+		}
+		else
+			m_context.setInlineAssemblyCache(m_runtimeContext.inlineAssemblyCache());
+	}
 
 	/// Solidity++: compile Vite contract (without metadata)
 	void compileViteContract(
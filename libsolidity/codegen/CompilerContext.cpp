@@ -10,6 +10,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/YulUtilityCache.h>
 #include <libsolidity/interface/Version.h>
 
 #include <libyul/AsmParser.h>
@@ -242,6 +243,12 @@ unsigned CompilerContext::numberOfLocalVariables() const
 }
 
 // Solidity++:
+uint32_t CompilerContext::allocateCallbackId()
+{
+    solAssert(m_nextCallbackIndex < c_maxCallbacks, "Too many await expressions in one contract.");
+    return m_callbackIdBase + m_nextCallbackIndex++;
+}
+
 void CompilerContext::addCallbackDest(uint32_t const _callbackId)
 {
     auto tag = m_awaitCallbacks.find(_callbackId);
@@ -398,6 +405,9 @@ void CompilerContext::appendInlineAssembly(
 )
 {
 	unsigned startStackHeight = stackHeight();
+	optional<langutil::SourceLocation> locationOverride;
+	if (!_system)
+		locationOverride = m_asm->currentSourceLocation();
 
 	set<yul::YulString> externallyUsedIdentifiers;
 	for (auto const& fun: _externallyUsedFunctions)
@@ -431,7 +441,7 @@ void CompilerContext::appendInlineAssembly(
 		if (stackDiff < 1 || stackDiff > 16)
 			BOOST_THROW_EXCEPTION(
 				StackTooDeepError() <<
-				errinfo_sourceLocation(_identifier.location) <<
+				errinfo_sourceLocation(locationOverride ? *locationOverride : _identifier.location) <<
 				util::errinfo_comment("Stack too deep (" + to_string(stackDiff) + "), try removing local variables.")
 			);
 		if (_context == yul::IdentifierContext::RValue)
@@ -445,13 +455,51 @@ void CompilerContext::appendInlineAssembly(
 
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	optional<langutil::SourceLocation> locationOverride;
-	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
+
+	// Solidity++: snippets that are not optimised are cached. They are parsed without the
+	// location override, which is applied to the generated items instead.
+	bool cacheable = !_system && !(_optimiserSettings.runYulOptimiser && _localVariables.empty());
+	if (cacheable)
+		if (auto cached = m_inlineAssemblyCache->find(_assembly, _localVariables, m_evmVersion.name(), _sourceName))
+		{
+			yul::AsmAnalysisInfo analysisInfo = *cached->analysisInfo;
+			size_t firstItem = m_asm->items().size();
+			yul::CodeGenerator::assemble(
+				*cached->code,
+				analysisInfo,
+				*m_asm,
+				m_evmVersion,
+				identifierAccess,
+				_system,
+				_optimiserSettings.optimizeStackAllocation
+			);
+			for (size_t i = firstItem; i < m_asm->items().size(); ++i)
+				m_asm->items()[i].setLocation(*locationOverride);
+			updateSourceLocation();
+			return;
+		}
+
+	// Solidity++: the optimised utility functions are shared between contracts.
+	// The cached code is parsed instead of the requested code and is not optimised again.
+	bool optimise = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	optional<util::h256> utilityCacheKey;
+	optional<string> cachedUtilityCode;
+	if (_system && optimise)
+	{
+		utilityCacheKey = YulUtilityCache::key(
+			_assembly,
+			_externallyUsedFunctions,
+			_optimiserSettings,
+			m_evmVersion,
+			runtimeContext() != nullptr
+		);
+		cachedUtilityCode = YulUtilityCache::instance().find(*utilityCacheKey);
+	}
+
+	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(cachedUtilityCode ? *cachedUtilityCode : _assembly, _sourceName));
 	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
+		yul::Parser(errorReporter, dialect, cacheable ? nullopt : locationOverride)
 		.parse(scanner, false);
 #ifdef SOL_OUTPUT_ASM
 	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
@@ -486,7 +534,12 @@ void CompilerContext::appendInlineAssembly(
 
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	if (cachedUtilityCode)
+	{
+		solAssert(m_generatedYulUtilityCode.empty(), "");
+		m_generatedYulUtilityCode = move(*cachedUtilityCode);
+	}
+	else if (optimise)
 	{
 		yul::Object obj;
 		obj.code = parserResult;
@@ -503,6 +556,7 @@ void CompilerContext::appendInlineAssembly(
 			scanner = make_shared<langutil::Scanner>(langutil::CharStream(m_generatedYulUtilityCode, _sourceName));
 			obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
 			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+			YulUtilityCache::instance().insert(*utilityCacheKey, m_generatedYulUtilityCode);
 		}
 
 		analysisInfo = std::move(*obj.analysisInfo);
@@ -524,6 +578,7 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	size_t firstItem = m_asm->items().size();
 	yul::CodeGenerator::assemble(
 		*parserResult,
 		analysisInfo,
@@ -534,6 +589,19 @@ void CompilerContext::appendInlineAssembly(
 		_optimiserSettings.optimizeStackAllocation
 	);
 
+	if (cacheable)
+	{
+		for (size_t i = firstItem; i < m_asm->items().size(); ++i)
+			m_asm->items()[i].setLocation(*locationOverride);
+		m_inlineAssemblyCache->insert(
+			_assembly,
+			_localVariables,
+			m_evmVersion.name(),
+			_sourceName,
+			{move(parserResult), make_shared<yul::AsmAnalysisInfo>(move(analysisInfo))}
+		);
+	}
+
 	// Reset the source location to the one of the node (instead of the CODEGEN source location)
 	updateSourceLocation();
 }
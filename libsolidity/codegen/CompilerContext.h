@@ -11,6 +11,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -55,7 +56,8 @@ public:
 		m_runtimeContext(_runtimeContext),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
-		m_verbose(_verbose)
+		m_verbose(_verbose),
+		m_inlineAssemblyCache(std::make_shared<InlineAssemblyCache>())
 	{
 		if (m_runtimeContext)
 			m_runtimeSub = size_t(m_asm->newSub(m_runtimeContext->m_asm).data());
@@ -85,6 +87,13 @@ public:
 	unsigned numberOfLocalVariables() const;
 
 	// Solidity++:
+	/// Maximum number of await sites per context, i.e. the size of the callback id range.
+	static constexpr uint32_t c_maxCallbacks = 0x10000;
+	/// Sets the first callback id of this context. Callback ids are allocated densely from there.
+	void setCallbackIdBase(uint32_t _base) { solAssert(m_awaitCallbacks.empty() && m_nextCallbackIndex == 0, ""); m_callbackIdBase = _base; }
+	uint32_t callbackIdBase() const { return m_callbackIdBase; }
+	/// @returns a fresh callback id for an await site.
+	uint32_t allocateCallbackId();
 	void addCallbackDest(uint32_t const _callbackId);
 
 	void setOtherCompilers(std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers) { m_otherCompilers = _otherCompilers; }
@@ -218,6 +227,8 @@ public:
 	void appendProgramSize() { m_asm->appendProgramSize(); }
 	/// Adds data to the data section, pushes a reference to the stack
 	evmasm::AssemblyItem appendData(bytes const& _data) { return m_asm->append(_data); }
+	/// Solidity++: Appends a push of the code offset of a table of the positions of @a _tags.
+	evmasm::AssemblyItem appendTagTable(std::vector<evmasm::AssemblyItem> const& _tags) { return m_asm->append(m_asm->newTagTable(_tags)); }
 	/// Appends the address (virtual, will be filled in by linker) of a library.
 	void appendLibraryAddress(std::string const& _identifier) { m_asm->appendLibraryAddress(_identifier); }
 	/// Appends an immutable variable. The value will be filled in by the constructor.
@@ -264,6 +275,10 @@ public:
 	/// Otherwise returns "revert(0, 0)".
 	std::string revertReasonIfDebug(std::string const& _message = "");
 
+	/// Solidity++: Sets the cache of inline assembly snippets, which can be shared with other contexts.
+	void setInlineAssemblyCache(std::shared_ptr<InlineAssemblyCache> _cache) { m_inlineAssemblyCache = std::move(_cache); }
+	std::shared_ptr<InlineAssemblyCache> const& inlineAssemblyCache() const { return m_inlineAssemblyCache; }
+
 	void optimizeYul(yul::Object& _object, yul::EVMDialect const& _dialect, OptimiserSettings const& _optimiserSetting, std::set<yul::YulString> const& _externalIdentifiers = {});
 
 	/// Appends arbitrary data to the end of the bytecode.
@@ -298,7 +313,7 @@ public:
 	RevertStrings revertStrings() const { return m_revertStrings; }
 
 	// Solidity++
-	std::map<uint32_t, evmasm::AssemblyItem> awaitCallbacks() const { return m_awaitCallbacks; }
+	std::map<uint32_t, evmasm::AssemblyItem> const& awaitCallbacks() const { return m_awaitCallbacks; }
 
 	/// Solidity++: output debug info in verbose mode
 	void debug(std::string info) const { if (m_verbose) std::clog << "            [CompilerContext] " << info << std::endl; }
@@ -376,6 +391,9 @@ private:
 
 	/// Solidity++: An index of await callback labels
 	std::map<uint32_t, evmasm::AssemblyItem> m_awaitCallbacks;
+	/// Solidity++: Callback ids are m_callbackIdBase, m_callbackIdBase + 1, ...
+	uint32_t m_callbackIdBase = 1;
+	uint32_t m_nextCallbackIndex = 0;
 
 	/// Collector for yul functions.
 	MultiUseYulFunctionCollector m_yulFunctionCollector;
@@ -395,6 +413,8 @@ private:
 
 	// Solidity++:
 	bool m_verbose = false;
+	/// Parsed inline assembly snippets, see appendInlineAssembly.
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
 };
 
 }
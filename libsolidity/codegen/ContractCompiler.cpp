@@ -71,6 +71,23 @@ private:
 	unsigned stackHeight;
 };
 
+/// Solidity++:
+/// @returns the first callback id of a range of CompilerContext::c_maxCallbacks ids
+/// that does not contain any function selector of @a _contract.
+uint32_t callbackIdBase(ContractDefinition const& _contract)
+{
+	uint32_t base = 1;
+	// Selectors are sorted, so a single pass is enough.
+	for (auto const& it: _contract.interfaceFunctionTable())
+	{
+		uint32_t selector = uint32_t(FixedHash<4>::Arith(it.first));
+		if (selector >= base && selector - base < CompilerContext::c_maxCallbacks)
+			base = selector + 1;
+	}
+	solAssert(base <= numeric_limits<uint32_t>::max() - CompilerContext::c_maxCallbacks, "No free callback id range.");
+	return base;
+}
+
 }
 
 void ContractCompiler::compileContract(
@@ -87,11 +104,13 @@ void ContractCompiler::compileContract(
 		appendDelegatecallCheck();
 
 	initializeContext(_contract, _otherCompilers);
+	// Solidity++: callback ids must not collide with function selectors
+	m_context.setCallbackIdBase(callbackIdBase(_contract));
 	// This does not generate the dispatch function for externally visible functions.
 	// Just adds the function to the compilation queue. Additionally internal functions,
 	// which are referenced directly or indirectly will be added.
 	debug("Adding function entry:");
-	for (auto const& it: _contract.interfaceFunctions())
+	for (auto const& it: _contract.interfaceFunctionTable())
 	{
 	    FunctionTypePointer const& functionType = it.second;
 	    solAssert(functionType->hasDeclaration(), "");
@@ -383,16 +402,59 @@ void ContractCompiler::appendInternalSelector(
         m_context.appendConditionalJumpTo(_entryPoints.at(id));
     }
     m_context.appendDebugInfo("callback selector");
-    for (auto const& entry: m_context.awaitCallbacks())
-    {
-        m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(entry.first)) << Instruction::EQ;
-        m_context.appendConditionalJumpTo(entry.second);
-    }
+    appendCallbackSelector(_notFoundTag);
     m_context.appendDebugInfo("not found");
     m_context.appendJumpTo(_notFoundTag);
     m_context.appendDebugInfo("end of ContractCompiler::appendInternalSelector()");
 }
 
+void ContractCompiler::appendCallbackSelector(evmasm::AssemblyItem const& _notFoundTag)
+{
+	auto const& callbacks = m_context.awaitCallbacks();
+	// Solidity++: for a few callbacks the comparison chain is cheaper than the table lookup
+	if (callbacks.size() < c_callbackJumpTableThreshold)
+	{
+		for (auto const& entry: callbacks)
+		{
+			m_context << dupInstruction(1) << u256(entry.first) << Instruction::EQ;
+			m_context.appendConditionalJumpTo(entry.second);
+		}
+		return;
+	}
+
+	// Callback ids are dense, so the id is turned into an index of a table of callback tags:
+	//   index = id - base; if (index < n) jump(table[index])
+	uint32_t const base = m_context.callbackIdBase();
+	vector<evmasm::AssemblyItem> tags;
+	for (auto const& [id, tag]: callbacks)
+	{
+		solAssert(id == base + tags.size(), "Callback ids are not dense.");
+		tags.push_back(tag);
+	}
+	debug("Append callback jump table of " + to_string(tags.size()) + " entries");
+
+	evmasm::AssemblyItem tableLookup = m_context.newTag("callback jump table lookup");
+	// stack: <funhash>
+	m_context << u256(base) << dupInstruction(2) << Instruction::SUB;
+	// stack: <funhash> <index>
+	m_context << Instruction::DUP1 << u256(tags.size()) << Instruction::GT;
+	m_context.appendConditionalJumpTo(tableLookup);
+	m_context << Instruction::POP;
+	m_context.appendJumpTo(_notFoundTag);
+
+	m_context << tableLookup;
+	m_context.adjustStackOffset(1);
+	// Copy the 4-byte table entry into scratch space and jump to it.
+	m_context << u256(4) << Instruction::MUL;
+	m_context.appendTagTable(tags);
+	m_context << Instruction::ADD;
+	m_context << u256(4) << Instruction::SWAP1 << u256(0) << Instruction::CODECOPY;
+	m_context << u256(0) << Instruction::MLOAD;
+	CompilerUtils(m_context).rightShiftNumberOnStack(224);
+	// The callback tags are entered with <funhash> on the stack, just as with the comparison chain.
+	m_context.appendJump(evmasm::AssemblyItem::JumpType::Ordinary);
+}
+
 namespace
 {
 
@@ -406,7 +468,7 @@ bool hasPayableFunctions(ContractDefinition const& _contract)
 	if (fallback && fallback->isPayable())
 		return true;
 
-	for (auto const& it: _contract.interfaceFunctions())
+	for (auto const& it: _contract.interfaceFunctionTable())
 		if (it.second->isPayable())
 			return true;
 
@@ -417,7 +479,7 @@ bool hasPayableFunctions(ContractDefinition const& _contract)
 
 void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contract)
 {
-	map<FixedHash<4>, FunctionTypePointer> interfaceFunctions = _contract.interfaceFunctions();
+	auto const& interfaceFunctions = _contract.interfaceFunctionTable();
 	map<FixedHash<4>, evmasm::AssemblyItem const> callDataUnpackerEntryPoints;
 
 	if (_contract.isLibrary())
@@ -473,7 +535,7 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 			debug("  - For interface function: " + it.second->toString(false) + ":  " + it.first.hex() + " -> " + tag.toAssemblyText(m_context.assembly()));
 		}
 
-		std::sort(sortedIDs.begin(), sortedIDs.end());
+		// The table is sorted by selector already.
 		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
 	}
 
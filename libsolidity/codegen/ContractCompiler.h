@@ -56,6 +56,9 @@ public:
 	void debug(std::string info) const { if (m_verbose) std::clog << "        [ContractCompiler] " << info << std::endl; }
 
 private:
+	/// Solidity++: Number of await callbacks from which on they are dispatched through a jump table.
+	static size_t constexpr c_callbackJumpTableThreshold = 4;
+
 	/// Registers the non-function objects inside the contract with the context and stores the basic
 	/// information about the contract like the AST annotations.
 	void initializeContext(
@@ -87,6 +90,10 @@ private:
 		evmasm::AssemblyItem const& _notFoundTag,
 		size_t _runs
 	);
+	/// Solidity++: Appends the dispatch of await callbacks. Expects the selector on the stack
+	/// and leaves it there. Uses a jump table indexed by the dense callback id for
+	/// @a c_callbackJumpTableThreshold or more callbacks.
+	void appendCallbackSelector(evmasm::AssemblyItem const& _notFoundTag);
 	void appendFunctionSelector(ContractDefinition const& _contract);
 	void appendCallValueCheck();
 	void appendReturnValuePacker(TypePointers const& _typeParameters, bool _isLibrary);
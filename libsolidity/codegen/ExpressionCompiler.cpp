@@ -647,7 +647,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 			uint32_t callbackSelector;
 			if(!_functionCall.annotation().async && function.kind() != FunctionType::Kind::DelegateCall && function.kind() != FunctionType::Kind::BareDelegateCall)
             {
-			    callbackSelector = selectorFromAwaitId( _functionCall.id());
+			    callbackSelector = m_context.allocateCallbackId();
                 debug("Callback selector is " + toHex(callbackSelector, HexPrefix::Add));
             }
 			else
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Cache of parsed and analysed inline assembly snippets of the code generator.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+shared_ptr<InlineAssemblyCache::Entry const> InlineAssemblyCache::find(
+	string const& _assembly,
+	vector<string> const& _localVariables,
+	string const& _evmVersion,
+	string const& _sourceName
+) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(Key{_assembly, _localVariables, _evmVersion, _sourceName});
+	if (it == m_entries.end())
+	{
+		++m_misses;
+		return nullptr;
+	}
+	++m_hits;
+	return it->second;
+}
+
+void InlineAssemblyCache::insert(
+	string _assembly,
+	vector<string> _localVariables,
+	string _evmVersion,
+	string _sourceName,
+	Entry _entry
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(
+		Key{move(_assembly), move(_localVariables), move(_evmVersion), move(_sourceName)},
+		make_shared<Entry const>(move(_entry))
+	);
+}
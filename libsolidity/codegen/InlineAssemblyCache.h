@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Cache of parsed and analysed inline assembly snippets of the code generator.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysisInfo.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Holds the Yul AST and analysis of inline assembly snippets appended by
+ * CompilerContext::appendInlineAssembly, so that snippets used again (reverts, requires,
+ * Whiskers helpers) do not have to be scanned, parsed and analysed again.
+ *
+ * The AST refers to YulStrings, so a cache must not outlive a reset of the YulStringRepository.
+ * CompilerStack creates a new cache for every compilation and shares it between all contracts.
+ */
+class InlineAssemblyCache
+{
+public:
+	struct Entry
+	{
+		std::shared_ptr<yul::Block const> code;
+		std::shared_ptr<yul::AsmAnalysisInfo const> analysisInfo;
+	};
+
+	/// @returns the cached snippet or nullptr.
+	std::shared_ptr<Entry const> find(
+		std::string const& _assembly,
+		std::vector<std::string> const& _localVariables,
+		std::string const& _evmVersion,
+		std::string const& _sourceName
+	) const;
+
+	void insert(
+		std::string _assembly,
+		std::vector<std::string> _localVariables,
+		std::string _evmVersion,
+		std::string _sourceName,
+		Entry _entry
+	);
+
+	size_t hits() const { std::lock_guard<std::mutex> lock(m_mutex); return m_hits; }
+	size_t misses() const { std::lock_guard<std::mutex> lock(m_mutex); return m_misses; }
+
+private:
+	using Key = std::tuple<std::string, std::vector<std::string>, std::string, std::string>;
+
+	mutable std::mutex m_mutex;
+	std::map<Key, std::shared_ptr<Entry const>> m_entries;
+	mutable size_t m_hits = 0;
+	mutable size_t m_misses = 0;
+};
+
+}
@@ -13,7 +13,7 @@
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/FunctionSelector.h>
-#include <libsolutil/Whiskers.h>
+#include <libsolutil/CompiledWhiskers.h>
 #include <libsolutil/StringUtils.h>
 
 using namespace std;
@@ -31,7 +31,7 @@ string YulUtilFunctions::combineExternalFunctionIdFunction()
 	    // make space for selector: [7-byte zeros][21-byte address][4-byte zeros]
 	    // append selector: [7-byte zeros][21-byte address][4-byte selector]
 	    // remove leading zeros: [21-byte address][4-byte selector][7-byte zeros]
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(addr, selector) -> combined {
 				combined := <shl56>(or(<shl32>(addr), and(selector, 0xffffffff)))
 			}
@@ -53,7 +53,7 @@ string YulUtilFunctions::splitExternalFunctionIdFunction()
 	    // remove trailing zeros: [7-byte zeros][21-byte address][4-byte selector]
 	    // extract selector: [28-byte zeros][4-byte selector]
 	    // extract address: [11-byte zeros][21-byte address]
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(combined) -> addr, selector {
 				combined := <shr56>(combined)
 				selector := and(combined, 0xffffffff)
@@ -73,7 +73,7 @@ string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 	return m_functionCollector.createFunction(functionName, [&]() {
 		if (_fromCalldata)
 		{
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(src, dst, length) {
 					calldatacopy(dst, src, length)
 					// clear end
@@ -85,7 +85,7 @@ string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 		}
 		else
 		{
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(src, dst, length) {
 					let i := 0
 					for { } lt(i, length) { i := add(i, 32) }
@@ -111,7 +111,7 @@ string YulUtilFunctions::copyLiteralToMemoryFunction(string const& _literal)
 	string functionName = "copy_literal_to_memory_" + util::toHex(util::blake2b(_literal).asBytes());
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := <arrayAllocationFunction>(<size>)
 				<storeLiteralInMem>(add(memPtr, 32))
@@ -139,7 +139,7 @@ string YulUtilFunctions::storeLiteralInMemoryFunction(string const& _literal)
 			wordParams[i]["wordValue"] = formatAsStringOrNumber(_literal.substr(32 * i, 32));
 		}
 
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(memPtr) {
 				<#word>
 					mstore(add(memPtr, <offset>), <wordValue>)
@@ -162,7 +162,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 
 	return m_functionCollector.createFunction(functionName, [&]() {
 		if (!_messageType)
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(condition) {
 					if iszero(condition) { <error> }
 				}
@@ -180,7 +180,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 				{TypeProvider::stringMemory()}
 			);
 
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(condition <messageVars>) {
 				if iszero(condition) {
 					let memPtr := <allocateUnbounded>()
@@ -207,7 +207,7 @@ string YulUtilFunctions::leftAlignFunction(Type const& _type)
 {
 	string functionName = string("leftAlign_") + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value) -> aligned {
 				<body>
 			}
@@ -276,7 +276,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 	string functionName = "shift_left_" + to_string(_numBits);
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(value) -> newValue {
 				newValue :=
 				<?hasShifts>
@@ -299,7 +299,7 @@ string YulUtilFunctions::shiftLeftFunctionDynamic()
 	string functionName = "shift_left_dynamic";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(bits, value) -> newValue {
 				newValue :=
 				<?hasShifts>
@@ -325,7 +325,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 	string functionName = "shift_right_" + to_string(_numBits) + "_unsigned";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(value) -> newValue {
 				newValue :=
 				<?hasShifts>
@@ -348,7 +348,7 @@ string YulUtilFunctions::shiftRightFunctionDynamic()
 	string const functionName = "shift_right_unsigned_dynamic";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(bits, value) -> newValue {
 				newValue :=
 				<?hasShifts>
@@ -369,7 +369,7 @@ string YulUtilFunctions::shiftRightSignedFunctionDynamic()
 	string const functionName = "shift_right_signed_dynamic";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(bits, value) -> result {
 				<?hasShifts>
 					result := sar(bits, value)
@@ -399,7 +399,7 @@ string YulUtilFunctions::typedShiftLeftFunction(Type const& _type, Type const& _
 	string const functionName = "shift_left_" + _type.identifier() + "_" + _amountType.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(value, bits) -> result {
 				bits := <cleanAmount>(bits)
 				result := <cleanup>(<shift>(bits, value))
@@ -424,7 +424,7 @@ string YulUtilFunctions::typedShiftRightFunction(Type const& _type, Type const&
 	string const functionName = "shift_right_" + _type.identifier() + "_" + _amountType.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(value, bits) -> result {
 				bits := <cleanAmount>(bits)
 				result := <cleanup>(<shift>(bits, <cleanup>(value)))
@@ -447,7 +447,7 @@ string YulUtilFunctions::updateByteSliceFunction(size_t _numBytes, size_t _shift
 	string functionName = "update_byte_slice_" + to_string(_numBytes) + "_shift_" + to_string(_shiftBytes);
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(value, toInsert) -> result {
 				let mask := <mask>
 				toInsert := <shl>(toInsert)
@@ -469,7 +469,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 	string functionName = "update_byte_slice_dynamic" + to_string(_numBytes);
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(value, shiftBytes, toInsert) -> result {
 				let shiftBits := mul(shiftBytes, 8)
 				let mask := <shl>(shiftBits, <mask>)
@@ -489,7 +489,7 @@ string YulUtilFunctions::maskBytesFunctionDynamic()
 {
 	string functionName = "mask_bytes_dynamic";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shr>(mul(8, bytes), not(0)))
 				result := and(data, mask)
@@ -505,7 +505,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 	string functionName = "mask_lower_order_bytes_" + to_string(_bytes);
 	solAssert(_bytes <= 32, "");
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(data) -> result {
 				result := and(data, <mask>)
 			})")
@@ -519,7 +519,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 {
 	string functionName = "mask_lower_order_bytes_dynamic";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shl>(mul(8, bytes), not(0)))
 				result := and(data, mask)
@@ -535,7 +535,7 @@ string YulUtilFunctions::roundUpFunction()
 	string functionName = "round_up_to_mul_of_32";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(value) -> result {
 				result := and(add(value, 31), not(31))
 			}
@@ -553,7 +553,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 	//       sum := add(x, y) if lt(sum, x) { <panic>() }
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> sum {
 				x := <cleanupFunction>(x)
 				y := <cleanupFunction>(y)
@@ -584,7 +584,7 @@ string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 	string functionName = "wrapping_add_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> sum {
 				sum := <cleanupFunction>(add(x, y))
 			}
@@ -601,7 +601,7 @@ string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
 			// Multiplication by zero could be treated separately and directly return zero.
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> product {
 				x := <cleanupFunction>(x)
 				y := <cleanupFunction>(y)
@@ -636,7 +636,7 @@ string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 	string functionName = "wrapping_mul_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> product {
 				product := <cleanupFunction>(mul(x, y))
 			}
@@ -652,7 +652,7 @@ string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 	string functionName = "checked_div_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> r {
 				x := <cleanupFunction>(x)
 				y := <cleanupFunction>(y)
@@ -682,7 +682,7 @@ string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 	string functionName = "wrapping_div_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> r {
 				x := <cleanupFunction>(x)
 				y := <cleanupFunction>(y)
@@ -703,7 +703,7 @@ string YulUtilFunctions::intModFunction(IntegerType const& _type)
 	string functionName = "mod_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> r {
 				x := <cleanupFunction>(x)
 				y := <cleanupFunction>(y)
@@ -724,7 +724,7 @@ string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 	string functionName = "checked_sub_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&] {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> diff {
 				x := <cleanupFunction>(x)
 				y := <cleanupFunction>(y)
@@ -754,7 +754,7 @@ string YulUtilFunctions::wrappingIntSubFunction(IntegerType const& _type)
 	string functionName = "wrapping_sub_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&] {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(x, y) -> diff {
 				diff := <cleanupFunction>(sub(x, y))
 			}
@@ -775,7 +775,7 @@ string YulUtilFunctions::overflowCheckedIntExpFunction(
 	string functionName = "checked_exp_" + _type.identifier() + "_" + _exponentType.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(base, exponent) -> power {
 				base := <baseCleanupFunction>(base)
 				exponent := <exponentCleanupFunction>(exponent)
@@ -892,7 +892,7 @@ string YulUtilFunctions::overflowCheckedIntLiteralExpFunction(
 				);
 		}
 
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(exponent) -> power {
 				exponent := <exponentCleanupFunction>(exponent)
 				<?needsOverflowCheck>
@@ -926,7 +926,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 	string functionName = "checked_exp_unsigned";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(base, exponent, max) -> power {
 				// This function currently cannot be inlined because of the
 				// "leave" statements. We have to improve the optimizer.
@@ -974,7 +974,7 @@ string YulUtilFunctions::overflowCheckedSignedExpFunction()
 	string functionName = "checked_exp_signed";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(base, exponent, min, max) -> power {
 				// Currently, `leave` avoids this function being inlined.
 				// We have to improve the optimizer.
@@ -1030,7 +1030,7 @@ string YulUtilFunctions::overflowCheckedExpLoopFunction()
 	string functionName = "checked_exp_helper";
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(_power, _base, exponent, max) -> power, base {
 				power := _power
 				base  := _base
@@ -1069,7 +1069,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 	string functionName = "wrapping_exp_" + _type.identifier() + "_" + _exponentType.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		return
-			Whiskers(R"(
+			CompiledWhiskers(R"(
 			function <functionName>(base, exponent) -> power {
 				base := <baseCleanupFunction>(base)
 				exponent := <exponentCleanupFunction>(exponent)
@@ -1087,7 +1087,7 @@ string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 {
 	string functionName = "array_length_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers w(R"(
+		CompiledWhiskers w(R"(
 			function <functionName>(value<?dynamic><?calldata>, len</calldata></dynamic>) -> length {
 				<?dynamic>
 					<?memory>
@@ -1129,7 +1129,7 @@ string YulUtilFunctions::extractByteArrayLengthFunction()
 {
 	string functionName = "extract_byte_array_length";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers w(R"(
+		CompiledWhiskers w(R"(
 			function <functionName>(data) -> length {
 				length := div(data, 2)
 				let outOfPlaceEncoding := and(data, 1)
@@ -1158,7 +1158,7 @@ std::string YulUtilFunctions::resizeArrayFunction(ArrayType const& _type)
 
 	string functionName = "resize_array_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(array, newLen) {
 				if gt(newLen, <maxArrayLength>) {
 					<panic>()
@@ -1214,7 +1214,7 @@ string YulUtilFunctions::resizeDynamicByteArrayFunction(ArrayType const& _type)
 {
 	string functionName = "resize_array_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array, newLen) {
 				if gt(newLen, <maxArrayLength>) {
 					<panic>()
@@ -1245,7 +1245,7 @@ string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_decrease_size_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array, data, oldLen, newLen) {
 				switch lt(newLen, 32)
 				case  0 {
@@ -1287,7 +1287,7 @@ string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_increase_size_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array, data, oldLen, newLen) {
 				switch lt(oldLen, 32)
 				case 0 {
@@ -1319,7 +1319,7 @@ string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _t
 {
 	string functionName = "transit_byte_array_long_to_short_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array, len) {
 				// we need to copy elements from old array to new
 				// we want to copy only elements that are part of the array after resizing
@@ -1339,7 +1339,7 @@ string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 {
 	string functionName = "extract_used_part_and_set_length_of_short_byte_array";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(data, len) -> used {
 				// we want to save only elements that are part of the array after resizing
 				// others should be set to zero
@@ -1362,7 +1362,7 @@ string YulUtilFunctions::storageArrayPopFunction(ArrayType const& _type)
 
 	string functionName = "array_pop_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array) {
 				let oldLen := <fetchLength>(array)
 				if iszero(oldLen) { <panic>() }
@@ -1391,7 +1391,7 @@ string YulUtilFunctions::storageByteArrayPopFunction(ArrayType const& _type)
 
 	string functionName = "byte_array_pop_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array) {
 				let data := sload(array)
 				let oldLen := <extractByteArrayLength>(data)
@@ -1442,7 +1442,7 @@ string YulUtilFunctions::storageArrayPushFunction(ArrayType const& _type, Type c
 		"_to_" +
 		_type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array <values>) {
 				<?isByteArray>
 					let data := sload(array)
@@ -1506,7 +1506,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 
 	string functionName = "array_push_zero_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array) -> slot, offset {
 				<?isBytes>
 					let data := sload(array)
@@ -1535,7 +1535,7 @@ string YulUtilFunctions::partialClearStorageSlotFunction()
 {
 	string functionName = "partial_clear_storage_slot";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 		function <functionName>(slot, offset) {
 			let mask := <shr>(mul(8, sub(32, offset)), <ones>)
 			sstore(slot, and(mask, sload(slot)))
@@ -1556,7 +1556,7 @@ string YulUtilFunctions::clearStorageRangeFunction(Type const& _type)
 	string functionName = "clear_storage_range_" + _type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(start, end) {
 				for {} lt(start, end) { start := add(start, <increment>) }
 				{
@@ -1587,7 +1587,7 @@ string YulUtilFunctions::clearStorageArrayFunction(ArrayType const& _type)
 	string functionName = "clear_storage_array_" + _type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(slot) {
 				<?dynamic>
 					<resizeArray>(slot, 0)
@@ -1640,7 +1640,7 @@ string YulUtilFunctions::clearStorageStructFunction(StructType const& _type)
 				auto const& [memberSlotDiff, memberStorageOffset] = _type.storageOffsetsOfMember(member.name);
 				solAssert(memberStorageOffset == 0, "");
 
-				memberSetValues.emplace_back().emplace("clearMember", Whiskers(R"(
+				memberSetValues.emplace_back().emplace("clearMember", CompiledWhiskers(R"(
 						<setZero>(add(slot, <memberSlotDiff>), <memberStorageOffset>)
 					)")
 					("setZero", storageSetToZeroFunction(*member.type))
@@ -1651,7 +1651,7 @@ string YulUtilFunctions::clearStorageStructFunction(StructType const& _type)
 			}
 		}
 
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(slot) {
 				<#member>
 					<clearMember>
@@ -1680,7 +1680,7 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
 	return m_functionCollector.createFunction(functionName, [&](){
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(slot, value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>) {
 				<?fromStorage> if eq(slot, value) { leave } </fromStorage>
 				let length := <arrayLength>(value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>)
@@ -1785,7 +1785,7 @@ string YulUtilFunctions::copyByteArrayToStorageFunction(ArrayType const& _fromTy
 
 	string functionName = "copy_byte_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
 	return m_functionCollector.createFunction(functionName, [&](){
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(slot, src<?fromCalldata>, len</fromCalldata>) {
 				<?fromStorage> if eq(slot, src) { leave } </fromStorage>
 
@@ -1877,7 +1877,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
 	return m_functionCollector.createFunction(functionName, [&](){
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(dst, src) {
 				if eq(dst, src) { leave }
 				let length := <arrayLength>(src)
@@ -1968,7 +1968,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 			templ("convert", conversionFunction(*_fromType.baseType(), *_toType.baseType()));
 			templ("prepareStore", prepareStoreFunction(*_toType.baseType()));
 		}
-		templ("updateSrcSlotValue", Whiskers(R"(
+		templ("updateSrcSlotValue", CompiledWhiskers(R"(
 			<?srcReadMultiPerSlot>
 				srcItemIndexInSlot := add(srcItemIndexInSlot, 1)
 				if eq(srcItemIndexInSlot, <srcItemsPerSlot>) {
@@ -2006,7 +2006,7 @@ string YulUtilFunctions::arrayConvertLengthToSize(ArrayType const& _type)
 				solAssert(baseStorageBytes > 0, "");
 				solAssert(32 / baseStorageBytes > 0, "");
 
-				return Whiskers(R"(
+				return CompiledWhiskers(R"(
 					function <functionName>(length) -> size {
 						size := length
 						<?multiSlot>
@@ -2025,7 +2025,7 @@ string YulUtilFunctions::arrayConvertLengthToSize(ArrayType const& _type)
 			}
 			case DataLocation::CallData: // fallthrough
 			case DataLocation::Memory:
-				return Whiskers(R"(
+				return CompiledWhiskers(R"(
 					function <functionName>(length) -> size {
 						<?byteArray>
 							size := length
@@ -2050,7 +2050,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 	string functionName = "array_allocation_size_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers w(R"(
+		CompiledWhiskers w(R"(
 			function <functionName>(length) -> size {
 				// Make sure we can allocate memory without overflow
 				if gt(length, 0xffffffffffffffff) { <panic>() }
@@ -2083,7 +2083,7 @@ string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 		// points to the data area.
 		// This might change, if calldata arrays are stored in a single
 		// stack slot at some point.
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(ptr) -> data {
 				data := ptr
 				<?dynamic>
@@ -2109,7 +2109,7 @@ string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "storage_array_index_access_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(array, index) -> slot, offset {
 				let arrayLength := <arrayLen>(array)
 				if iszero(lt(index, arrayLength)) { <panic>() }
@@ -2154,7 +2154,7 @@ string YulUtilFunctions::memoryArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "memory_array_index_access_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(baseRef, index) -> addr {
 				if iszero(lt(index, <arrayLen>(baseRef))) {
 					<panic>()
@@ -2181,7 +2181,7 @@ string YulUtilFunctions::calldataArrayIndexAccessFunction(ArrayType const& _type
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "calldata_array_index_access_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(base_ref<?dynamicallySized>, length</dynamicallySized>, index) -> addr<?dynamicallySizedBase>, len</dynamicallySizedBase> {
 				if iszero(lt(index, <?dynamicallySized>length<!dynamicallySized><arrayLen></dynamicallySized>)) { <panic>() }
 				addr := add(base_ref, mul(index, <stride>))
@@ -2208,7 +2208,7 @@ string YulUtilFunctions::calldataArrayIndexRangeAccess(ArrayType const& _type)
 	solAssert(_type.isDynamicallySized(), "");
 	string functionName = "calldata_array_index_range_access_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(offset, length, startIndex, endIndex) -> offsetOut, lengthOut {
 				if gt(startIndex, endIndex) { <revertSliceStartAfterEnd> }
 				if gt(endIndex, length) { <revertSliceGreaterThanLength> }
@@ -2230,7 +2230,7 @@ string YulUtilFunctions::accessCalldataTailFunction(Type const& _type)
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "access_calldata_tail_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(base_ref, ptr_to_tail) -> addr<?dynamicallySized>, length</dynamicallySized> {
 				let rel_offset_of_tail := calldataload(ptr_to_tail)
 				if iszero(slt(rel_offset_of_tail, sub(sub(calldatasize(), base_ref), sub(<neededLength>, 1)))) { <invalidCalldataTailOffset> }
@@ -2261,7 +2261,7 @@ string YulUtilFunctions::nextArrayElementFunction(ArrayType const& _type)
 		solAssert(_type.baseType()->storageBytes() > 16, "");
 	string functionName = "array_nextElement_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(ptr) -> next {
 				next := add(ptr, <advance>)
 			}
@@ -2306,7 +2306,7 @@ string YulUtilFunctions::copyArrayFromStorageToMemoryFunction(ArrayType const& _
 		{
 			solAssert(_from.baseType() == _to.baseType(), "");
 			ABIFunctions abi(m_evmVersion, m_revertStrings, m_functionCollector);
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot) -> memPtr {
 					memPtr := <allocateUnbounded>()
 					let end := <encode>(slot, memPtr)
@@ -2329,7 +2329,7 @@ string YulUtilFunctions::copyArrayFromStorageToMemoryFunction(ArrayType const& _
 			solAssert(_from.baseType()->dataStoredIn(DataLocation::Storage), "");
 			solAssert(!_from.isByteArray(), "");
 			solAssert(*_to.withLocation(DataLocation::Storage, _from.isPointer()) == _from, "");
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot) -> memPtr {
 					let length := <lengthFunction>(slot)
 					memPtr := <allocateArray>(length)
@@ -2362,7 +2362,7 @@ string YulUtilFunctions::mappingIndexAccessFunction(MappingType const& _mappingT
 	string functionName = "mapping_index_access_" + _mappingType.identifier() + "_of_" + _keyType.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		if (_mappingType.keyType()->isDynamicallySized())
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot <?+key>,</+key> <key>) -> dataSlot {
 					dataSlot := <hash>(<key> <?+key>,</+key> slot)
 				}
@@ -2379,7 +2379,7 @@ string YulUtilFunctions::mappingIndexAccessFunction(MappingType const& _mappingT
 			solAssert(CompilerUtils::freeMemoryPointer >= 0x40, "");
 			solAssert(!_mappingType.keyType()->isDynamicallyEncoded(), "");
 			solAssert(_mappingType.keyType()->calldataEncodedSize(false) <= 0x20, "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>(slot <key>) -> dataSlot {
 					mstore(0, <convertedKey>)
 					mstore(0x20, slot)
@@ -2418,7 +2418,7 @@ string YulUtilFunctions::readFromStorageDynamic(Type const& _type, bool _splitFu
 		_type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&] {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(slot, offset) -> value {
 				if gt(offset, 0) { <panic>() }
 				value := <readFromStorage>(slot)
@@ -2446,7 +2446,7 @@ string YulUtilFunctions::readFromStorageValueType(Type const& _type, optional<si
 			_type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&] {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(slot<?dynamic>, offset</dynamic>) -> <?split>addr, selector<!split>value</split> {
 				<?split>let</split> value := <extract>(sload(slot)<?dynamic>, offset</dynamic>)
 				<?split>
@@ -2492,7 +2492,7 @@ string YulUtilFunctions::readFromStorageReferenceType(Type const& _type)
 		auto const& [memberSlotDiff, memberStorageOffset] = structType.storageOffsetsOfMember(structMembers[i].name);
 		solAssert(structMembers[i].type->isValueType() || memberStorageOffset == 0, "");
 
-		memberSetValues[i]["setMember"] = Whiskers(R"(
+		memberSetValues[i]["setMember"] = CompiledWhiskers(R"(
 			{
 				let <memberValues> := <readFromStorage>(add(slot, <memberSlotDiff>))
 				<writeToMemory>(add(value, <memberMemoryOffset>), <memberValues>)
@@ -2507,7 +2507,7 @@ string YulUtilFunctions::readFromStorageReferenceType(Type const& _type)
 	}
 
 	return m_functionCollector.createFunction(functionName, [&] {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(slot) -> value {
 				value := <allocStruct>()
 				<#member>
@@ -2552,7 +2552,7 @@ string YulUtilFunctions::updateStorageValueFunction(
 			solAssert(_toType.storageBytes() <= 32, "Invalid storage bytes size.");
 			solAssert(_toType.storageBytes() > 0, "Invalid storage bytes size.");
 
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot, <offset><fromValues>) {
 					let <toValues> := <convert>(<fromValues>)
 					sstore(slot, <update>(sload(slot), <offset><prepare>(<toValues>)))
@@ -2584,7 +2584,7 @@ string YulUtilFunctions::updateStorageValueFunction(
 			auto const& toArrayType = dynamic_cast<ArrayType const&>(*toReferenceType);
 			solAssert(toArrayType.isByteArray(), "");
 
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot<?dynamicOffset>, offset</dynamicOffset>) {
 					<?dynamicOffset>if offset { <panic>() }</dynamicOffset>
 					let value := <copyLiteralToMemory>()
@@ -2607,7 +2607,7 @@ string YulUtilFunctions::updateStorageValueFunction(
 		solAssert(toReferenceType->category() == fromReferenceType->category(), "");
 		solAssert(_offset.value_or(0) == 0, "");
 
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(slot, <?dynamicOffset>offset, </dynamicOffset><value>) {
 				<?dynamicOffset>if offset { <panic>() }</dynamicOffset>
 				<copyToStorage>(slot, <value>)
@@ -2645,7 +2645,7 @@ string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 				"Can only update types with location memory."
 			);
 
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(memPtr, value) {
 					mstore(memPtr, value)
 				}
@@ -2658,7 +2658,7 @@ string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 			dynamic_cast<FunctionType const&>(_type).kind() == FunctionType::Kind::External
 		)
 		{
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(memPtr, addr, selector) {
 					mstore(memPtr, <combine>(addr, selector))
 				}
@@ -2669,7 +2669,7 @@ string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 		}
 		else if (_type.isValueType())
 		{
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(memPtr, value) {
 					mstore(memPtr, <cleanup>(value))
 				}
@@ -2694,7 +2694,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 		"extract_from_storage_value_dynamic" +
 		_type.identifier();
 	return m_functionCollector.createFunction(functionName, [&] {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(slot_value, offset) -> value {
 				value := <cleanupStorage>(<shr>(mul(offset, 8), slot_value))
 			}
@@ -2710,7 +2710,7 @@ string YulUtilFunctions::extractFromStorageValue(Type const& _type, size_t _offs
 {
 	string functionName = "extract_from_storage_value_offset_" + to_string(_offset) + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&] {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(slot_value) -> value {
 				value := <cleanupStorage>(<shr>(slot_value))
 			}
@@ -2728,7 +2728,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 
 	string functionName = string("cleanup_from_storage_") + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&] {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				cleaned := <cleaned>
 			}
@@ -2769,7 +2769,7 @@ string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 		auto const* funType = dynamic_cast<FunctionType const*>(&_type);
 		if (funType && funType->kind() == FunctionType::Kind::External)
 		{
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>(addr, selector) -> ret {
 					ret := <prepareBytes>(<combine>(addr, selector))
 				}
@@ -2782,7 +2782,7 @@ string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 		else
 		{
 			solAssert(_type.sizeOnStack() == 1, "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>(value) -> ret {
 					ret := <actualPrepare>
 				}
@@ -2801,7 +2801,7 @@ string YulUtilFunctions::allocationFunction()
 {
 	string functionName = "allocate_memory";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(size) -> memPtr {
 				memPtr := <allocateUnbounded>()
 				<finalizeAllocation>(memPtr, size)
@@ -2818,7 +2818,7 @@ string YulUtilFunctions::allocateUnboundedFunction()
 {
 	string functionName = "allocate_unbounded";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := mload(<freeMemoryPointer>)
 			}
@@ -2833,7 +2833,7 @@ string YulUtilFunctions::finalizeAllocationFunction()
 {
 	string functionName = "finalize_allocation";
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(memPtr, size) {
 				let newFreePtr := add(memPtr, <roundUp>(size))
 				// protect against overflow
@@ -2862,7 +2862,7 @@ string YulUtilFunctions::zeroMemoryFunction(Type const& _type)
 
 	string functionName = "zero_memory_chunk_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
 				calldatacopy(dataStart, calldatasize(), dataSizeInBytes)
 			}
@@ -2879,7 +2879,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 	string functionName = "zero_complex_memory_array_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
 		solAssert(_type.memoryStride() == 32, "");
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
 				for {let i := 0} lt(i, dataSizeInBytes) { i := add(i, <stride>) } {
 					mstore(add(dataStart, i), <zeroValue>())
@@ -2897,7 +2897,7 @@ string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_memory_array_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 				function <functionName>(length) -> memPtr {
 					let allocSize := <allocSize>(length)
 					memPtr := <alloc>(allocSize)
@@ -2918,7 +2918,7 @@ string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType cons
 {
 	string functionName = "allocate_and_zero_memory_array_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 				function <functionName>(length) -> memPtr {
 					memPtr := <allocArray>(length)
 					let dataStart := memPtr
@@ -2943,7 +2943,7 @@ string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_memory_struct_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <alloc>(<allocSize>)
 		}
@@ -2960,7 +2960,7 @@ string YulUtilFunctions::allocateAndInitializeMemoryStructFunction(StructType co
 {
 	string functionName = "allocate_and_zero_memory_struct_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <allocStruct>()
 			let offset := memPtr
@@ -3009,7 +3009,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			"_to_" +
 			_to.identifier();
 		return m_functionCollector.createFunction(functionName, [&]() {
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(<?external>addr, </external>functionId) -> <?external>outAddr, </external>outFunctionId {
 					<?external>outAddr := addr</external>
 					outFunctionId := functionId
@@ -3043,7 +3043,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			"_to_" +
 			_to.identifier();
 		return m_functionCollector.createFunction(functionName, [&]() {
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(offset, length) -> outOffset, outLength {
 					outOffset := offset
 					outLength := length
@@ -3071,7 +3071,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 		"_to_" +
 		_to.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value) -> converted {
 				<body>
 			}
@@ -3085,14 +3085,14 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 		// Solidity++: 168-bit address
 		case Type::Category::Address:
 			body =
-				Whiskers("converted := <convert>(value)")
+				CompiledWhiskers("converted := <convert>(value)")
 					("convert", conversionFunction(IntegerType(168), _to))
 					.render();
 			break;
 		// Solidity++: Vite token id
 		case Type::Category::ViteTokenId:
 			body =
-				Whiskers("converted := <convert>(value)")
+				CompiledWhiskers("converted := <convert>(value)")
 					("convert", conversionFunction(IntegerType(80), _to))
 					.render();
 			break;
@@ -3111,7 +3111,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 				);
 				FixedBytesType const& toBytesType = dynamic_cast<FixedBytesType const&>(_to);
 				body =
-					Whiskers("converted := <shiftLeft>(<clean>(value))")
+					CompiledWhiskers("converted := <shiftLeft>(<clean>(value))")
 						("shiftLeft", shiftLeftFunction(256 - toBytesType.numBytes() * 8))
 						("clean", cleanupFunction(_from))
 						.render();
@@ -3120,7 +3120,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			{
 				solAssert(_from.mobileType(), "");
 				body =
-					Whiskers("converted := <cleanEnum>(<cleanInt>(value))")
+					CompiledWhiskers("converted := <cleanEnum>(<cleanInt>(value))")
 					("cleanEnum", cleanupFunction(_to))
 					// "mobileType()" returns integer type for rational
 					("cleanInt", cleanupFunction(*_from.mobileType()))
@@ -3132,13 +3132,13 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			// Solidity++: 168-bit address
 			else if (toCategory == Type::Category::Address)
 				body =
-					Whiskers("converted := <convert>(value)")
+					CompiledWhiskers("converted := <convert>(value)")
 						("convert", conversionFunction(_from, IntegerType(168)))
 						.render();
 			// Solidity++: Vite token id
 			else if (toCategory == Type::Category::ViteTokenId)
 				body =
-					Whiskers("converted := <convert>(value)")
+					CompiledWhiskers("converted := <convert>(value)")
 						("convert", conversionFunction(_from, IntegerType(80)))
 						.render();
 			else
@@ -3168,7 +3168,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 						cleanupType = &from;
 				}
 				body =
-					Whiskers("converted := <cleanInt>(value)")
+					CompiledWhiskers("converted := <cleanInt>(value)")
 					("cleanInt", cleanupFunction(*cleanupType))
 					.render();
 			}
@@ -3178,7 +3178,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 		{
 			solAssert(_from == _to, "Invalid conversion for bool.");
 			body =
-				Whiskers("converted := <clean>(value)")
+				CompiledWhiskers("converted := <clean>(value)")
 				("clean", cleanupFunction(_from))
 				.render();
 			break;
@@ -3201,7 +3201,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 				solUnimplementedAssert(fromStructType.location() != DataLocation::Memory, "");
 
 				if (fromStructType.location() == DataLocation::CallData)
-					body = Whiskers(R"(
+					body = CompiledWhiskers(R"(
 						converted := <abiDecode>(value, calldatasize())
 					)")
 					(
@@ -3215,7 +3215,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 				{
 					solAssert(fromStructType.location() == DataLocation::Storage, "");
 
-					body = Whiskers(R"(
+					body = CompiledWhiskers(R"(
 						converted := <readFromStorage>(value)
 					)")
 					("readFromStorage", readFromStorage(toStructType, 0, true))
@@ -3230,20 +3230,20 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			FixedBytesType const& from = dynamic_cast<FixedBytesType const&>(_from);
 			if (toCategory == Type::Category::Integer)
 				body =
-					Whiskers("converted := <convert>(<shift>(value))")
+					CompiledWhiskers("converted := <convert>(<shift>(value))")
 					("shift", shiftRightFunction(256 - from.numBytes() * 8))
 					("convert", conversionFunction(IntegerType(from.numBytes() * 8), _to))
 					.render();
 			// Solidity++: 168-bit address
 			else if (toCategory == Type::Category::Address)
 				body =
-					Whiskers("converted := <convert>(value)")
+					CompiledWhiskers("converted := <convert>(value)")
 						("convert", conversionFunction(_from, IntegerType(168)))
 						.render();
 			// Solidity++: Vite token id
 			else if (toCategory == Type::Category::ViteTokenId)
 				body =
-					Whiskers("converted := <convert>(value)")
+					CompiledWhiskers("converted := <convert>(value)")
 						("convert", conversionFunction(_from, IntegerType(80)))
 						.render();
 			else
@@ -3251,7 +3251,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 				// clear for conversion to longer bytes
 				solAssert(toCategory == Type::Category::FixedBytes, "Invalid type conversion requested.");
 				body =
-					Whiskers("converted := <clean>(value)")
+					CompiledWhiskers("converted := <clean>(value)")
 					("clean", cleanupFunction(from))
 					.render();
 			}
@@ -3267,7 +3267,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			solAssert(toCategory == Type::Category::Integer || _from == _to, "");
 			EnumType const& enumType = dynamic_cast<decltype(enumType)>(_from);
 			body =
-				Whiskers("converted := <clean>(value)")
+				CompiledWhiskers("converted := <clean>(value)")
 				("clean", cleanupFunction(enumType))
 				.render();
 			break;
@@ -3318,7 +3318,7 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 		_to.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(slot, value) {
 				<?fromStorage> if iszero(eq(slot, value)) { </fromStorage>
 				<#member>
@@ -3342,7 +3342,7 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 			solAssert(memberType.memoryHeadSize() == 32, "");
 			auto const&[slotDiff, offset] = _to.storageOffsetsOfMember(structMembers[i].name);
 
-			Whiskers t(R"(
+			CompiledWhiskers t(R"(
 				let memberSlot := add(slot, <memberStorageSlotDiff>)
 				let memberSrcPtr := add(value, <memberOffset>)
 
@@ -3440,7 +3440,7 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 		_to.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value<?fromCalldataDynamic>, length</fromCalldataDynamic>) -> converted {
 				<body>
 			}
@@ -3457,7 +3457,7 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 		else if (_to.dataStoredIn(DataLocation::Memory))
 			templ(
 				"body",
-				Whiskers(R"(
+				CompiledWhiskers(R"(
 					// Copy the array to a free position in memory
 					converted :=
 					<?fromStorage>
@@ -3497,7 +3497,7 @@ string YulUtilFunctions::cleanupFunction(Type const& _type)
 {
 	string functionName = string("cleanup_") + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				<body>
 			}
@@ -3600,7 +3600,7 @@ string YulUtilFunctions::validatorFunction(Type const& _type, bool _revertOnFail
 {
 	string functionName = string("validator_") + (_revertOnFailure ? "revert_" : "assert_") + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(value) {
 				if iszero(<condition>) { <failure> }
 			}
@@ -3659,15 +3659,21 @@ string YulUtilFunctions::packedHashFunction(
 {
 	string functionName = string("packed_hashed_");
 	for (auto const& t: _givenTypes)
-		functionName += t->identifier() + "_";
+	{
+		functionName += t->identifier();
+		functionName += '_';
+	}
 	functionName += "_to_";
 	for (auto const& t: _targetTypes)
-		functionName += t->identifier() + "_";
+	{
+		functionName += t->identifier();
+		functionName += '_';
+	}
 	size_t sizeOnStack = 0;
 	for (Type const* t: _givenTypes)
 		sizeOnStack += t->sizeOnStack();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(<variables>) -> hash {
 				let pos := <allocateUnbounded>()
 				let end := <packedEncode>(pos <comma> <variables>)
@@ -3689,7 +3695,7 @@ string YulUtilFunctions::forwardingRevertFunction()
 	string functionName = "revert_forward_" + to_string(forward);
 	return m_functionCollector.createFunction(functionName, [&]() {
 		if (forward)
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>() {
 					returndatacopy(0, 0, returndatasize())
 					revert(0, returndatasize())
@@ -3698,7 +3704,7 @@ string YulUtilFunctions::forwardingRevertFunction()
 			("functionName", functionName)
 			.render();
 		else
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>() {
 					revert(0, 0)
 				}
@@ -3716,7 +3722,7 @@ std::string YulUtilFunctions::decrementCheckedFunction(Type const& _type)
 	string const functionName = "decrement_" + _type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
 				if eq(value, <minval>) { <panic>() }
@@ -3739,7 +3745,7 @@ std::string YulUtilFunctions::decrementWrappingFunction(Type const& _type)
 	string const functionName = "decrement_wrapping_" + _type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(value, 1))
 			}
@@ -3758,7 +3764,7 @@ std::string YulUtilFunctions::incrementCheckedFunction(Type const& _type)
 	string const functionName = "increment_" + _type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
 				if eq(value, <maxval>) { <panic>() }
@@ -3781,7 +3787,7 @@ std::string YulUtilFunctions::incrementWrappingFunction(Type const& _type)
 	string const functionName = "increment_wrapping_" + _type.identifier();
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(add(value, 1))
 			}
@@ -3800,7 +3806,7 @@ string YulUtilFunctions::negateNumberCheckedFunction(Type const& _type)
 
 	string const functionName = "negate_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
 				if eq(value, <minval>) { <panic>() }
@@ -3823,7 +3829,7 @@ string YulUtilFunctions::negateNumberWrappingFunction(Type const& _type)
 
 	string const functionName = "negate_" + _type.identifier();
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(0, value))
 			}
@@ -3843,7 +3849,7 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 	return m_functionCollector.createFunction(functionName, [&]() {
 		FunctionType const* fType = dynamic_cast<FunctionType const*>(&_type);
 		if (fType && fType->kind() == FunctionType::Kind::External && _splitFunctionTypes)
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>() -> retAddress, retFunction {
 					retAddress := 0
 					retFunction := 0
@@ -3858,7 +3864,7 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 				_type.category() == Type::Category::Struct ||
 				_type.category() == Type::Category::Array,
 			"");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>() -> offset<?hasLength>, length</hasLength> {
 					offset := calldatasize()
 					<?hasLength> length := 0 </hasLength>
@@ -3873,7 +3879,7 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 			return templ.render();
 		}
 
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>() -> ret {
 				ret := <zeroValue>
 			}
@@ -3915,7 +3921,7 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 
 	return m_functionCollector.createFunction(functionName, [&]() {
 		if (_type.isValueType())
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot, offset) {
 					<store>(slot, offset, <zeroValue>())
 				}
@@ -3925,7 +3931,7 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 			("zeroValue", zeroValueFunction(_type))
 			.render();
 		else if (_type.category() == Type::Category::Array)
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot, offset) {
 					if iszero(eq(offset, 0)) { <panic>() }
 					<clearArray>(slot)
@@ -3936,7 +3942,7 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 			("panic", panicFunction(PanicCode::Generic))
 			.render();
 		else if (_type.category() == Type::Category::Struct)
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(slot, offset) {
 					if iszero(eq(offset, 0)) { <panic>() }
 					<clearStruct>(slot)
@@ -3985,7 +3991,7 @@ string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const
 				}
 				sourceStackSize += fromComponent->sizeOnStack();
 			}
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(<values>) <arrow> <converted> {
 					<conversions>
 				}
@@ -4007,7 +4013,7 @@ string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const
 		{
 			unsigned const numBytes = dynamic_cast<FixedBytesType const&>(_to).numBytes();
 			solAssert(data.size() <= 32, "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>() -> converted {
 					converted := <data>
 				}
@@ -4022,7 +4028,7 @@ string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const
 		else if (_to.category() == Type::Category::Array)
 		{
 			solAssert(dynamic_cast<ArrayType const&>(_to).isByteArray(), "");
-			Whiskers templ(R"(
+			CompiledWhiskers templ(R"(
 				function <functionName>() -> converted {
 					converted := <copyLiteralToMemory>()
 				}
@@ -4056,7 +4062,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 			solAssert(refType->sizeOnStack() == 1, "");
 			solAssert(!_fromCalldata, "");
 
-			return Whiskers(R"(
+			return CompiledWhiskers(R"(
 				function <functionName>(memPtr) -> value {
 					value := mload(memPtr)
 				}
@@ -4066,7 +4072,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 		}
 
 		solAssert(_type.isValueType(), "");
-		Whiskers templ(R"(
+		CompiledWhiskers templ(R"(
 			function <functionName>(ptr) -> <returnVariables> {
 				<?fromCalldata>
 					let value := calldataload(ptr)
@@ -4111,7 +4117,7 @@ string YulUtilFunctions::revertReasonIfDebug(RevertStrings revertStrings, string
 {
 	if (revertStrings >= RevertStrings::Debug && !_message.empty())
 	{
-		Whiskers templ(R"({
+		CompiledWhiskers templ(R"({
 			mstore(0, <sig>)
 			mstore(4, 0x20)
 			mstore(add(4, 0x20), <length>)
@@ -4149,7 +4155,7 @@ string YulUtilFunctions::panicFunction(util::PanicCode _code)
 {
 	string functionName = "panic_error_" + toCompactHexWithPrefix(uint64_t(_code));
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+		return CompiledWhiskers(R"(
 			function <functionName>() {
 				mstore(0, <selector>)
 				mstore(4, <code>)
@@ -4169,7 +4175,7 @@ string YulUtilFunctions::returnDataSelectorFunction()
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return util::Whiskers(R"(
+		return util::CompiledWhiskers(R"(
 			function <functionName>() -> sig {
 				if gt(returndatasize(), 3) {
 					returndatacopy(0, 0, 4)
@@ -4189,7 +4195,7 @@ string YulUtilFunctions::tryDecodeErrorMessageFunction()
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return util::Whiskers(R"(
+		return util::CompiledWhiskers(R"(
 			function <functionName>() -> ret {
 				if lt(returndatasize(), 0x44) { leave }
 
@@ -4228,7 +4234,7 @@ string YulUtilFunctions::tryDecodePanicDataFunction()
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return util::Whiskers(R"(
+		return util::CompiledWhiskers(R"(
 			function <functionName>() -> success, data {
 				if gt(returndatasize(), 0x23) {
 					returndatacopy(0, 4, 0x20)
@@ -4247,7 +4253,7 @@ string YulUtilFunctions::extractReturndataFunction()
 	string const functionName = "extract_returndata";
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return util::Whiskers(R"(
+		return util::CompiledWhiskers(R"(
 			function <functionName>() -> data {
 				<?supportsReturndata>
 					switch returndatasize()
@@ -4287,7 +4293,7 @@ string YulUtilFunctions::copyConstructorArgumentsToMemoryFunction(
 		string returnParams = suffixedVariableNameList("ret_param_",0, _contract.constructor()->parameters().size());
 		ABIFunctions abiFunctions(m_evmVersion, m_revertStrings, m_functionCollector);
 
-		return util::Whiskers(R"(
+		return util::CompiledWhiskers(R"(
 			function <functionName>() -> <retParams> {
 				let programSize := datasize("<object>")
 				let argSize := sub(codesize(), programSize)
@@ -4312,7 +4318,7 @@ string YulUtilFunctions::externalCodeFunction()
 	string functionName = "external_code_at";
 
 	return m_functionCollector.createFunction(functionName, [&]() {
-		return util::Whiskers(R"(
+		return util::CompiledWhiskers(R"(
 			function <functionName>(addr) -> mpos {
 				let length := extcodesize(addr)
 				mpos := <allocateArray>(length)
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Process-wide cache of optimised Yul utility functions.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolidity/codegen/YulUtilityCache.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace
+{
+/// Changes whenever the format of the cached code or of the key changes.
+string const c_cacheVersion = "2";
+}
+
+YulUtilityCache& YulUtilityCache::instance()
+{
+	static YulUtilityCache cache;
+	return cache;
+}
+
+h256 YulUtilityCache::key(
+	string const& _code,
+	set<string> const& _externallyUsedFunctions,
+	OptimiserSettings const& _settings,
+	langutil::EVMVersion _evmVersion,
+	bool _isCreation
+)
+{
+	string key = c_cacheVersion + "\n";
+	key += SolidityppVersionString + "\n";
+	key += _evmVersion.name() + "\n";
+	key += (_isCreation ? "creation\n" : "runtime\n");
+	for (bool step: {
+		_settings.runOrderLiterals,
+		_settings.runJumpdestRemover,
+		_settings.runPeephole,
+		_settings.runDeduplicate,
+		_settings.runCSE,
+		_settings.runConstantOptimiser,
+		_settings.runYulOptimiser,
+		_settings.optimizeStackAllocation
+	})
+		key += step ? "1" : "0";
+	key += "\n" + _settings.yulOptimiserSteps + "\n";
+	key += to_string(_settings.expectedExecutionsPerDeployment) + "\n";
+	for (string const& function: _externallyUsedFunctions)
+		key += function + ",";
+	key += "\n" + _code;
+	return keccak256(key);
+}
+
+optional<string> YulUtilityCache::find(h256 const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (auto it = m_entries.find(_key); it != m_entries.end())
+	{
+		++m_hits;
+		m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+		return it->second.code;
+	}
+
+	if (!m_directory.empty())
+		if (optional<string> code = readFile(_key))
+		{
+			++m_hits;
+			remember(_key, *code);
+			return code;
+		}
+
+	++m_misses;
+	return nullopt;
+}
+
+void YulUtilityCache::insert(h256 const& _key, string _optimisedCode)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (!m_directory.empty())
+		writeFile(_key, _optimisedCode);
+	remember(_key, move(_optimisedCode));
+}
+
+void YulUtilityCache::setDirectory(boost::filesystem::path _directory)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (!_directory.empty())
+	{
+		boost::system::error_code error;
+		boost::filesystem::create_directories(_directory, error);
+	}
+	m_directory = move(_directory);
+}
+
+void YulUtilityCache::setMemoryLimit(size_t _bytes)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_memoryLimit = _bytes;
+	evict();
+}
+
+void YulUtilityCache::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.clear();
+	m_recency.clear();
+	m_memoryUsed = 0;
+	m_hits = 0;
+	m_misses = 0;
+}
+
+boost::filesystem::path YulUtilityCache::filePath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".yul");
+}
+
+optional<string> YulUtilityCache::readFile(h256 const& _key) const
+{
+	// The first line is the hash of the code that follows it.
+	boost::filesystem::path path = filePath(_key);
+	ifstream file(path.string(), ios::binary);
+	if (!file)
+		return nullopt;
+	string checksum;
+	stringstream code;
+	if (getline(file, checksum) && (code << file.rdbuf() || file.eof()))
+	{
+		string content = code.str();
+		if (checksum == keccak256(content).hex())
+			return content;
+	}
+	// Truncated or corrupted, e.g. by a crash or a full disk. It is written again once regenerated.
+	file.close();
+	boost::system::error_code error;
+	boost::filesystem::remove(path, error);
+	return nullopt;
+}
+
+void YulUtilityCache::writeFile(h256 const& _key, string const& _code) const
+{
+	// Write to a temporary file first, so that concurrent compiler processes never
+	// read a partially written entry.
+	boost::system::error_code error;
+	boost::filesystem::path path = filePath(_key);
+	boost::filesystem::path temporary = path;
+	temporary += "." + boost::filesystem::unique_path().string();
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		file << keccak256(_code).hex() << "\n" << _code;
+	}
+	boost::filesystem::rename(temporary, path, error);
+	if (error)
+		boost::filesystem::remove(temporary, error);
+}
+
+void YulUtilityCache::remember(h256 const& _key, string _code)
+{
+	if (auto it = m_entries.find(_key); it != m_entries.end())
+	{
+		m_memoryUsed -= it->second.code.size();
+		m_recency.erase(it->second.recency);
+		m_entries.erase(it);
+	}
+	m_memoryUsed += _code.size();
+	m_recency.push_front(_key);
+	m_entries[_key] = Entry{move(_code), m_recency.begin()};
+	evict();
+}
+
+void YulUtilityCache::evict()
+{
+	while (m_memoryUsed > m_memoryLimit && !m_recency.empty())
+	{
+		auto it = m_entries.find(m_recency.back());
+		m_memoryUsed -= it->second.code.size();
+		m_entries.erase(it);
+		m_recency.pop_back();
+	}
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Process-wide cache of optimised Yul utility functions.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Caches the optimised Yul code of the utility functions appended by
+ * CompilerContext::appendYulUtilityFunctions.
+ *
+ * Contracts of a project usually request the same ABI coder, cleanup and conversion
+ * functions. The requested code is the concatenation of the functions in name order,
+ * so identical sets of functions produce identical code and running the Yul optimiser
+ * on it again can be skipped.
+ *
+ * Entries are stored as printed Yul code, which does not depend on the YulStringRepository
+ * and can therefore be kept for the whole process and, if a directory is set, on disk.
+ * The key covers the compiler version and all optimiser settings, so a directory can be
+ * shared between compiler versions. Files on disk carry a checksum of the code; an entry
+ * that does not match it is deleted and regenerated. In memory, the least recently used
+ * entries are dropped once their total size exceeds the memory limit.
+ */
+class YulUtilityCache
+{
+public:
+	static YulUtilityCache& instance();
+
+	/// @returns the key of the utility code @a _code optimised with @a _settings for
+	/// the creation or runtime context by this compiler version.
+	static util::h256 key(
+		std::string const& _code,
+		std::set<std::string> const& _externallyUsedFunctions,
+		OptimiserSettings const& _settings,
+		langutil::EVMVersion _evmVersion,
+		bool _isCreation
+	);
+
+	/// @returns the optimised code of @a _key or nullopt.
+	/// Looks in the cache directory if the code is not in memory.
+	std::optional<std::string> find(util::h256 const& _key);
+	void insert(util::h256 const& _key, std::string _optimisedCode);
+
+	/// Enables the on-disk cache. An empty path disables it.
+	void setDirectory(boost::filesystem::path _directory);
+	/// Sets the maximum total size in bytes of the entries kept in memory.
+	void setMemoryLimit(size_t _bytes);
+	/// Drops all entries from memory and resets the statistics. Files on disk are kept.
+	void clear();
+
+	size_t hits() const { std::lock_guard<std::mutex> lock(m_mutex); return m_hits; }
+	size_t misses() const { std::lock_guard<std::mutex> lock(m_mutex); return m_misses; }
+
+private:
+	YulUtilityCache() = default;
+
+	struct Entry
+	{
+		std::string code;
+		std::list<util::h256>::iterator recency;
+	};
+
+	boost::filesystem::path filePath(util::h256 const& _key) const;
+	/// @returns the code stored on disk for @a _key if its checksum matches.
+	std::optional<std::string> readFile(util::h256 const& _key) const;
+	void writeFile(util::h256 const& _key, std::string const& _code) const;
+	/// Stores @a _code in memory and drops old entries to stay within the memory limit.
+	void remember(util::h256 const& _key, std::string _code);
+	/// Drops the least recently used entries until the entries fit into the memory limit.
+	void evict();
+
+	mutable std::mutex m_mutex;
+	std::map<util::h256, Entry> m_entries;
+	/// Keys of m_entries, most recently used first.
+	std::list<util::h256> m_recency;
+	size_t m_memoryUsed = 0;
+	size_t m_memoryLimit = 64 * 1024 * 1024;
+	boost::filesystem::path m_directory;
+	size_t m_hits = 0;
+	size_t m_misses = 0;
+};
+
+}
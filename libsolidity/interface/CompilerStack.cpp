@@ -23,12 +23,15 @@
 #include <libsolidity/analysis/Scoper.h>
 #include <libsolidity/analysis/SolidityppTypeChecker.h>
 #include <libsolidity/analysis/ViewPureChecker.h>
+#include <libsolidity/analysis/AwaitLivenessAnalyser.h>
 #include <libsolidity/analysis/ImmutableValidator.h>
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
+#include <libsolidity/ast/ASTSnapshot.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
 #include <libsolidity/interface/Natspec.h>
@@ -55,6 +58,7 @@
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Parallel.h>
 
 #include <json/json.h>
 
@@ -223,6 +227,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	m_inlineAssemblyCache.reset();
 	TypeProvider::reset();
 }
 
@@ -232,7 +237,8 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	// Solidity++: the contents are moved, so that every source is held by its CharStream only.
+	for (auto& source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
 }
@@ -265,11 +271,10 @@ bool CompilerStack::parse()
 		{
 			source.ast->annotation().path = path;
 			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast, path))
+				for (auto& newSource: loadMissingSources(*source.ast, path))
 				{
 					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(std::move(newSource.second), newPath));
 					sourcesToParse.push_back(newPath);
 				}
 		}
@@ -310,6 +315,21 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 	storeContractDefinitions();
 }
 
+void CompilerStack::importASTSnapshot(string_view _snapshot)
+{
+	if (m_stackState != Empty)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call importASTSnapshot only before the SourcesSet state."));
+	for (auto& [name, snapshotSource]: ASTSnapshotReader(m_evmVersion).read(_snapshot))
+	{
+		Source& source = m_sources[name];
+		source.scanner = move(snapshotSource.scanner);
+		source.ast = move(snapshotSource.ast);
+	}
+	m_stackState = ParsedAndImported;
+
+	storeContractDefinitions();
+}
+
 bool CompilerStack::analyze()
 {
     debug("Analyzing...");
@@ -317,25 +337,84 @@ bool CompilerStack::analyze()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
 	resolveImports();
 
-	for (Source const* source: m_sourceOrder)
-		if (source->ast)
-			Scoper::assignScopes(*source->ast);
-
 	bool noErrors = true;
 
 	try
 	{
-	    debug("Syntax checking...");
-	    SolidityppSyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+		// Solidity++: scoping, syntax checking and doc string parsing only look at one source
+		// unit, so the sources are processed concurrently, each with its own error lists.
+		// The lists are merged in source order and a fatal error stops the merge, so errors
+		// come out as if the passes had run over one source after the other. The errors are
+		// reported again instead of appended, so that the limits on the number of errors and
+		// warnings of m_errorReporter hold for all sources together.
+	    debug("Syntax checking and doc strings parsing...");
+		struct SourceLocalResult
+		{
+			ErrorList syntaxErrors;
+			ErrorList docStringErrors;
+			bool syntaxValid = true;
+			bool docStringsValid = true;
+			bool syntaxFatal = false;
+			bool docStringsFatal = false;
+		};
+		vector<SourceLocalResult> localResults(m_sourceOrder.size());
+		util::parallelFor(m_sourceOrder.size(), m_threads, [&](size_t _index) {
+			SourceUnit const* ast = m_sourceOrder[_index]->ast.get();
+			if (!ast)
+				return;
+			SourceLocalResult& result = localResults[_index];
+			Scoper::assignScopes(*ast);
+			try
+			{
+				ErrorReporter errorReporter(result.syntaxErrors);
+				SolidityppSyntaxChecker syntaxChecker(errorReporter, m_optimiserSettings.runYulOptimiser);
+				result.syntaxValid = syntaxChecker.checkSyntax(*ast);
+			}
+			catch (FatalError const&)
+			{
+				result.syntaxFatal = true;
+				return;
+			}
+			try
+			{
+				ErrorReporter errorReporter(result.docStringErrors);
+				result.docStringsValid = DocStringTagParser(errorReporter).parseDocStrings(*ast);
+			}
+			catch (FatalError const&)
+			{
+				result.docStringsFatal = true;
+			}
+		});
+		auto merge = [&](ErrorList const& _errors) {
+			for (shared_ptr<Error const> const& error: _errors)
+			{
+				SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+				SecondarySourceLocation const* secondaryLocation = boost::get_error_info<errinfo_secondarySourceLocation>(*error);
+				m_errorReporter.error(
+					error->errorId(),
+					error->type(),
+					location ? *location : SourceLocation(),
+					secondaryLocation ? *secondaryLocation : SecondarySourceLocation(),
+					error->what()
+				);
+			}
+		};
+		for (SourceLocalResult const& result: localResults)
+		{
+			merge(result.syntaxErrors);
+			if (result.syntaxFatal)
+				BOOST_THROW_EXCEPTION(FatalError());
+			if (!result.syntaxValid)
 				noErrors = false;
-
-        debug("Doc strings parsing...");
-		DocStringTagParser DocStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !DocStringTagParser.parseDocStrings(*source->ast))
+		}
+		for (SourceLocalResult const& result: localResults)
+		{
+			merge(result.docStringErrors);
+			if (result.docStringsFatal)
+				BOOST_THROW_EXCEPTION(FatalError());
+			if (!result.docStringsValid)
 				noErrors = false;
+		}
 
 		m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
@@ -459,6 +538,19 @@ bool CompilerStack::analyze()
 				noErrors = false;
 		}
 
+		if (noErrors)
+		{
+			// Solidity++: build the selector tables once, before they are shared by
+			// code generation and the outputs.
+			for (Source const* source: m_sourceOrder)
+				if (source->ast)
+					for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+					{
+						contract->interfaceFunctionTable(false);
+						contract->interfaceFunctionTable(true);
+					}
+		}
+
 		if (noErrors)
 		{
             debug("Model checking...");
@@ -537,6 +629,7 @@ bool CompilerStack::compile(State _stopAfter)
 
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	m_inlineAssemblyCache = make_shared<InlineAssemblyCache>();
 
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
@@ -588,6 +681,11 @@ bool CompilerStack::compile(State _stopAfter)
 							throw;
 					}
 				}
+	debug(
+		"Inline assembly cache: " + to_string(m_inlineAssemblyCache->hits()) + " hits, " +
+		to_string(m_inlineAssemblyCache->misses()) + " misses."
+	);
+	m_inlineAssemblyCache.reset();
 	m_stackState = CompilationSuccessful;
 	this->link();
 	debug("Compiled.");
@@ -647,7 +745,7 @@ evmasm::AssemblyItems const* CompilerStack::runtimeAssemblyItems(string const& _
 	return currentContract.evmRuntimeAssembly ? &currentContract.evmRuntimeAssembly->items() : nullptr;
 }
 
-Json::Value CompilerStack::generatedSources(string const& _contractName, bool _runtime) const
+Json::Value const& CompilerStack::generatedSources(string const& _contractName, bool _runtime) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -657,6 +755,7 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 		_runtime ?
 		c.runtimeGeneratedSources :
 		c.generatedSources;
+	lock_guard<mutex> lock(c.lazyInitMutex);
 	return sources.init([&]{
 		Json::Value sources{Json::arrayValue};
 		// If there is no compiler, then no bytecode was generated and thus no
@@ -674,6 +773,7 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 				ErrorList errors;
 				ErrorReporter errorReporter(errors);
 				auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(source, sourceName));
+				lock_guard<mutex> yulStringLock(m_yulStringMutex);
 				yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
 				shared_ptr<yul::Block> parserResult = yul::Parser{errorReporter, dialect}.parse(scanner, false);
 				solAssert(parserResult, "");
@@ -695,6 +795,7 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& c = contract(_contractName);
+	lock_guard<mutex> lock(c.lazyInitMutex);
 	if (!c.sourceMapping)
 	{
 		if (auto items = assemblyItems(_contractName))
@@ -709,6 +810,7 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& c = contract(_contractName);
+	lock_guard<mutex> lock(c.lazyInitMutex);
 	if (!c.runtimeSourceMapping)
 	{
 		if (auto items = runtimeAssemblyItems(_contractName))
@@ -792,14 +894,19 @@ evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contract
 }
 
 /// TODO: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
-		return currentContract.evmAssembly->assemblyString(_sourceCodes);
+		return currentContract.evmAssembly->assemblyString([&](string const& _sourceName) -> string const* {
+			auto it = m_sources.find(_sourceName);
+			if (it == m_sources.end() || !it->second.scanner)
+				return nullptr;
+			return &it->second.scanner->source();
+		});
 	else
 		return string();
 }
@@ -851,6 +958,7 @@ Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	lock_guard<recursive_mutex> lock(m_typeSystemMutex);
 	return _contract.abi.init([&]{ return ABI::generate(*_contract.contract); });
 }
 
@@ -869,7 +977,24 @@ Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.storageLayout.init([&]{ return StorageLayout().generate(*_contract.contract); });
+	lock_guard<recursive_mutex> lock(m_typeSystemMutex);
+	return _contract.storageLayout.init([&]{
+		Json::Value layout = StorageLayout().generate(*_contract.contract);
+		// Solidity++: report the slots saved by "pragma storagelayout packed"
+		ContractType const* contractType = TypeProvider::contract(*_contract.contract);
+		if (contractType->hasPackedStorage())
+		{
+			u256 slots = contractType->storageSlots();
+			u256 declarationOrderSlots = contractType->storageSlots(true);
+			solAssert(slots <= declarationOrderSlots, "");
+			Json::Value packing(Json::objectValue);
+			packing["slots"] = slots.str();
+			packing["declarationOrderSlots"] = declarationOrderSlots.str();
+			packing["slotsSaved"] = u256(declarationOrderSlots - slots).str();
+			layout["packing"] = move(packing);
+		}
+		return layout;
+	});
 }
 
 Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
@@ -887,6 +1012,7 @@ Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	lock_guard<recursive_mutex> lock(m_typeSystemMutex);
 	return _contract.userDocumentation.init([&]{ return Natspec::userDocumentation(*_contract.contract); });
 }
 
@@ -905,6 +1031,7 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	lock_guard<recursive_mutex> lock(m_typeSystemMutex);
 	return _contract.devDocumentation.init([&]{ return Natspec::devDocumentation(*_contract.contract); });
 }
 
@@ -914,11 +1041,52 @@ Json::Value CompilerStack::methodIdentifiers(string const& _contractName) const
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
 	Json::Value methodIdentifiers(Json::objectValue);
-	for (auto const& it: contractDefinition(_contractName).interfaceFunctions())
+	for (auto const& it: contractDefinition(_contractName).interfaceFunctionTable())
 		methodIdentifiers[it.second->externalSignature()] = it.first.hex();
 	return methodIdentifiers;
 }
 
+// Solidity++: liveness of local variables across awaits
+Json::Value CompilerStack::awaitReport(string const& _contractName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	auto names = [](vector<VariableDeclaration const*> const& _variables) {
+		Json::Value result(Json::arrayValue);
+		for (VariableDeclaration const* variable: _variables)
+			result.append(variable->name());
+		return result;
+	};
+
+	Json::Value awaits(Json::arrayValue);
+	for (AwaitLiveness const& liveness: AwaitLivenessAnalyser().analyse(contractDefinition(_contractName)))
+	{
+		SourceLocation const& location = liveness.await->location();
+		int line;
+		int column;
+		tie(line, column, ignore, ignore) = positionFromSourceLocation(location);
+
+		Json::Value await(Json::objectValue);
+		if (auto function = dynamic_cast<FunctionDefinition const*>(liveness.callable))
+			await["function"] = function->isConstructor() ? "constructor" : function->name();
+		else
+			await["modifier"] = liveness.callable->name();
+		await["source"] = location.source->name();
+		await["line"] = line;
+		await["column"] = column;
+		await["live"] = names(liveness.live);
+		await["liveMemory"] = names(liveness.liveMemory);
+		await["liveSlots"] = Json::UInt64(liveness.liveSlots);
+		await["slotsInScope"] = Json::UInt64(liveness.slotsInScope);
+		awaits.append(move(await));
+	}
+
+	Json::Value report(Json::objectValue);
+	report["awaits"] = move(awaits);
+	return report;
+}
+
 string const& CompilerStack::metadata(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -942,6 +1110,7 @@ string const& CompilerStack::metadata(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
+	lock_guard<recursive_mutex> lock(m_typeSystemMutex);
 	return _contract.metadata.init([&]{ return createMetadata(_contract); });
 }
 
@@ -963,6 +1132,28 @@ SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 	return *source(_sourceName).ast;
 }
 
+SourceUnit const* CompilerStack::astIfParsed(string const& _sourceName) const
+{
+	if (m_stackState < Parsed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing not yet performed."));
+	return source(_sourceName).ast.get();
+}
+
+string CompilerStack::astSnapshot() const
+{
+	if (m_stackState < Parsed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing not yet performed."));
+
+	ASTSnapshotWriter writer;
+	for (auto const& [name, source]: m_sources)
+	{
+		if (!source.ast)
+			BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing was not successful."));
+		writer.addSource(name, source.scanner->source(), *source.ast);
+	}
+	return writer.snapshot();
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1051,7 +1242,7 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources[importPath] = std::move(result.responseOrErrorMessage);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1193,7 +1384,7 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_verbose);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_verbose, m_inlineAssemblyCache);
 	compiledContract.compiler = compiler;
 
 //	 bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
@@ -1662,7 +1853,7 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
 		Json::Value externalFunctions(Json::objectValue);
-		for (auto it: contract.interfaceFunctions())
+		for (auto const& it: contract.interfaceFunctionTable())
 		{
 			string sig = it.second->externalSignature();
 			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
@@ -32,9 +32,11 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace solidity::langutil
@@ -60,6 +62,7 @@ class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class InlineAssemblyCache;
 class Natspec;
 class DeclarationContainer;
 
@@ -169,6 +172,11 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Solidity++: sets the number of threads used by the concurrent passes.
+	/// 0, the default, uses one thread per hardware thread.
+	void setThreads(size_t _threads) { m_threads = _threads; }
+	size_t threads() const { return m_threads; }
+
 	/// Enable EVM Bytecode generation. This is enabled by default.
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
@@ -202,6 +210,11 @@ public:
 	/// Will throw errors if the import fails
 	void importASTs(std::map<std::string, Json::Value> const& _sources);
 
+	/// Solidity++: Imports the sources of a snapshot written by astSnapshot(). Leads to the same
+	/// internal state as parse(), including the source code. Throws InvalidAstError if the
+	/// snapshot is malformed or was written by a different compiler version.
+	void importASTSnapshot(std::string_view _snapshot);
+
 	/// Performs the analysis steps (imports, scopesetting, syntaxCheck, referenceResolving,
 	///  typechecking, staticAnalysis) on previously parsed sources.
 	/// @returns false on error.
@@ -228,6 +241,13 @@ public:
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// Solidity++: @returns the parsed source unit with the supplied name, or nullptr if
+	/// it could not be parsed.
+	SourceUnit const* astIfParsed(std::string const& _sourceName) const;
+
+	/// Solidity++: @returns a binary snapshot of all parsed sources, see importASTSnapshot().
+	std::string astSnapshot() const;
+
 	/// Helper function for logs printing. Do only use in error cases, it's quite expensive.
 	/// line and columns are numbered starting from 1 with following order:
 	/// start line, start column, end line, end column
@@ -272,7 +292,8 @@ public:
 
 	/// @returns an array containing all utility sources generated during compilation.
 	/// Format: [ { name: string, id: number, language: "Yul", contents: string }, ... ]
-	Json::Value generatedSources(std::string const& _contractName, bool _runtime = false) const;
+	/// Computed on the first request.
+	Json::Value const& generatedSources(std::string const& _contractName, bool _runtime = false) const;
 
 	/// @returns the string that provides a mapping between bytecode and sourcecode or a nullptr
 	/// if the contract does not (yet) have bytecode.
@@ -283,9 +304,10 @@ public:
 	std::string const* runtimeSourceMapping(std::string const& _contractName) const;
 
 	/// @return a verbose text representation of the assembly.
-	/// @arg _sourceCodes is the map of input files to source code strings
+	/// Solidity++: the source snippets are taken from the sources held by the stack, so the
+	/// caller does not need to keep its own copy of them.
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName) const;
 
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
@@ -311,6 +333,13 @@ public:
 	/// @returns a JSON representing a map of method identifiers (hashes) to function names.
 	Json::Value methodIdentifiers(std::string const& _contractName) const;
 
+	/// Solidity++:
+	/// @returns a JSON listing, for each await of the contract, the local variables in scope
+	/// and the ones that are live across the suspension, with their stack size.
+	/// The generated code saves all of them; dead slots are reported, not removed.
+	/// Prerequisite: Successful call to parse or compile.
+	Json::Value awaitReport(std::string const& _contractName) const;
+
 	/// @returns the Contract Metadata
 	std::string const& metadata(std::string const& _contractName) const;
 
@@ -360,6 +389,9 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// Solidity++: guards the source mappings and generated sources, which are
+		/// initialised when the artifacts of several contracts are collected concurrently.
+		mutable std::mutex lazyInitMutex;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -486,6 +518,16 @@ private:
 	bool m_hasError = false;
 	bool m_release = VersionIsRelease;
 	bool m_verbose = false;  // Solidity++
+	/// Solidity++: inline assembly snippets shared by the code generators of all contracts of a compilation.
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
+	/// Solidity++: number of threads of the concurrent passes, 0 for one per hardware thread.
+	size_t m_threads = 0;
+	/// Solidity++: guards the lazily initialised artifacts that are computed from the type
+	/// system (ABI, storage layout, documentation, metadata). The type system is shared by
+	/// all contracts, so they are not computed concurrently even for different contracts.
+	mutable std::recursive_mutex m_typeSystemMutex;
+	/// Solidity++: guards the YulStringRepository while generated sources are parsed.
+	mutable std::mutex m_yulStringMutex;
 };
 
 }
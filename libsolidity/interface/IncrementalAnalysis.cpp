@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Re-analysis of the changed sources of a project, for editor integration.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolidity/interface/IncrementalAnalysis.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <liblangutil/Scanner.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+void IncrementalAnalysis::setSource(string const& _name, string _content)
+{
+	auto [it, inserted] = m_sources.try_emplace(_name);
+	if (inserted)
+		m_sourceSetChanged = true;
+	else if (it->second.content == _content)
+		return;
+	it->second.content = move(_content);
+	it->second.outOfDate = true;
+}
+
+void IncrementalAnalysis::removeSource(string const& _name)
+{
+	if (!m_sources.count(_name))
+		return;
+	for (string const& dependent: dependents(_name))
+		m_sources.at(dependent).outOfDate = true;
+	m_sources.erase(_name);
+	m_sourceSetChanged = true;
+}
+
+void IncrementalAnalysis::invalidate(string const& _name)
+{
+	if (auto it = m_sources.find(_name); it != m_sources.end())
+		it->second.outOfDate = true;
+}
+
+void IncrementalAnalysis::adopt(shared_ptr<CompilerStack> _compiler)
+{
+	solAssert(_compiler && _compiler->state() >= CompilerStack::State::Parsed, "");
+	m_compiler = move(_compiler);
+	for (auto& [name, source]: m_sources)
+		source.outOfDate = true;
+	for (string const& name: m_compiler->sourceNames())
+		m_sources[name].content = m_compiler->scanner(name).source();
+	m_sourceSetChanged = false;
+	collectResults({});
+}
+
+set<string> IncrementalAnalysis::analyze(CompilerStack::State _stopAfter)
+{
+	set<string> toAnalyse;
+	for (auto const& [name, source]: m_sources)
+		if (source.outOfDate || (m_sourceSetChanged && !Error::containsOnlyWarnings(source.errors)))
+			toAnalyse.insert(name);
+	for (string const& name: set<string>(toAnalyse))
+		toAnalyse += dependents(name);
+	m_sourceSetChanged = false;
+	if (toAnalyse.empty())
+		return {};
+
+	StringMap sources;
+	for (string const& name: toAnalyse)
+		sources[name] = m_sources.at(name).content;
+
+	// The old stack has to be gone before a new one can be created.
+	solAssert(!m_compiler || m_compiler.use_count() == 1, "The compiler stack of the last analysis is still in use.");
+	m_compiler.reset();
+	m_compiler = make_shared<CompilerStack>([this](string const& _kind, string const& _path) {
+		return readFile(_kind, _path);
+	});
+	if (m_configure)
+		m_configure(*m_compiler);
+	m_compiler->setSources(move(sources));
+	if (_stopAfter > CompilerStack::State::AnalysisPerformed)
+		m_compiler->compile(_stopAfter);
+	else
+		m_compiler->parseAndAnalyze(_stopAfter);
+
+	return collectResults(toAnalyse);
+}
+
+set<string> IncrementalAnalysis::collectResults(set<string> const& _setSources)
+{
+	// Imported sources that were read through the callback are kept, so that their
+	// dependents are known and the next analysis does not have to read them again.
+	vector<string> analysed = m_compiler->sourceNames();
+	for (string const& name: analysed)
+	{
+		Source& source = m_sources[name];
+		if (!_setSources.count(name) && source.content.empty())
+			source.content = m_compiler->scanner(name).source();
+		source.outOfDate = false;
+		source.errors.clear();
+		// Without an AST, the imports of the previous analysis are kept.
+		if (SourceUnit const* ast = m_compiler->astIfParsed(name))
+		{
+			source.imports.clear();
+			for (ImportDirective const* import: ASTNode::filteredNodes<ImportDirective>(ast->nodes()))
+				if (import->annotation().absolutePath.set())
+					source.imports.insert(*import->annotation().absolutePath);
+		}
+	}
+
+	m_generalErrors.clear();
+	for (shared_ptr<Error const> const& error: m_compiler->errors())
+	{
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+		auto it = location && location->source ? m_sources.find(location->source->name()) : m_sources.end();
+		if (it != m_sources.end())
+			it->second.errors.push_back(error);
+		else
+			m_generalErrors.push_back(error);
+	}
+
+	return {analysed.begin(), analysed.end()};
+}
+
+ErrorList const& IncrementalAnalysis::errors(string const& _name) const
+{
+	static ErrorList const noErrors;
+	auto it = m_sources.find(_name);
+	return it == m_sources.end() ? noErrors : it->second.errors;
+}
+
+set<string> IncrementalAnalysis::sourceNames() const
+{
+	set<string> names;
+	for (auto const& source: m_sources)
+		names.insert(source.first);
+	return names;
+}
+
+set<string> IncrementalAnalysis::dependents(string const& _name) const
+{
+	map<string, vector<string>> importers;
+	for (auto const& [name, source]: m_sources)
+		for (string const& import: source.imports)
+			importers[import].push_back(name);
+
+	set<string> result;
+	vector<string> toVisit{_name};
+	while (!toVisit.empty())
+	{
+		string name = move(toVisit.back());
+		toVisit.pop_back();
+		if (auto it = importers.find(name); it != importers.end())
+			for (string const& importer: it->second)
+				if (result.insert(importer).second)
+					toVisit.push_back(importer);
+	}
+	result.erase(_name);
+	return result;
+}
+
+ReadCallback::Result IncrementalAnalysis::readFile(string const& _kind, string const& _path) const
+{
+	if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+		if (auto it = m_sources.find(_path); it != m_sources.end())
+			return {true, it->second.content};
+	if (m_readFile)
+		return m_readFile(_kind, _path);
+	return {false, "File not supplied initially."};
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Re-analysis of the changed sources of a project, for editor integration.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ReadFile.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Keeps the sources of a project together with their import edges and diagnostics, and
+ * analyses only the sources that changed since the previous analysis, the sources importing
+ * them directly or indirectly, and the imports these need. Analysis results of a source only
+ * depend on the sources it imports, so the diagnostics of all other sources stay valid.
+ *
+ * What is saved is the work for the sources outside this set, nothing else is reused: every
+ * analysis creates a new compiler stack that parses and analyses the whole set again, including
+ * unchanged imports like a shared base library. The latency of an edit is therefore that of a
+ * full compilation of the edited source, its dependents and their import closure.
+ *
+ * There can only be one CompilerStack at a time, so ASTs are only available for the sources
+ * of the last analysis. A caller sharing the stack through sharedCompiler() has to release
+ * it before the next analysis.
+ */
+class IncrementalAnalysis
+{
+public:
+	/// @param _readFile callback for imports of sources that were not set.
+	/// @param _configure called on every new compiler stack before parsing, to apply settings
+	/// like the EVM version or remappings.
+	explicit IncrementalAnalysis(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::function<void(CompilerStack&)> _configure = {}
+	):
+		m_readFile(std::move(_readFile)),
+		m_configure(std::move(_configure))
+	{}
+
+	/// Sets the content of the source @a _name, the source and its dependents are analysed again
+	/// by the next call to analyze() if the content changed.
+	void setSource(std::string const& _name, std::string _content);
+	/// Removes the source @a _name, its dependents are analysed again by the next call to analyze().
+	void removeSource(std::string const& _name);
+	/// Makes the next call to analyze() analyse @a _name and its dependents, for example to have
+	/// their ASTs available.
+	void invalidate(std::string const& _name);
+
+	/// Takes over @a _compiler, which holds all sources of the project and has at least parsed
+	/// them, as the result of the last analysis. Its sources are analysed again only after
+	/// they change.
+	void adopt(std::shared_ptr<CompilerStack> _compiler);
+
+	/// Analyses the sources that are out of date.
+	/// @param _stopAfter the state the compiler stack is brought to, later states also generate code.
+	/// @returns the names of all sources that were analysed, including the imported ones.
+	std::set<std::string> analyze(CompilerStack::State _stopAfter = CompilerStack::State::AnalysisPerformed);
+
+	/// @returns the diagnostics of the last analysis of the source @a _name.
+	langutil::ErrorList const& errors(std::string const& _name) const;
+	/// @returns the diagnostics of the last analysis that do not belong to a source.
+	langutil::ErrorList const& generalErrors() const { return m_generalErrors; }
+	/// @returns the names of all sources, including the imports read through the callback.
+	std::set<std::string> sourceNames() const;
+	/// @returns the sources that import @a _name directly or indirectly.
+	std::set<std::string> dependents(std::string const& _name) const;
+	/// @returns the compiler stack of the last analysis or nullptr.
+	CompilerStack const* compiler() const { return m_compiler.get(); }
+	/// @returns the compiler stack of the last analysis or nullptr, for callers that use its
+	/// non-const interface, e.g. to output compiled contracts.
+	std::shared_ptr<CompilerStack> sharedCompiler() const { return m_compiler; }
+
+private:
+	struct Source
+	{
+		std::string content;
+		bool outOfDate = true;
+		/// Sources imported directly, as of the last analysis.
+		std::set<std::string> imports;
+		langutil::ErrorList errors;
+	};
+
+	/// Takes the content, imports and diagnostics of all sources of m_compiler.
+	/// @returns the names of these sources.
+	std::set<std::string> collectResults(std::set<std::string> const& _setSources);
+
+	/// Serves imports from m_sources before falling back to m_readFile.
+	ReadCallback::Result readFile(std::string const& _kind, std::string const& _path) const;
+
+	ReadCallback::Callback m_readFile;
+	std::function<void(CompilerStack&)> m_configure;
+	std::map<std::string, Source> m_sources;
+	/// Set if a source was added or removed, which can change the result of failed imports.
+	bool m_sourceSetChanged = false;
+	langutil::ErrorList m_generalErrors;
+	std::shared_ptr<CompilerStack> m_compiler;
+};
+
+}
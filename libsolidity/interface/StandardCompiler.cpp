@@ -33,11 +33,19 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/ViteAddress.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
 #include <optional>
+#include <system_error>
+#include <thread>
 
 using namespace std;
 using namespace solidity;
@@ -375,7 +383,7 @@ Json::Value formatImmutableReferences(map<u256, pair<string, vector<size_t>>> co
 Json::Value collectEVMObject(
 	evmasm::LinkerObject const& _object,
 	string const* _sourceMap,
-	Json::Value _generatedSources,
+	function<Json::Value()> const& _generatedSources,
 	bool _runtimeObject,
 	function<bool(string)> const& _artifactRequested
 )
@@ -392,7 +400,7 @@ Json::Value collectEVMObject(
 	if (_runtimeObject && _artifactRequested("immutableReferences"))
 		output["immutableReferences"] = formatImmutableReferences(_object.immutableReferences);
 	if (_artifactRequested("generatedSources"))
-		output["generatedSources"] = move(_generatedSources);
+		output["generatedSources"] = _generatedSources();
 	return output;
 }
 
@@ -609,6 +617,158 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 	return { std::move(settings) };
 }
 
+/// Solidity++: cache of the files read during a batch, see StandardCompiler::compileBatch().
+/// Failed reads are not cached, a later input might provide the file in its sources. Once the
+/// cached files exceed the size limit, the least recently used ones are dropped.
+class BatchReadCache
+{
+public:
+	BatchReadCache(ReadCallback::Callback _readFile, size_t _sizeLimit):
+		m_readFile(std::move(_readFile)),
+		m_sizeLimit(_sizeLimit)
+	{
+	}
+
+	ReadCallback::Result read(string const& _kind, string const& _path)
+	{
+		Key key{_kind, _path};
+		if (auto it = m_entries.find(key); it != m_entries.end())
+		{
+			m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+			return it->second.result;
+		}
+
+		ReadCallback::Result result = m_readFile(_kind, _path);
+		if (result.success && result.responseOrErrorMessage.size() <= m_sizeLimit)
+		{
+			m_size += result.responseOrErrorMessage.size();
+			m_recency.push_front(key);
+			m_entries[std::move(key)] = Entry{result, m_recency.begin()};
+			while (m_size > m_sizeLimit)
+			{
+				auto it = m_entries.find(m_recency.back());
+				m_size -= it->second.result.responseOrErrorMessage.size();
+				m_entries.erase(it);
+				m_recency.pop_back();
+			}
+		}
+		return result;
+	}
+
+private:
+	using Key = pair<string, string>;
+	struct Entry
+	{
+		ReadCallback::Result result;
+		list<Key>::iterator recency;
+	};
+
+	ReadCallback::Callback m_readFile;
+	size_t m_sizeLimit;
+	map<Key, Entry> m_entries;
+	/// Keys of m_entries, most recently used first.
+	list<Key> m_recency;
+	size_t m_size = 0;
+};
+
+/// Solidity++: reads the inputs of a batch on another thread, at most @a _capacity of them ahead
+/// of the compilation. Without read-ahead, or if no thread can be started, the inputs are read
+/// by next() itself.
+class BatchInputReader
+{
+public:
+	BatchInputReader(StandardCompiler::InputSource const& _nextInput, size_t _capacity):
+		m_nextInput(_nextInput),
+		m_capacity(_capacity)
+	{
+		if (m_capacity > 0)
+			try
+			{
+				m_reader = thread([this]() { readAhead(); });
+			}
+			catch (system_error const&)
+			{
+			}
+	}
+	~BatchInputReader()
+	{
+		if (!m_reader.joinable())
+			return;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopped = true;
+		}
+		m_changed.notify_all();
+		m_reader.join();
+	}
+
+	/// @returns false at the end of the batch. Otherwise sets @a o_input to the next input,
+	/// or to nullopt if it could not be read.
+	bool next(optional<string>& o_input)
+	{
+		if (!m_reader.joinable())
+			return read(o_input);
+
+		unique_lock<mutex> lock(m_mutex);
+		m_changed.wait(lock, [&]() { return !m_inputs.empty() || m_finished; });
+		if (m_inputs.empty())
+			return false;
+		o_input = std::move(m_inputs.front());
+		m_inputs.pop_front();
+		m_changed.notify_all();
+		return true;
+	}
+
+private:
+	bool read(optional<string>& o_input)
+	{
+		try
+		{
+			optional<string> input = m_nextInput();
+			if (!input)
+				return false;
+			o_input = std::move(input);
+		}
+		catch (...)
+		{
+			o_input = nullopt;
+		}
+		return true;
+	}
+
+	void readAhead()
+	{
+		while (true)
+		{
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_changed.wait(lock, [&]() { return m_stopped || m_inputs.size() < m_capacity; });
+				if (m_stopped)
+					return;
+			}
+			optional<string> input;
+			bool more = read(input);
+			lock_guard<mutex> lock(m_mutex);
+			if (more)
+				m_inputs.emplace_back(std::move(input));
+			else
+				m_finished = true;
+			m_changed.notify_all();
+			if (!more)
+				return;
+		}
+	}
+
+	StandardCompiler::InputSource const& m_nextInput;
+	size_t m_capacity;
+	mutex m_mutex;
+	condition_variable m_changed;
+	deque<optional<string>> m_inputs;
+	bool m_finished = false;
+	bool m_stopped = false;
+	thread m_reader;
+};
+
 }
 
 std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
@@ -654,7 +814,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = std::move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -680,7 +840,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = std::move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -849,17 +1009,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Library address is of invalid length."
 				);
 
-			try
-			{
-				ret.libraries[sourceName + ":" + library] = util::h168(util::getViteAddressHex(address));
-			}
-			catch (util::BadHexCharacter const&)
-			{
+			optional<util::h168> libraryAddress = util::decodeViteAddress(address);
+			if (!libraryAddress)
 				return formatFatalError(
 					"JSONError",
 					"Invalid library address (\"" + address + "\") supplied."
 				);
-			}
+			ret.libraries[sourceName + ":" + library] = *libraryAddress;
 		}
 	}
 
@@ -928,16 +1084,21 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	ContractSink const& _contractSink
+)
 {
 	CompilerStack compilerStack(m_readFile);
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+	// Solidity++: the sources are moved into the compiler stack, the assembly text takes its
+	// snippets from there.
+	compilerStack.setSources(std::move(_inputsAndSettings.sources));
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+	compilerStack.setThreads(m_threads);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
@@ -1112,100 +1273,135 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			output["sources"][sourceName] = sourceResult;
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
+	// Solidity++: the artifacts are collected in batches of two passes. The first pass queries
+	// the type system, which is not thread-safe. The second one only formats the finished assembly
+	// and bytecode and runs for all contracts of the batch concurrently. Contracts are processed
+	// in output order, so that they can be passed to the contract sink as soon as they are done.
+	vector<pair<string, string>> fileAndName;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
-		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](string const& _element) { return isArtifactRequested(
+		fileAndName.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	sort(fileAndName.begin(), fileAndName.end());
+
+	Json::Value contractsOutput = Json::objectValue;
+	size_t const batchSize = util::threadCount(m_threads);
+	for (size_t batchStart = 0; batchStart < fileAndName.size(); batchStart += batchSize)
+	{
+		size_t const batchEnd = min(fileAndName.size(), batchStart + batchSize);
+		vector<Json::Value> contractData(batchEnd - batchStart, Json::objectValue);
+		vector<Json::Value> evmData(batchEnd - batchStart, Json::objectValue);
+
+		for (size_t i = 0; i < batchEnd - batchStart; ++i)
+		{
+			string const& file = fileAndName[batchStart + i].first;
+			string const& name = fileAndName[batchStart + i].second;
+			string const contractName = file + ":" + name;
+
+			// ABI, storage layout, documentation and metadata
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+				contractData[i]["abi"] = compilerStack.contractABI(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+				contractData[i]["storageLayout"] = compilerStack.storageLayout(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+				contractData[i]["metadata"] = compilerStack.metadata(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+				contractData[i]["userdoc"] = compilerStack.natspecUser(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+				contractData[i]["devdoc"] = compilerStack.natspecDev(contractName);
+
+			// IR
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+				contractData[i]["ir"] = compilerStack.yulIR(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+				contractData[i]["irOptimized"] = compilerStack.yulIROptimized(contractName);
+
+			// Ewasm
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+				contractData[i]["ewasm"]["wast"] = compilerStack.ewasm(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+				contractData[i]["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
+
+			// EVM
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+				evmData[i]["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+				evmData[i]["gasEstimates"] = compilerStack.gasEstimates(contractName);
+		}
+
+		if (compilationSuccess)
+			util::parallelFor(batchEnd - batchStart, m_threads, [&](size_t i) {
+				string const& file = fileAndName[batchStart + i].first;
+				string const& name = fileAndName[batchStart + i].second;
+				string const contractName = file + ":" + name;
+
+				if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+					evmData[i]["assembly"] = compilerStack.assemblyString(contractName);
+				if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+					evmData[i]["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+
+				if (isArtifactRequested(
 					_inputsAndSettings.outputSelection,
 					file,
 					name,
-					"evm.bytecode." + _element,
+					evmObjectComponents("bytecode"),
 					wildcardMatchesExperimental
-				); }
-			);
+				))
+					evmData[i]["bytecode"] = collectEVMObject(
+						compilerStack.object(contractName),
+						compilerStack.sourceMapping(contractName),
+						[&]() { return compilerStack.generatedSources(contractName); },
+						false,
+						[&](string const& _element) { return isArtifactRequested(
+							_inputsAndSettings.outputSelection,
+							file,
+							name,
+							"evm.bytecode." + _element,
+							wildcardMatchesExperimental
+						); }
+					);
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
+				if (isArtifactRequested(
 					_inputsAndSettings.outputSelection,
 					file,
 					name,
-					"evm.deployedBytecode." + _element,
+					evmObjectComponents("deployedBytecode"),
 					wildcardMatchesExperimental
-				); }
-			);
-
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+				))
+					evmData[i]["deployedBytecode"] = collectEVMObject(
+						compilerStack.runtimeObject(contractName),
+						compilerStack.runtimeSourceMapping(contractName),
+						[&]() { return compilerStack.generatedSources(contractName, true); },
+						true,
+						[&](string const& _element) { return isArtifactRequested(
+							_inputsAndSettings.outputSelection,
+							file,
+							name,
+							"evm.deployedBytecode." + _element,
+							wildcardMatchesExperimental
+						); }
+					);
+			});
 
-		if (!contractData.empty())
+		for (size_t i = 0; i < batchEnd - batchStart; ++i)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			string const& file = fileAndName[batchStart + i].first;
+			string const& name = fileAndName[batchStart + i].second;
+			if (!evmData[i].empty())
+				contractData[i]["evm"] = move(evmData[i]);
+
+			if (contractData[i].empty())
+				continue;
+			if (_contractSink)
+				_contractSink(file, name, move(contractData[i]));
+			else
+			{
+				if (!contractsOutput.isMember(file))
+					contractsOutput[file] = Json::objectValue;
+				contractsOutput[file][name] = move(contractData[i]);
+			}
 		}
 	}
 	if (!contractsOutput.empty())
@@ -1295,7 +1491,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 					collectEVMObject(
 						*o.bytecode,
 						o.sourceMappings.get(),
-						Json::arrayValue,
+						[]() { return Json::Value{Json::arrayValue}; },
 						false,
 						[&](string const& _element) { return isArtifactRequested(
 							_inputsAndSettings.outputSelection,
@@ -1317,17 +1513,30 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile([&]() { return parseInput(_input); }, ContractSink{});
+}
+
+std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseAndReleaseInput(Json::Value& _input)
+{
+	auto parsed = parseInput(_input);
+	// The sources have been taken over and will be held by the compiler stack only.
+	_input = Json::Value();
+	return parsed;
+}
+
+Json::Value StandardCompiler::compile(InputParser const& _parse, ContractSink const& _contractSink) noexcept
 {
 	YulStringRepository::reset();
 
 	try
 	{
-		auto parsed = parseInput(_input);
+		auto parsed = _parse();
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _contractSink);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1366,7 +1575,7 @@ string StandardCompiler::compile(string const& _input) noexcept
 	}
 
 	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
+	Json::Value output = compile([&]() { return parseAndReleaseInput(input); }, ContractSink{});
 	// cout << "Output: " << output.toStyledString() << endl;
 
 	try
@@ -1378,3 +1587,97 @@ string StandardCompiler::compile(string const& _input) noexcept
 		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
+
+optional<Json::Value> StandardCompiler::parseInputJson(string const& _input, OutputSink const& _sink) noexcept
+{
+	Json::Value input;
+	string errors;
+	try
+	{
+		if (util::jsonParseStrict(_input, input, &errors))
+			return input;
+		_sink(util::jsonCompactPrint(formatFatalError("JSONError", errors)));
+	}
+	catch (...)
+	{
+		_sink("{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}");
+	}
+	return nullopt;
+}
+
+void StandardCompiler::compile(string const& _input, OutputSink const& _sink) noexcept
+{
+	if (optional<Json::Value> input = parseInputJson(_input, _sink))
+		compileToSink(std::move(*input), _sink);
+}
+
+void StandardCompiler::compileToSink(Json::Value&& _input, OutputSink const& _sink) noexcept
+{
+	// The envelope is written explicitly: first the "contracts" member, which is streamed
+	// while the contracts are collected, then the remaining members of the output in name
+	// order. Only the member values are serialized with jsonCompactPrint.
+	optional<string> currentFile;
+	auto writeContract = [&](string const& _file, string const& _name, Json::Value&& _contract)
+	{
+		string chunk;
+		if (!currentFile)
+			chunk = "{\"contracts\":{" + util::jsonCompactPrint(Json::Value(_file)) + ":{";
+		else if (*currentFile != _file)
+			chunk = "}," + util::jsonCompactPrint(Json::Value(_file)) + ":{";
+		else
+			chunk = ",";
+		currentFile = _file;
+		chunk += util::jsonCompactPrint(Json::Value(_name)) + ":" + util::jsonCompactPrint(_contract);
+		_sink(chunk);
+	};
+	Json::Value output = compile([&]() { return parseAndReleaseInput(_input); }, writeContract);
+
+	try
+	{
+		solAssert(output.isObject() && (!currentFile || !output.isMember("contracts")), "");
+		string chunk = currentFile ? "}}" : "{";
+		bool first = !currentFile;
+		for (string const& member: output.getMemberNames())
+		{
+			chunk += (first ? "" : ",") + util::jsonCompactPrint(Json::Value(member)) + ":" + util::jsonCompactPrint(output[member]);
+			first = false;
+		}
+		_sink(chunk + "}");
+	}
+	catch (...)
+	{
+		string const error = "\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		_sink(currentFile ? "}}," + error : "{" + error);
+	}
+}
+
+void StandardCompiler::compileBatch(InputSource const& _nextInput, OutputSink const& _sink) noexcept
+{
+	// Libraries shared between the inputs are only read once.
+	ReadCallback::Callback readFile = m_readFile;
+	BatchReadCache readCache(readFile, m_readCacheLimit);
+	if (readFile)
+		m_readFile = [&](string const& _kind, string const& _path) { return readCache.read(_kind, _path); };
+
+	// The input being compiled is one of the inputs in flight.
+	BatchInputReader inputs(_nextInput, m_maxInFlight - 1);
+	_sink("[");
+	optional<string> input;
+	for (bool first = true; inputs.next(input); first = false)
+	{
+		if (!first)
+			_sink(",");
+		if (!input)
+			_sink("{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error reading input.\"}]}");
+		else if (optional<Json::Value> json = parseInputJson(*input, _sink))
+		{
+			// Only the parsed input is kept while compiling, and its sources only until
+			// they have been taken over.
+			input.reset();
+			compileToSink(std::move(*json), _sink);
+		}
+		input.reset();
+	}
+	_sink("]");
+	m_readFile = std::move(readFile);
+}
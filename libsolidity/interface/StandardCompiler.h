@@ -25,6 +25,8 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <algorithm>
+#include <functional>
 #include <optional>
 #include <utility>
 #include <variant>
@@ -52,8 +54,37 @@ public:
 	Json::Value compile(Json::Value const& _input) noexcept;
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
+	/// Solidity++: the parsed JSON is released before the compilation starts, only the compiler
+	/// stack holds the sources from then on.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Solidity++: receives consecutive chunks of the serialized output.
+	using OutputSink = std::function<void(std::string const& _chunk)>;
+	/// Solidity++: like compile(std::string const&), but passes the serialized output to @a _sink
+	/// in chunks. The artifacts of each contract are serialized and passed on as soon as they
+	/// have been collected, so the output is never held completely in memory.
+	void compile(std::string const& _input, OutputSink const& _sink) noexcept;
+
+	/// Solidity++: returns the next input of a batch or nullopt at its end.
+	using InputSource = std::function<std::optional<std::string>()>;
+	/// Solidity++: compiles the independent inputs returned by @a _nextInput one after another
+	/// and passes their serialized outputs to @a _sink as a JSON array, in input order.
+	/// The next inputs are read on another thread while the current one is compiled, see
+	/// setMaxInFlight(). Files read through the read callback are cached for the whole batch,
+	/// see setReadCacheLimit(). The Yul string repository and the types are still reset for
+	/// each input, so every output is the same as that of a separate compile() call.
+	void compileBatch(InputSource const& _nextInput, OutputSink const& _sink) noexcept;
+
+	/// Solidity++: sets the number of threads used to analyse sources and to collect the
+	/// artifacts of contracts. 0, the default, uses one thread per hardware thread.
+	void setThreads(size_t _threads) { m_threads = _threads; }
+	/// Solidity++: sets the maximum number of inputs of a batch held in memory at a time,
+	/// including the one being compiled. 1 reads each input only once the previous one is done.
+	void setMaxInFlight(size_t _inputs) { m_maxInFlight = std::max<size_t>(_inputs, 1); }
+	/// Solidity++: sets the maximum total size in bytes of the files kept by the read cache of
+	/// a batch. The least recently used files are dropped first.
+	void setReadCacheLimit(size_t _bytes) { m_readCacheLimit = _bytes; }
+
 private:
 	struct InputsAndSettings
 	{
@@ -78,11 +109,30 @@ private:
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
+	/// Solidity++: like parseInput(), but clears @a _input afterwards, so that the sources
+	/// are not kept in the JSON while the compiler stack holds them.
+	std::variant<InputsAndSettings, Json::Value> parseAndReleaseInput(Json::Value& _input);
+	/// Solidity++: parses @a _input as JSON, or passes the error output to @a _sink and returns nullopt.
+	static std::optional<Json::Value> parseInputJson(std::string const& _input, OutputSink const& _sink) noexcept;
+
+	/// Receives the artifacts of a contract, in the order of the output.
+	using ContractSink = std::function<void(std::string const& _file, std::string const& _name, Json::Value&& _contract)>;
+	/// Returns the parsed input or an error, see parseInput().
+	using InputParser = std::function<std::variant<InputsAndSettings, Json::Value>()>;
+
+	/// Compiles the input returned by @a _parse. If @a _contractSink is set, the artifacts of
+	/// the contracts are passed to it instead of being included in the returned output.
+	Json::Value compile(InputParser const& _parse, ContractSink const& _contractSink) noexcept;
+	/// Compiles @a _input, which is released once parsed, and passes the serialized output to @a _sink.
+	void compileToSink(Json::Value&& _input, OutputSink const& _sink) noexcept;
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, ContractSink const& _contractSink = {});
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	size_t m_threads = 0;
+	size_t m_maxInFlight = 2;
+	size_t m_readCacheLimit = 64 * 1024 * 1024;
 };
 
 }
@@ -12,6 +12,7 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/Blake2.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ViteAddress.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -157,59 +158,30 @@ int solidity::util::checksum(string const& _data, string const& _checksum)
 
 // Solidity++: check vite address checksum
 bool solidity::util::passesViteAddressChecksum(string const& _str)
-{	
-	if (_str.size() != 55)
-		return false;
-	string hex = _str.substr(5);
-	string value = hex.substr(0, 40);
-	string checkSum = hex.substr(40, 10);
-
-	return checksum(value, checkSum) != 0;
+{
+	return decodeViteAddress(_str).has_value();
 }
 
 // Solidity++: check vite token id checksum
 bool solidity::util::passesViteTokenIdChecksum(string const& _str)
 {
-	if (_str.size() != 28)
-		return false;
-	
-	string hex = _str.substr(4);
-	string value = hex.substr(0, 20);
-	string checkSum = hex.substr(20, 4);
-
-	return checksum(value, checkSum) != 0;
+	return decodeViteTokenId(_str).has_value();
 }
 
 // Solidity++: get vite address in hex string
 string solidity::util::getViteAddressHex(string const& _addr)
 {
-	if (_addr.size() != 55)
-		return nullptr;
-
-	string hex = _addr.substr(5);
-	string value = hex.substr(0, 40);
-	string checkSum = hex.substr(40, 10);
-
-	int addressType = checksum(value, checkSum);
-	if (addressType == 0)
-		return nullptr;
-	string postfix = addressType > 0 ? "00" : "01";
-	return "0x" + value + postfix;
+	optional<h168> address = decodeViteAddress(_addr);
+	assertThrow(address, InvalidAddress, "Invalid Vite address.");
+	return "0x" + address->hex();
 }
 
 // Solidity++: get vite token id in hex string
 string solidity::util::getViteTokenIdHex(string const& _tokenid)
 {
-	if (_tokenid.size() != 28)
-		return nullptr;
-	string hex = _tokenid.substr(4);
-	string value = hex.substr(0, 20);
-	string checkSum = hex.substr(20, 4);
-
-	int result = checksum(value, checkSum);
-	if (result == 0)
-		return nullptr;
-	return "0x" + value;
+	optional<h80> tokenId = decodeViteTokenId(_tokenid);
+	assertThrow(tokenId, InvalidAddress, "Invalid Vite token id.");
+	return "0x" + tokenId->hex();
 }
 
 string solidity::util::getChecksummedAddress(string const& _addr)
@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Whiskers templates that are parsed once and rendered from indexed parameters.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolutil/CompiledWhiskers.h>
+
+#include <libsolutil/Assertions.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+struct CompiledWhiskers::Template
+{
+	enum Usage: unsigned { Value = 1, Condition = 2, List = 4 };
+
+	struct Node
+	{
+		enum class Kind { Text, Tag, List, Condition, NonEmptyCondition };
+		Kind kind = Kind::Text;
+		/// Part of the template source for text nodes.
+		string_view text;
+		size_t parameter = 0;
+		vector<Node> body;
+		vector<Node> elseBody;
+	};
+
+	string source;
+	vector<string> parameters;
+	map<string, size_t, less<>> indices;
+	vector<unsigned> usage;
+	vector<Node> nodes;
+};
+
+namespace
+{
+
+using Template = CompiledWhiskers::Template;
+using Node = Template::Node;
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the parameter name starting at @a _pos if it is followed by '>'.
+string_view parameterAt(string_view _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	if (end == _pos || end == _text.size() || _text[end] != '>')
+		return {};
+	return _text.substr(_pos, end - _pos);
+}
+
+size_t registerParameter(Template& _template, string_view _name, unsigned _usage)
+{
+	auto it = _template.indices.find(_name);
+	if (it == _template.indices.end())
+	{
+		it = _template.indices.emplace(string(_name), _template.parameters.size()).first;
+		_template.parameters.emplace_back(_name);
+		_template.usage.emplace_back(0);
+	}
+	_template.usage[it->second] |= _usage;
+	return it->second;
+}
+
+vector<Node> parse(Template& _template, string_view _text);
+
+/// Matches a tag, list or condition at @a _pos, in the order of the alternatives
+/// of the regular expression used by Whiskers.
+/// @returns the node and the position after it.
+optional<pair<Node, size_t>> matchAt(Template& _template, string_view _text, size_t _pos)
+{
+	if (string_view name = parameterAt(_text, _pos + 1); !name.empty())
+	{
+		Node node;
+		node.kind = Node::Kind::Tag;
+		node.parameter = registerParameter(_template, name, Template::Value);
+		return make_pair(move(node), _pos + name.size() + 2);
+	}
+	if (_pos + 1 >= _text.size())
+		return nullopt;
+
+	if (_text[_pos + 1] == '#')
+	{
+		string_view name = parameterAt(_text, _pos + 2);
+		if (name.empty())
+			return nullopt;
+		size_t bodyStart = _pos + name.size() + 3;
+		string close = "</" + string(name) + ">";
+		size_t closePos = _text.find(close, bodyStart);
+		if (closePos == string_view::npos)
+			return nullopt;
+		Node node;
+		node.kind = Node::Kind::List;
+		node.parameter = registerParameter(_template, name, Template::List);
+		node.body = parse(_template, _text.substr(bodyStart, closePos - bodyStart));
+		return make_pair(move(node), closePos + close.size());
+	}
+
+	if (_text[_pos + 1] == '?')
+	{
+		bool nonEmpty = _pos + 2 < _text.size() && _text[_pos + 2] == '+';
+		string_view name = parameterAt(_text, _pos + (nonEmpty ? 3 : 2));
+		if (name.empty())
+			return nullopt;
+		string condition = (nonEmpty ? "+" : "") + string(name);
+		size_t bodyStart = _pos + condition.size() + 3;
+		string close = "</" + condition + ">";
+		size_t closePos = _text.find(close, bodyStart);
+		if (closePos == string_view::npos)
+			return nullopt;
+		string elseTag = "<!" + condition + ">";
+		size_t elsePos = _text.find(elseTag, bodyStart);
+		if (elsePos > closePos)
+			elsePos = closePos;
+
+		Node node;
+		node.kind = nonEmpty ? Node::Kind::NonEmptyCondition : Node::Kind::Condition;
+		node.parameter = registerParameter(_template, name, nonEmpty ? Template::Value : Template::Condition);
+		node.body = parse(_template, _text.substr(bodyStart, elsePos - bodyStart));
+		if (elsePos < closePos)
+		{
+			size_t elseStart = elsePos + elseTag.size();
+			node.elseBody = parse(_template, _text.substr(elseStart, closePos - elseStart));
+		}
+		return make_pair(move(node), closePos + close.size());
+	}
+
+	return nullopt;
+}
+
+vector<Node> parse(Template& _template, string_view _text)
+{
+	vector<Node> nodes;
+	size_t textStart = 0;
+	auto appendText = [&](size_t _end) {
+		if (_end > textStart)
+		{
+			Node node;
+			node.text = _text.substr(textStart, _end - textStart);
+			nodes.emplace_back(move(node));
+		}
+	};
+
+	size_t pos = 0;
+	while ((pos = _text.find('<', pos)) != string_view::npos)
+		if (auto match = matchAt(_template, _text, pos))
+		{
+			appendText(pos);
+			nodes.emplace_back(move(match->first));
+			pos = textStart = match->second;
+		}
+		else
+			++pos;
+	appendText(_text.size());
+	return nodes;
+}
+
+shared_ptr<Template const> compile(string_view _source)
+{
+	static mutex templatesMutex;
+	static unordered_map<string, shared_ptr<Template const>> templates;
+
+	lock_guard<mutex> lock(templatesMutex);
+	auto& compiled = templates[string(_source)];
+	if (!compiled)
+	{
+		auto newTemplate = make_shared<Template>();
+		newTemplate->source = string(_source);
+		newTemplate->nodes = parse(*newTemplate, newTemplate->source);
+		compiled = move(newTemplate);
+	}
+	return compiled;
+}
+
+struct Renderer
+{
+	Template const& templ;
+	vector<optional<string>> const& values;
+	vector<optional<bool>> const& conditions;
+	vector<optional<vector<CompiledWhiskers::StringMap>>> const& lists;
+
+	string const& value(size_t _parameter, CompiledWhiskers::StringMap const* _listItem) const
+	{
+		string const& name = templ.parameters[_parameter];
+		if (_listItem)
+			if (auto it = _listItem->find(name); it != _listItem->end())
+			{
+				assertThrow(!values[_parameter], WhiskersError, "Parameter collision");
+				return it->second;
+			}
+		assertThrow(
+			values[_parameter],
+			WhiskersError,
+			"Value for tag " + name + " not provided.\n" +
+			"Template:\n" +
+			templ.source
+		);
+		return *values[_parameter];
+	}
+
+	void render(vector<Node> const& _nodes, string& _buffer, CompiledWhiskers::StringMap const* _listItem) const
+	{
+		for (Node const& node: _nodes)
+			switch (node.kind)
+			{
+			case Node::Kind::Text:
+				_buffer.append(node.text);
+				break;
+			case Node::Kind::Tag:
+				_buffer += value(node.parameter, _listItem);
+				break;
+			case Node::Kind::List:
+			{
+				string const& name = templ.parameters[node.parameter];
+				// Lists cannot be nested.
+				assertThrow(!_listItem && lists[node.parameter], WhiskersError, "List parameter " + name + " not set.");
+				for (auto const& item: *lists[node.parameter])
+					render(node.body, _buffer, &item);
+				break;
+			}
+			case Node::Kind::Condition:
+			{
+				string const& name = templ.parameters[node.parameter];
+				assertThrow(conditions[node.parameter], WhiskersError, "Condition parameter " + name + " not set.");
+				render(*conditions[node.parameter] ? node.body : node.elseBody, _buffer, _listItem);
+				break;
+			}
+			case Node::Kind::NonEmptyCondition:
+				render(value(node.parameter, _listItem).empty() ? node.elseBody : node.body, _buffer, _listItem);
+				break;
+			}
+	}
+};
+
+}
+
+CompiledWhiskers::CompiledWhiskers(string const& _template):
+	CompiledWhiskers(compile(_template))
+{
+}
+
+CompiledWhiskers::CompiledWhiskers(shared_ptr<Template const> _template):
+	m_template(move(_template)),
+	m_values(m_template->parameters.size()),
+	m_conditions(m_template->parameters.size()),
+	m_lists(m_template->parameters.size())
+{
+}
+
+CompiledWhiskers& CompiledWhiskers::operator()(string const& _parameter, string _value)
+{
+	m_values[parameterIndex(_parameter, Template::Value)] = move(_value);
+	return *this;
+}
+
+CompiledWhiskers& CompiledWhiskers::operator()(string const& _parameter, bool _value)
+{
+	m_conditions[parameterIndex(_parameter, Template::Condition)] = _value;
+	return *this;
+}
+
+CompiledWhiskers& CompiledWhiskers::operator()(string const& _listParameter, vector<StringMap> _values)
+{
+	m_lists[parameterIndex(_listParameter, Template::List)] = move(_values);
+	return *this;
+}
+
+shared_ptr<Template const> CompiledWhiskers::compiledTemplate(string_view _source, void const* _handle)
+{
+	thread_local unordered_map<void const*, shared_ptr<Template const>> byHandle;
+	auto& compiled = byHandle[_handle];
+	if (!compiled)
+		compiled = compile(_source);
+	return compiled;
+}
+
+string CompiledWhiskers::render() const
+{
+	string result;
+	result.reserve(m_template->source.size());
+	render(result);
+	return result;
+}
+
+void CompiledWhiskers::render(string& _buffer) const
+{
+	Renderer{*m_template, m_values, m_conditions, m_lists}.render(m_template->nodes, _buffer, nullptr);
+}
+
+size_t CompiledWhiskers::parameterIndex(string const& _parameter, unsigned _usage) const
+{
+	assertThrow(
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
+		WhiskersError,
+		"Parameter" + _parameter + " contains invalid characters."
+	);
+	auto it = m_template->indices.find(_parameter);
+	assertThrow(
+		it != m_template->indices.end() && (m_template->usage[it->second] & _usage),
+		WhiskersError,
+		"Parameter " + _parameter + " not found in template:\n" + m_template->source
+	);
+	size_t index = it->second;
+	assertThrow(
+		!m_values[index] && !m_conditions[index] && !m_lists[index],
+		WhiskersError,
+		"Parameter " + _parameter + " already set."
+	);
+	return index;
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Whiskers templates that are parsed once and rendered from indexed parameters.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libsolutil/Whiskers.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Drop-in replacement for Whiskers with the same template syntax and checks.
+ *
+ * Whiskers scans the template with a regular expression on every render and keeps the
+ * parameters in maps keyed by name. CompiledWhiskers parses every distinct template text
+ * once per process into a tree of text and placeholder nodes. Each parameter gets an index,
+ * so setting a parameter is a single name lookup and rendering only appends to a buffer.
+ *
+ * Templates given as string literals are looked up by their address in a per-thread table,
+ * so only the first use of a literal in a thread hashes the text and takes the global lock.
+ */
+class CompiledWhiskers
+{
+public:
+	using StringMap = Whiskers::StringMap;
+	struct Template;
+
+	explicit CompiledWhiskers(std::string const& _template = std::string());
+	/// @a _template has to be a string literal or another array that is never modified,
+	/// its address identifies the template.
+	template <size_t N>
+	explicit CompiledWhiskers(char const (&_template)[N]):
+		CompiledWhiskers(compiledTemplate(std::string_view(_template, N - 1), _template))
+	{}
+
+	/// Sets a single regular parameter, <paramName>.
+	CompiledWhiskers& operator()(std::string const& _parameter, std::string _value);
+	CompiledWhiskers& operator()(std::string const& _parameter, char const* _value) { return (*this)(_parameter, std::string{_value}); }
+	/// Sets a condition parameter, <?paramName>...<!paramName>...</paramName>
+	CompiledWhiskers& operator()(std::string const& _parameter, bool _value);
+	/// Sets a list parameter, <#listName> </listName>.
+	CompiledWhiskers& operator()(std::string const& _listParameter, std::vector<StringMap> _values);
+
+	std::string render() const;
+	/// Appends the rendered template to @a _buffer.
+	void render(std::string& _buffer) const;
+
+private:
+	explicit CompiledWhiskers(std::shared_ptr<Template const> _template);
+
+	/// @returns the template stored for @a _handle, compiling @a _source on first use in this thread.
+	static std::shared_ptr<Template const> compiledTemplate(std::string_view _source, void const* _handle);
+
+	// Prevent implicit cast to bool
+	CompiledWhiskers& operator()(std::string const& _parameter, long long);
+
+	size_t parameterIndex(std::string const& _parameter, unsigned _usage) const;
+
+	std::shared_ptr<Template const> m_template;
+	std::vector<std::optional<std::string>> m_values;
+	std::vector<std::optional<bool>> m_conditions;
+	std::vector<std::optional<std::vector<StringMap>>> m_lists;
+};
+
+}
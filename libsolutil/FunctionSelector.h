@@ -23,11 +23,4 @@ inline u256 selectorFromSignature(std::string const& _signature)
 	return u256(selectorFromSignature32(_signature)) << (256 - 32);
 }
 
-/// Solidity++:
-/// @returns the callback selector for a given await Id, as a 32 bit number.
-inline uint32_t selectorFromAwaitId(int64_t awaitId)
-{
-    return (uint32_t)awaitId;
-}
-
 }
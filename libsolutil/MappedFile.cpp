@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Read-only memory-mapped files.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolutil/MappedFile.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+MappedFile::MappedFile(string const& _path)
+{
+#if !defined(_WIN32)
+	int file = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file < 0)
+		BOOST_THROW_EXCEPTION(FileNotFound());
+
+	struct stat status;
+	// Empty files cannot be mapped and pipes or devices have no fixed size, read those instead.
+	if (fstat(file, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+	{
+		void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapping != MAP_FAILED)
+		{
+			m_mapping = mapping;
+			m_size = static_cast<size_t>(status.st_size);
+		}
+	}
+	close(file);
+	if (m_mapping)
+		return;
+#endif
+	m_contents = readFileAsString(_path);
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+	if (m_mapping)
+		munmap(m_mapping, m_size);
+#endif
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Read-only memory-mapped files.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * The contents of a file, mapped into memory on POSIX systems and read into a string elsewhere
+ * or if the file cannot be mapped. The contents stay valid while the object exists.
+ */
+class MappedFile: boost::noncopyable
+{
+public:
+	/// Maps the file at @a _path. Throws FileNotFound if the file cannot be opened.
+	explicit MappedFile(std::string const& _path);
+	~MappedFile();
+
+	std::string_view data() const
+	{
+		return m_mapping ? std::string_view(static_cast<char const*>(m_mapping), m_size) : std::string_view(m_contents);
+	}
+
+private:
+	void* m_mapping = nullptr;
+	size_t m_size = 0;
+	/// Contents of a file that is not mapped.
+	std::string m_contents;
+};
+
+}
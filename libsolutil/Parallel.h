@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Helpers to run independent jobs on several threads.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// @returns @a _threads, or the number of hardware threads if it is 0.
+inline size_t threadCount(size_t _threads)
+{
+	return _threads ? _threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Calls @a _job(i) for every i in [0, _count) on up to threadCount(@a _threads) threads.
+/// Jobs are taken in increasing order and must not depend on each other. Results should be
+/// written to slots indexed by i, so that they can be merged in a deterministic order.
+/// The first exception thrown by a job is rethrown after all threads finished; remaining
+/// jobs are not started after an exception. If a thread cannot be created, the jobs run on
+/// the threads started so far and the calling thread.
+template <class Job>
+void parallelFor(size_t _count, size_t _threads, Job const& _job)
+{
+	size_t threadCount = std::min(_count, util::threadCount(_threads));
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_job(i);
+		return;
+	}
+
+	std::atomic<size_t> next{0};
+	std::atomic<bool> failed{false};
+	std::exception_ptr exception;
+	std::mutex exceptionMutex;
+	auto worker = [&]() {
+		for (size_t i = next++; i < _count && !failed; i = next++)
+			try
+			{
+				_job(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(exceptionMutex);
+				if (!exception)
+					exception = std::current_exception();
+				failed = true;
+			}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (size_t i = 1; i < threadCount; ++i)
+		try
+		{
+			threads.emplace_back(worker);
+		}
+		catch (std::system_error const&)
+		{
+			// No more threads available, the jobs are shared by the threads already running.
+			break;
+		}
+	worker();
+	for (std::thread& thread: threads)
+		thread.join();
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+}
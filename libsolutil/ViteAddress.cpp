@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Decoding of Vite address and token id literals.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolutil/ViteAddress.h>
+#include <libsolutil/Blake2.h>
+
+#include <array>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+int hexDigitValue(char _c)
+{
+	if (_c >= '0' && _c <= '9')
+		return _c - '0';
+	if (_c >= 'a' && _c <= 'f')
+		return _c - 'a' + 10;
+	if (_c >= 'A' && _c <= 'F')
+		return _c - 'A' + 10;
+	return -1;
+}
+
+/// Decodes the even number of hex digits @a _hex into @a _out.
+bool decodeHex(string_view _hex, uint8_t* _out)
+{
+	for (size_t i = 0; i < _hex.size(); i += 2)
+	{
+		int high = hexDigitValue(_hex[i]);
+		int low = hexDigitValue(_hex[i + 1]);
+		if (high < 0 || low < 0)
+			return false;
+		_out[i / 2] = static_cast<uint8_t>(high * 16 + low);
+	}
+	return true;
+}
+
+enum class Checksum { Invalid, Plain, Negated };
+
+/// Decodes "<prefix><data><checksum>" into @a _data and compares the checksum with the blake2b
+/// hash of the data.
+template <size_t DataBytes, size_t ChecksumBytes>
+Checksum decode(string_view _text, string_view _prefix, uint8_t* _data)
+{
+	if (_text.size() != _prefix.size() + 2 * (DataBytes + ChecksumBytes) || _text.substr(0, _prefix.size()) != _prefix)
+		return Checksum::Invalid;
+	_text.remove_prefix(_prefix.size());
+
+	array<uint8_t, ChecksumBytes> checksum;
+	if (!decodeHex(_text.substr(0, 2 * DataBytes), _data) || !decodeHex(_text.substr(2 * DataBytes), checksum.data()))
+		return Checksum::Invalid;
+
+	array<uint8_t, ChecksumBytes> hash;
+	blake2b_raw(hash.data(), ChecksumBytes, _data, DataBytes, nullptr, 0);
+
+	bool plain = true;
+	bool negated = true;
+	for (size_t i = 0; i < ChecksumBytes; ++i)
+	{
+		plain = plain && checksum[i] == hash[i];
+		negated = negated && checksum[i] == static_cast<uint8_t>(~hash[i]);
+	}
+	return plain ? Checksum::Plain : negated ? Checksum::Negated : Checksum::Invalid;
+}
+
+}
+
+optional<h168> solidity::util::decodeViteAddress(string_view _address)
+{
+	h168 address;
+	Checksum checksum = decode<20, 5>(_address, "vite_", address.data());
+	if (checksum == Checksum::Invalid)
+		return nullopt;
+	address[20] = checksum == Checksum::Negated ? 1 : 0;
+	return address;
+}
+
+optional<h80> solidity::util::decodeViteTokenId(string_view _tokenId)
+{
+	h80 tokenId;
+	if (decode<10, 2>(_tokenId, "tti_", tokenId.data()) == Checksum::Invalid)
+		return nullopt;
+	return tokenId;
+}
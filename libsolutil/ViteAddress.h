@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Decoding of Vite address and token id literals.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <optional>
+#include <string_view>
+
+namespace solidity::util
+{
+
+using h80 = FixedHash<10>;
+
+/// Decodes a Vite address "vite_" + 40 hex digits + 10 hex digits checksum. The checksum is the
+/// 5-byte blake2b hash of the 20 address bytes, bitwise negated for contract addresses.
+/// Decoding does not allocate.
+/// @returns the 21-byte address, with a last byte of 0x00 for user and 0x01 for contract
+/// addresses, or nullopt if @a _address is malformed or fails the checksum.
+std::optional<h168> decodeViteAddress(std::string_view _address);
+
+/// Decodes a Vite token id "tti_" + 20 hex digits + 4 hex digits checksum, computed like the
+/// address checksum over the 10 token id bytes.
+/// @returns the 10-byte token id or nullopt if @a _tokenId is malformed or fails the checksum.
+std::optional<h80> decodeViteTokenId(std::string_view _tokenId);
+
+}
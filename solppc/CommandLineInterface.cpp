@@ -6,6 +6,7 @@
  * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
  */
 #include "CommandLineInterface.h"
+#include "FileWatcher.h"
 
 // #include "BuildInfo.h"
 #include "license.h"
@@ -14,12 +15,14 @@
 #include <libsolidity/parsing/Parser.h>
 #include <libsolidity/ast/SolidityppASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
+#include <libsolidity/ast/ASTSnapshot.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/codegen/YulUtilityCache.h>
 
 #include <libyul/AssemblyStack.h>
 #include <libyul/optimiser/Suite.h>
@@ -37,6 +40,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/ViteAddress.h>
 
 #include <algorithm>
 #include <memory>
@@ -103,9 +107,11 @@ static string const g_strBasePath = "base-path";
 static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
 static string const g_strAssemble = "assemble";
+static string const g_strAwaitReport = "await-report";  // Solidity++
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strAstSnapshot = "ast-snapshot";  // Solidity++
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
@@ -148,13 +154,17 @@ static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulCacheDir = "yul-cache-dir";  // Solidity++
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStorageLayout = "storage-layout";
 static string const g_strStopAfter = "stop-after";
+static string const g_strThreads = "threads";  // Solidity++
+static string const g_strMaxInFlight = "max-in-flight";  // Solidity++
 static string const g_strParsing = "parsing";
 static string const g_strVerbose = "verbose";  // Solidity++
+static string const g_strWatch = "watch";  // Solidity++
 
 /// Possible arguments to for --revert-strings
 static set<string> const g_revertStringsArgs
@@ -187,8 +197,10 @@ static string const g_argBasePath = g_strBasePath;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
+static string const g_argAwaitReport = g_strAwaitReport;  // Solidity++
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argAstSnapshot = g_strAstSnapshot;  // Solidity++
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
 static string const g_argCombinedJson = g_strCombinedJson;
@@ -304,6 +316,7 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 		g_argAsm,
 		g_argAsmJson,
 		g_argAstJson,
+		g_argAwaitReport,
 		g_argBinary,
 		g_argBinaryRuntime,
 		g_argMetadata,
@@ -479,6 +492,43 @@ void CommandLineInterface::handleStorageLayout(string const& _contract)
 		sout() << "Contract Storage Layout:" << endl << data << endl;
 }
 
+void CommandLineInterface::handleAwaitReport(string const& _contract)
+{
+	if (!m_args.count(g_argAwaitReport))
+		return;
+
+	Json::Value report = m_compiler->awaitReport(_contract);
+	if (m_args.count(g_argOutputDir))
+	{
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_await.json", jsonCompactPrint(report));
+		return;
+	}
+
+	sout() << "Await report:" << endl;
+	for (Json::Value const& await: report["awaits"])
+	{
+		sout() << await["source"].asString() << ":" << await["line"].asInt() << ":" << await["column"].asInt();
+		if (await.isMember("function"))
+			sout() << " in function " << await["function"].asString();
+		else
+			sout() << " in modifier " << await["modifier"].asString();
+		sout() << ": " << await["liveSlots"].asUInt64() << " of " << await["slotsInScope"].asUInt64() << " stack slots live";
+
+		vector<string> live;
+		for (Json::Value const& name: await["live"])
+			live.push_back(name.asString());
+		if (!live.empty())
+			sout() << " (" << boost::join(live, ", ") << ")";
+
+		vector<string> memory;
+		for (Json::Value const& name: await["liveMemory"])
+			memory.push_back(name.asString());
+		if (!memory.empty())
+			sout() << ", live memory: " << boost::join(memory, ", ");
+		sout() << endl;
+	}
+}
+
 void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contract)
 {
 	std::string argName;
@@ -612,14 +662,26 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 				}
 
 				// NOTE: we ignore the FileNotFound exception as we manually check above
-				m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
+				// Solidity++: AST imports are mapped into memory and a binary snapshot is read
+				// from the mapping without a copy of the file.
+				if (m_args.count(g_argImportAst))
+				{
+					auto file = make_unique<MappedFile>(infile.string());
+					if (ASTSnapshotReader::isSnapshot(file->data()))
+						m_astSnapshots[infile.generic_string()] = move(file);
+					else
+						m_sourceCodes[infile.generic_string()] = string(file->data());
+				}
+				else
+					m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
 				path = boost::filesystem::canonical(infile).string();
+				m_sourceFiles[infile.generic_string()] = path;
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
 		m_sourceCodes[g_stdinFileName] = readStandardInput();
-	if (m_sourceCodes.size() == 0)
+	if (m_sourceCodes.empty() && m_astSnapshots.empty())
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
 		return false;
@@ -703,19 +765,18 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 				serr() << "Invalid length for address for library \"" << libName << "\": " << addrString.length() << " instead of 55 characters." << endl;
 				return false;
 			}
-			if (!passesViteAddressChecksum(addrString))
+			optional<h168> address = decodeViteAddress(addrString);
+			if (!address)
 			{
 				serr() << "Invalid checksum on address for library \"" << libName << "\": " << addrString << endl;
 				return false;
 			}
-			bytes binAddr = fromHex(getViteAddressHex(addrString));
-			h168 address(binAddr, h168::AlignRight);
-			if (binAddr.size() > 21 || address == h168())
+			if (*address == h168())
 			{
 				serr() << "Invalid address for library \"" << libName << "\": " << addrString << endl;
 				return false;
 			}
-			m_libraries[libName] = address;
+			m_libraries[libName] = *address;
 		}
 
 	return true;
@@ -754,26 +815,52 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 
 	fs::path outputDir(m_args.at(g_argOutputDir).as<string>());
 
-	// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
-	// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
-	// The simplest workaround is to use an absolute path.
-	fs::create_directories(fs::absolute(outputDir));
+	if (!m_outputWriter)
+	{
+		// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
+		// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
+		// The simplest workaround is to use an absolute path.
+		try
+		{
+			fs::create_directories(fs::absolute(outputDir));
+		}
+		catch (fs::filesystem_error const& _exception)
+		{
+			serr() << "Could not create output directory \"" << outputDir.string() << "\": " << _exception.what() << endl;
+			m_error = true;
+			return;
+		}
+		m_outputWriter = make_unique<OutputWriter>();
+	}
 
 	string pathName = (outputDir / _fileName).string();
-	if (fs::exists(pathName) && !m_args.count(g_strOverwrite))
+	// Rebuilds of --watch replace the files written by the previous build.
+	// Files queued earlier in this build are not necessarily on disk yet.
+	if (
+		(fs::exists(pathName) || m_outputFiles.count(pathName)) &&
+		!m_args.count(g_strOverwrite) &&
+		!m_outputSources
+	)
 	{
 		serr() << "Refusing to overwrite existing file \"" << pathName << "\" (use --" << g_strOverwrite << " to force)." << endl;
 		m_error = true;
 		return;
 	}
-	ofstream outFile(pathName);
-	outFile << _data;
-	if (!outFile)
+	m_outputFiles.insert(pathName);
+	m_outputWriter->write(pathName, _data);
+}
+
+void CommandLineInterface::finishOutputFiles()
+{
+	if (!m_outputWriter)
+		return;
+	for (string const& error: m_outputWriter->finish())
 	{
-		serr() << "Could not write to file \"" << pathName << "\"." << endl;
+		serr() << error << endl;
 		m_error = true;
-		return;
 	}
+	m_outputWriter.reset();
+	m_outputFiles.clear();
 }
 
 void CommandLineInterface::createJson(string const& _fileName, string const& _json)
@@ -849,6 +936,23 @@ General Information)").c_str(),
 			g_strOverwrite.c_str(),
 			"Overwrite existing files (used together with -o)."
 		)
+		(
+			g_strWatch.c_str(),
+			"Keep running and recompile whenever one of the source files changes. "
+			"Only the output of the contracts affected by a change is written again."
+		)
+		(
+			g_strThreads.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Number of threads used to analyse sources and to collect contract artifacts. "
+			"Defaults to the number of hardware threads."
+		)
+		(
+			g_strMaxInFlight.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Maximum number of --standard-json input files held in memory at a time if several are given. "
+			"The next files are read while the current one is compiled. Defaults to 2."
+		)
 		(
 			g_strEVMVersion.c_str(),
 			po::value<string>()->value_name("version"),
@@ -877,7 +981,8 @@ General Information)").c_str(),
 		(
 			g_argStandardJSON.c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
-			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
+			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output. "
+			"Several input files are compiled one after another and their results are written as a JSON array."
 		)
 		(
 			g_argLink.c_str(),
@@ -906,7 +1011,8 @@ General Information)").c_str(),
 			g_argImportAst.c_str(),
 			("Import ASTs to be compiled, assumes input holds the AST in compact JSON format. "
 			"Supported Inputs is the output of the --" + g_argStandardJSON + " or the one produced by "
-			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON).c_str()
+			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON + ". "
+			"A single snapshot written by --" + g_argAstSnapshot + " is imported as well.").c_str()
 		)
 	;
 	desc.add(alternativeInputModes);
@@ -963,6 +1069,11 @@ General Information)").c_str(),
 	outputComponents.add_options()
 		(g_argAstJson.c_str(), "AST of all source files in JSON format.")
 		(g_argAstCompactJson.c_str(), "AST of all source files in a compact JSON format.")
+		(
+			g_argAstSnapshot.c_str(),
+			("Binary snapshot of the ASTs of all source files, written to ast.snapshot in the output directory. "
+			"Can be compiled with --" + g_argImportAst + " by the same compiler version.").c_str()
+		)
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -986,6 +1097,11 @@ General Information)").c_str(),
 			g_argGas.c_str(),
 			"Print an estimate of the maximal gas usage for each function."
 		)
+		(
+			g_argAwaitReport.c_str(),
+			"Print the local variables that are live across each await and the number of stack slots they occupy. "
+			"The generated code still keeps all slots in scope across the await."
+		)
 		(
 			g_argCombinedJson.c_str(),
 			po::value<string>()->value_name(boost::join(g_combinedJsonArgs, ",")),
@@ -1033,6 +1149,11 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Keep the optimized Yul utility functions in the given directory and reuse them in later compilations."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -1155,7 +1276,7 @@ General Information)").c_str(),
 
 bool CommandLineInterface::processInput()
 {
-	ReadCallback::Callback fileReader = [this](string const& _kind, string const& _path)
+	m_fileReader = [this](string const& _kind, string const& _path)
 	{
 		try
 		{
@@ -1194,7 +1315,7 @@ bool CommandLineInterface::processInput()
 
 			// NOTE: we ignore the FileNotFound exception as we manually check above
 			auto contents = readFileAsString(canonicalPath.string());
-			m_sourceCodes[path.generic_string()] = contents;
+			m_sourceFiles[_path] = canonicalPath;
 			return ReadCallback::Result{true, contents};
 		}
 		catch (Exception const& _exception)
@@ -1261,6 +1382,16 @@ bool CommandLineInterface::processInput()
 		serr() << "Select at most one." << endl;
 		return false;
 	}
+	if (m_args.count(g_strWatch) && countEnabledOptions(exclusiveModes) > 0)
+	{
+		serr() << "Option --" << g_strWatch << " cannot be used together with " << joinOptionNames(exclusiveModes) << "." << endl;
+		return false;
+	}
+	if (m_args.count(g_argAstSnapshot) && !m_args.count(g_argOutputDir))
+	{
+		serr() << "Option --" << g_argAstSnapshot << " requires --" << g_argOutputDir << "." << endl;
+		return false;
+	}
 
 	if (m_args.count(g_argStandardJSON))
 	{
@@ -1272,8 +1403,31 @@ bool CommandLineInterface::processInput()
 			jsonFile = inputFiles[0];
 		else if (inputFiles.size() > 1)
 		{
-			serr() << "If --" << g_argStandardJSON << " is used, only zero or one input files are supported." << endl;
-			return false;
+			// Solidity++: several input files are compiled as a batch, the output is an array
+			// with the output of each of them.
+			for (string const& inputFile: inputFiles)
+				if (!boost::filesystem::is_regular_file(inputFile))
+				{
+					serr() << "File not found: " << inputFile << endl;
+					return false;
+				}
+			StandardCompiler compiler(m_fileReader);
+			if (m_args.count(g_strThreads))
+				compiler.setThreads(m_args[g_strThreads].as<unsigned>());
+			if (m_args.count(g_strMaxInFlight))
+				compiler.setMaxInFlight(m_args[g_strMaxInFlight].as<unsigned>());
+			size_t nextInput = 0;
+			compiler.compileBatch(
+				[&]() -> optional<string>
+				{
+					if (nextInput == inputFiles.size())
+						return nullopt;
+					return readFileAsString(inputFiles[nextInput++]);
+				},
+				[](string const& _chunk) { sout() << _chunk; }
+			);
+			sout() << endl;
+			return true;
 		}
 		string input;
 		if (jsonFile.empty())
@@ -1290,8 +1444,12 @@ bool CommandLineInterface::processInput()
 				return false;
 			}
 		}
-		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
+		StandardCompiler compiler(m_fileReader);
+		if (m_args.count(g_strThreads))
+			compiler.setThreads(m_args[g_strThreads].as<unsigned>());
+		// Solidity++: write the output as it is produced instead of holding all of it in memory.
+		compiler.compile(input, [](string const& _chunk) { sout() << _chunk; });
+		sout() << endl;
 		return true;
 	}
 
@@ -1484,32 +1642,12 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
-	m_compiler = make_unique<CompilerStack>(fileReader, m_args.count(g_strVerbose));  // Solidity++: verbose
+	m_compiler = make_shared<CompilerStack>(m_fileReader, m_args.count(g_strVerbose));  // Solidity++: verbose
 
 	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
 
 	try
 	{
-		if (m_args.count(g_argMetadataLiteral) > 0)
-			m_compiler->useMetadataLiteralSources(true);
-		if (m_args.count(g_argMetadataHash))
-			m_compiler->setMetadataHash(m_metadataHash);
-		if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
-			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
-		if (m_args.count(g_argInputFile))
-			m_compiler->setRemappings(m_remappings);
-
-		if (m_args.count(g_argLibraries))
-			m_compiler->setLibraries(m_libraries);
-		if (m_args.count(g_argExperimentalViaIR))
-			m_compiler->setViaIR(true);
-		m_compiler->setEVMVersion(m_evmVersion);
-		m_compiler->setRevertStringBehaviour(m_revertStrings);
-		// TODO: Perhaps we should not compile unless requested
-
-		m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
-		m_compiler->enableEwasmGeneration(m_args.count(g_argEwasm));
-
 		OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		if (m_args.count(g_strNoOptimizeYul))
@@ -1535,13 +1673,29 @@ bool CommandLineInterface::processInput()
 			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
-		m_compiler->setOptimiserSettings(settings);
+		m_optimiserSettings = settings;
+		configureCompiler(*m_compiler);
+		if (m_args.count(g_strYulCacheDir))
+			YulUtilityCache::instance().setDirectory(m_args[g_strYulCacheDir].as<string>());
 
 		if (m_args.count(g_argImportAst))
 		{
 			try
 			{
-				m_compiler->importASTs(parseAstFromInput());
+				// Solidity++: a binary AST snapshot carries its source code.
+				if (!m_astSnapshots.empty())
+				{
+					astAssert(m_astSnapshots.size() == 1 && m_sourceCodes.empty(), "An AST snapshot has to be imported on its own.");
+					m_compiler->importASTSnapshot(m_astSnapshots.begin()->second->data());
+					m_astSnapshots.clear();
+				}
+				else if (m_sourceCodes.size() == 1 && ASTSnapshotReader::isSnapshot(m_sourceCodes.begin()->second))
+				{
+					m_compiler->importASTSnapshot(m_sourceCodes.begin()->second);
+					m_sourceCodes.clear();
+				}
+				else
+					m_compiler->importASTs(parseAstFromInput());
 
 				if (!m_compiler->analyze())
 				{
@@ -1558,9 +1712,10 @@ bool CommandLineInterface::processInput()
 		}
 		else
 		{
-			m_compiler->setSources(m_sourceCodes);
-			if (m_args.count(g_argErrorRecovery))
-				m_compiler->setParserErrorRecovery(true);
+			// Solidity++: the compiler stack keeps the only copy of the sources, the outputs
+			// iterate over its source names and take source snippets from it.
+			m_compiler->setSources(std::move(m_sourceCodes));
+			m_sourceCodes.clear();
 		}
 
 		bool successful = m_compiler->compile(m_stopAfter);
@@ -1573,7 +1728,8 @@ bool CommandLineInterface::processInput()
 
 		if (!successful)
 		{
-			if (m_args.count(g_argErrorRecovery))
+			// Solidity++: --watch keeps running until the errors are fixed.
+			if (m_args.count(g_argErrorRecovery) || m_args.count(g_strWatch))
 				return true;
 			else
 				return false;
@@ -1642,6 +1798,34 @@ bool CommandLineInterface::processInput()
 	return true;
 }
 
+void CommandLineInterface::configureCompiler(CompilerStack& _compiler) const
+{
+	if (m_args.count(g_argMetadataLiteral) > 0)
+		_compiler.useMetadataLiteralSources(true);
+	if (m_args.count(g_argMetadataHash))
+		_compiler.setMetadataHash(m_metadataHash);
+	if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
+		_compiler.setModelCheckerSettings(m_modelCheckerSettings);
+	if (m_args.count(g_argInputFile))
+		_compiler.setRemappings(m_remappings);
+
+	if (m_args.count(g_argLibraries))
+		_compiler.setLibraries(m_libraries);
+	if (m_args.count(g_argExperimentalViaIR))
+		_compiler.setViaIR(true);
+	_compiler.setEVMVersion(m_evmVersion);
+	_compiler.setRevertStringBehaviour(m_revertStrings);
+	if (m_args.count(g_strThreads))
+		_compiler.setThreads(m_args[g_strThreads].as<unsigned>());
+	// TODO: Perhaps we should not compile unless requested
+
+	_compiler.enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
+	_compiler.enableEwasmGeneration(m_args.count(g_argEwasm));
+	_compiler.setOptimiserSettings(m_optimiserSettings);
+	if (m_args.count(g_argErrorRecovery))
+		_compiler.setParserErrorRecovery(true);
+}
+
 void CommandLineInterface::handleCombinedJSON()
 {
 	if (!m_args.count(g_argCombinedJson))
@@ -1708,11 +1892,11 @@ void CommandLineInterface::handleCombinedJSON()
 	if (requests.count(g_strAst))
 	{
 		output[g_strSources] = Json::Value(Json::objectValue);
-		for (auto const& sourceCode: m_sourceCodes)
+		for (string const& sourceName: m_compiler->sourceNames())
 		{
 			SolidityppASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			output[g_strSources][sourceName] = Json::Value(Json::objectValue);
+			output[g_strSources][sourceName]["AST"] = converter.toJson(m_compiler->ast(sourceName));
 		}
 	}
 
@@ -1727,32 +1911,36 @@ void CommandLineInterface::handleCombinedJSON()
 
 void CommandLineInterface::handleAst()
 {
+	// Solidity++: the snapshot is only written to the output directory.
+	if (m_args.count(g_argAstSnapshot))
+		createFile("ast.snapshot", m_compiler->astSnapshot());
+
 	if (!m_args.count(g_argAstCompactJson))
 		return;
 
 	vector<ASTNode const*> asts;
-	for (auto const& sourceCode: m_sourceCodes)
-		asts.push_back(&m_compiler->ast(sourceCode.first));
+	for (string const& sourceName: m_compiler->sourceNames())
+		asts.push_back(&m_compiler->ast(sourceName));
 
 	if (m_args.count(g_argOutputDir))
 	{
-		for (auto const& sourceCode: m_sourceCodes)
+		for (string const& sourceName: m_compiler->sourceNames())
 		{
 			stringstream data;
 			string postfix = "";
-			SolidityppASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first));
+			SolidityppASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceName));
 			postfix += "_json";
-			boost::filesystem::path path(sourceCode.first);
+			boost::filesystem::path path(sourceName);
 			createFile(path.filename().string() + postfix + ".ast", data.str());
 		}
 	}
 	else
 	{
 		sout() << "JSON AST (compact format):" << endl << endl;
-		for (auto const& sourceCode: m_sourceCodes)
+		for (string const& sourceName: m_compiler->sourceNames())
 		{
-			sout() << endl << "======= " << sourceCode.first << " =======" << endl;
-			SolidityppASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first));
+			sout() << endl << "======= " << sourceName << " =======" << endl;
+			SolidityppASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceName));
 		}
 	}
 }
@@ -1764,11 +1952,123 @@ bool CommandLineInterface::actOnInput()
 		return true;
 	else if (m_onlyLink)
 		writeLinkedFiles();
+	else if (m_args.count(g_strWatch))
+		watch();
 	else
+	{
 		outputCompilationResults();
+		finishOutputFiles();
+	}
 	return !m_error;
 }
 
+void CommandLineInterface::watch()
+{
+	if (m_compiler->state() >= m_stopAfter)
+	{
+		outputCompilationResults();
+		finishOutputFiles();
+	}
+
+	try
+	{
+		// Solidity++: only the changed sources, the sources importing them and their imports
+		// are compiled again.
+		IncrementalAnalysis analysis(m_fileReader, [this](CompilerStack& _compiler) { configureCompiler(_compiler); });
+		if (m_compiler->state() >= CompilerStack::State::Parsed)
+			analysis.adopt(m_compiler);
+		else
+			for (string const& sourceName: m_compiler->sourceNames())
+				analysis.setSource(sourceName, m_compiler->scanner(sourceName).source());
+
+		FileWatcher watcher;
+		while (true)
+		{
+			set<boost::filesystem::path> files;
+			for (string const& sourceName: analysis.sourceNames())
+				if (m_sourceFiles.count(sourceName))
+					files.insert(m_sourceFiles.at(sourceName));
+			watcher.watch(files);
+			serr() << endl << "Watching " << files.size() << " source files for changes." << endl;
+
+			if (recompile(analysis, watcher.wait()))
+			{
+				outputCompilationResults();
+				finishOutputFiles();
+			}
+		}
+	}
+	catch (Exception const& _exception)
+	{
+		serr() << "Exception while watching files: " << boost::diagnostic_information(_exception) << endl;
+		m_error = true;
+	}
+}
+
+bool CommandLineInterface::recompile(IncrementalAnalysis& _analysis, set<boost::filesystem::path> const& _changedFiles)
+{
+	map<string, bool> changedSources;
+	for (string const& sourceName: _analysis.sourceNames())
+	{
+		auto file = m_sourceFiles.find(sourceName);
+		if (file != m_sourceFiles.end() && _changedFiles.count(file->second))
+			changedSources[sourceName] = boost::filesystem::is_regular_file(file->second);
+	}
+
+	// The imports are taken from the previous compilation. A source that adds an import
+	// has changed itself, so it is output anyway.
+	set<string> outputSources;
+	for (auto const& [sourceName, exists]: changedSources)
+	{
+		serr() << "Source changed: " << sourceName << endl;
+		outputSources.insert(sourceName);
+		outputSources += _analysis.dependents(sourceName);
+	}
+	m_outputSources = move(outputSources);
+
+	// Removed imports are left to the read callback, which reports them as missing.
+	for (auto const& [sourceName, exists]: changedSources)
+		if (exists)
+			_analysis.setSource(sourceName, readFileAsString(m_sourceFiles.at(sourceName).string()));
+		else
+			_analysis.removeSource(sourceName);
+
+	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+	bool successful = false;
+	// The stack of the last compilation has to be released before the next one is created.
+	m_compiler.reset();
+	try
+	{
+		if (!_analysis.analyze(m_stopAfter).empty())
+		{
+			CompilerStack const& compiler = *_analysis.compiler();
+			for (auto const& error: compiler.errors())
+			{
+				g_hasOutput = true;
+				formatter.printErrorInformation(*error);
+			}
+			successful = compiler.state() >= m_stopAfter;
+		}
+	}
+	catch (Error const& _error)
+	{
+		g_hasOutput = true;
+		formatter.printExceptionInformation(_error, _error.typeName());
+	}
+	catch (Exception const& _exception)
+	{
+		serr() << "Exception during compilation: " << boost::diagnostic_information(_exception) << endl;
+	}
+	catch (std::exception const& _e)
+	{
+		serr() << "Unknown exception during compilation" << (
+			_e.what() ? ": " + string(_e.what()) : "."
+		) << endl;
+	}
+	m_compiler = _analysis.sharedCompiler();
+	return successful;
+}
+
 bool CommandLineInterface::link()
 {
 	// Map from how the libraries will be named inside the bytecode to their addresses.
@@ -2029,6 +2329,10 @@ void CommandLineInterface::outputCompilationResults()
 	vector<string> contracts = m_compiler->contractNames();
 	for (string const& contract: contracts)
 	{
+		// Solidity++: rebuilds of --watch only output the contracts affected by the change.
+		if (m_outputSources && !m_outputSources->count(contract.substr(0, contract.rfind(':'))))
+			continue;
+
 		if (needsHumanTargetedStdout(m_args))
 			sout() << endl << "======= " << contract << " =======" << endl;
 
@@ -2042,7 +2346,7 @@ void CommandLineInterface::outputCompilationResults()
 			}
 			else
 			{
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
+				ret = m_compiler->assemblyString(contract);
 			}
 
 			if (m_args.count(g_argOutputDir))
@@ -2066,6 +2370,7 @@ void CommandLineInterface::outputCompilationResults()
 		handleMetadata(contract);
 		handleABI(contract);
 		handleStorageLayout(contract);
+		handleAwaitReport(contract);
 		handleNatspec(true, contract);
 		handleNatspec(false, contract);
 	} // end of contracts iteration
@@ -7,15 +7,21 @@
  */
 #pragma once
 
+#include "OutputWriter.h"
+
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/DebugSettings.h>
+#include <libsolidity/interface/IncrementalAnalysis.h>
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/MappedFile.h>
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem/path.hpp>
 
 #include <memory>
+#include <optional>
+#include <set>
 
 namespace solidity::frontend
 {
@@ -51,6 +57,16 @@ private:
 
 	void outputCompilationResults();
 
+	/// Applies the settings given on the command line to @a _compiler.
+	void configureCompiler(CompilerStack& _compiler) const;
+
+	/// Recompiles and outputs the results whenever one of the source files changes.
+	void watch();
+	/// Compiles the sources of @a _analysis that are affected by @a _changedFiles again and
+	/// restricts the output to the changed sources and the sources importing them.
+	/// @returns false if compilation failed or nothing had to be compiled.
+	bool recompile(IncrementalAnalysis& _analysis, std::set<boost::filesystem::path> const& _changedFiles);
+
 	void handleCombinedJSON();
 	void handleAst();
 	void handleBinary(std::string const& _contract);
@@ -65,8 +81,9 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
+	void handleAwaitReport(std::string const& _contract);  // Solidity++
 
-	/// Fills @a m_sourceCodes initially and @a m_redirects.
+	/// Fills @a m_sourceCodes initially, or @a m_astSnapshots for snapshots to import, and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
 	/// Tries to read from the file @a _input or interprets _input literally if that fails.
 	/// It then tries to parse the contents and appends to m_libraries.
@@ -79,9 +96,12 @@ private:
 	std::map<std::string, Json::Value> parseAstFromInput();
 
 	/// Create a file in the given directory
+	/// The file is written in the background, see finishOutputFiles().
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
+	/// Waits until the files created by createFile() are written and reports errors.
+	void finishOutputFiles();
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -100,7 +120,21 @@ private:
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
 	/// map of input files to source code strings
+	/// Solidity++: moved into the compiler stack when Solidity sources are compiled.
 	std::map<std::string, std::string> m_sourceCodes;
+	/// Solidity++: AST snapshot files given with --import-ast, mapped into memory.
+	std::map<std::string, std::unique_ptr<util::MappedFile>> m_astSnapshots;
+	/// Reads imported files, restricted to the allowed directories.
+	ReadCallback::Callback m_fileReader;
+	/// Canonical paths of the sources read from the file system, by source name.
+	std::map<std::string, boost::filesystem::path> m_sourceFiles;
+	/// If set, only the artifacts of the contracts in these sources are output.
+	/// Used by --watch after the initial compilation.
+	std::optional<std::set<std::string>> m_outputSources;
+	/// Writer of the files in --output-dir, created by the first createFile() of a build.
+	std::unique_ptr<OutputWriter> m_outputWriter;
+	/// Paths of the files queued on @a m_outputWriter.
+	std::set<std::string> m_outputFiles;
 	/// list of remappings
 	std::vector<frontend::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
@@ -109,8 +143,10 @@ private:
 	boost::filesystem::path m_basePath;
 	/// map of library names to addresses
 	std::map<std::string, util::h168> m_libraries;  // Solidity++: 168-bit address
-	/// Solidity compiler stack
-	std::unique_ptr<frontend::CompilerStack> m_compiler;
+	/// Solidity compiler stack, shared with the incremental analysis of --watch.
+	std::shared_ptr<frontend::CompilerStack> m_compiler;
+	/// Optimiser settings applied by configureCompiler().
+	OptimiserSettings m_optimiserSettings;
 	CompilerStack::State m_stopAfter = CompilerStack::State::CompilationSuccessful;
 	/// EVM version to use
 	langutil::EVMVersion m_evmVersion;
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Change notifications for the source files of solppc --watch.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include "FileWatcher.h"
+
+#include <libsolutil/Exceptions.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <thread>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+chrono::milliseconds const c_pollInterval(250);
+
+#ifdef __linux__
+[[noreturn]] void throwSystemError(string const& _what)
+{
+	BOOST_THROW_EXCEPTION(util::Exception() << util::errinfo_comment(_what + ": " + strerror(errno)));
+}
+#endif
+
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher(bool _poll):
+	m_poll(_poll)
+{
+	if (m_poll)
+		return;
+	m_inotify = inotify_init1(IN_CLOEXEC);
+	if (m_inotify < 0)
+		throwSystemError("Could not initialise inotify");
+}
+
+FileWatcher::~FileWatcher()
+{
+	if (m_inotify >= 0)
+		close(m_inotify);
+}
+
+#else
+
+FileWatcher::FileWatcher(bool) {}
+FileWatcher::~FileWatcher() = default;
+
+#endif
+
+void FileWatcher::watch(set<fs::path> const& _files)
+{
+	m_files = _files;
+
+	if (m_poll)
+	{
+		map<fs::path, FileState> fileStates;
+		for (fs::path const& file: m_files)
+			if (m_fileStates.count(file))
+				fileStates[file] = m_fileStates[file];
+			else
+				fileStates[file] = fileState(file);
+		m_fileStates = move(fileStates);
+		return;
+	}
+
+#ifdef __linux__
+	set<fs::path> directories;
+	for (fs::path const& file: m_files)
+		directories.insert(file.parent_path());
+
+	// Keep the watches that are still needed, so that no pending event is lost.
+	for (auto it = m_directories.begin(); it != m_directories.end();)
+		if (directories.erase(it->second))
+			++it;
+		else
+		{
+			inotify_rm_watch(m_inotify, it->first);
+			it = m_directories.erase(it);
+		}
+
+	for (fs::path const& directory: directories)
+	{
+		int descriptor = inotify_add_watch(
+			m_inotify,
+			directory.c_str(),
+			IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+		);
+		if (descriptor < 0)
+			throwSystemError("Could not watch \"" + directory.string() + "\"");
+		m_directories[descriptor] = directory;
+	}
+#endif
+}
+
+set<fs::path> FileWatcher::wait(chrono::milliseconds _debounce)
+{
+	if (m_poll)
+		return waitByPolling(_debounce);
+
+	set<fs::path> changed;
+#ifdef __linux__
+	while (changed.empty())
+		readEvents(-1, changed);
+	while (readEvents(static_cast<int>(_debounce.count()), changed))
+	{
+	}
+#endif
+	return changed;
+}
+
+FileWatcher::FileState FileWatcher::fileState(fs::path const& _file)
+{
+	boost::system::error_code error;
+	time_t writeTime = fs::last_write_time(_file, error);
+	if (error)
+		return {0, 0};
+	uintmax_t size = fs::file_size(_file, error);
+	return {writeTime, error ? 0 : size};
+}
+
+set<fs::path> FileWatcher::waitByPolling(chrono::milliseconds _debounce)
+{
+	set<fs::path> changed;
+	while (changed.empty())
+	{
+		this_thread::sleep_for(c_pollInterval);
+		changed = pollChanges();
+	}
+	while (true)
+	{
+		this_thread::sleep_for(_debounce);
+		set<fs::path> more = pollChanges();
+		if (more.empty())
+			break;
+		changed.insert(more.begin(), more.end());
+	}
+	return changed;
+}
+
+set<fs::path> FileWatcher::pollChanges()
+{
+	set<fs::path> changed;
+	for (auto& [file, lastState]: m_fileStates)
+	{
+		FileState state = fileState(file);
+		if (state != lastState)
+		{
+			lastState = state;
+			changed.insert(file);
+		}
+	}
+	return changed;
+}
+
+#ifdef __linux__
+
+bool FileWatcher::readEvents(int _timeout, set<fs::path>& _changed)
+{
+	pollfd descriptor{m_inotify, POLLIN, 0};
+	int ready = poll(&descriptor, 1, _timeout);
+	if (ready < 0 && errno == EINTR)
+		return true;
+	if (ready < 0)
+		throwSystemError("Could not wait for file changes");
+	if (ready == 0)
+		return false;
+
+	alignas(inotify_event) char buffer[4096];
+	ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+	if (length < 0)
+	{
+		if (errno == EINTR || errno == EAGAIN)
+			return true;
+		throwSystemError("Could not read file changes");
+	}
+
+	for (char const* position = buffer; position < buffer + length;)
+	{
+		auto const* event = reinterpret_cast<inotify_event const*>(position);
+		position += sizeof(inotify_event) + event->len;
+		auto directory = m_directories.find(event->wd);
+		if (event->len == 0 || directory == m_directories.end())
+			continue;
+		fs::path file = directory->second / event->name;
+		if (m_files.count(file))
+			_changed.insert(move(file));
+	}
+	return true;
+}
+
+#endif
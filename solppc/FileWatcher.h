@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Change notifications for the source files of solppc --watch.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace solidity::frontend
+{
+
+/**
+ * Waits for changes of a set of files.
+ *
+ * On Linux the parent directories of the files are watched with inotify, so that editors
+ * which replace a file by renaming a temporary one are noticed as well. Other platforms
+ * poll the modification times and sizes of the files.
+ */
+class FileWatcher
+{
+public:
+	/// @param _poll polls the files even where inotify is available.
+	explicit FileWatcher(bool _poll = false);
+	~FileWatcher();
+
+	FileWatcher(FileWatcher const&) = delete;
+	FileWatcher& operator=(FileWatcher const&) = delete;
+
+	/// Replaces the set of watched files. The paths have to be canonical.
+	void watch(std::set<boost::filesystem::path> const& _files);
+
+	/// Blocks until at least one of the watched files was written, created or removed.
+	/// Changes following each other within @a _debounce are reported together.
+	/// @returns the changed files.
+	std::set<boost::filesystem::path> wait(
+		std::chrono::milliseconds _debounce = std::chrono::milliseconds(100)
+	);
+
+private:
+	/// Modification time and size of a file, both zero if it does not exist. The time only
+	/// has a resolution of seconds, the size catches most changes within the same second.
+	using FileState = std::pair<std::time_t, std::uintmax_t>;
+
+	static FileState fileState(boost::filesystem::path const& _file);
+	std::set<boost::filesystem::path> waitByPolling(std::chrono::milliseconds _debounce);
+	/// @returns the files whose state is different from the last call.
+	std::set<boost::filesystem::path> pollChanges();
+
+	bool m_poll = true;
+	std::set<boost::filesystem::path> m_files;
+	std::map<boost::filesystem::path, FileState> m_fileStates;
+#ifdef __linux__
+	/// Reads the pending inotify events, waiting at most @a _timeout.
+	/// @returns false if there was no event within @a _timeout.
+	bool readEvents(int _timeout, std::set<boost::filesystem::path>& _changed);
+
+	int m_inotify = -1;
+	/// Watch descriptors of the parent directories of the watched files.
+	std::map<int, boost::filesystem::path> m_directories;
+#endif
+};
+
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Background writer for the files of solppc --output-dir.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include "OutputWriter.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+OutputWriter::OutputWriter(size_t _threads)
+{
+	for (size_t i = 0; i < _threads; ++i)
+		m_threads.emplace_back([this]() { work(); });
+}
+
+OutputWriter::~OutputWriter()
+{
+	finish();
+}
+
+void OutputWriter::write(fs::path _path, string _data)
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_queue.emplace_back(move(_path), move(_data));
+	}
+	m_queueChanged.notify_one();
+}
+
+vector<string> OutputWriter::finish()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_finishing = true;
+	}
+	m_queueChanged.notify_all();
+	for (thread& worker: m_threads)
+		worker.join();
+	m_threads.clear();
+
+	lock_guard<mutex> lock(m_mutex);
+	return move(m_errors);
+}
+
+void OutputWriter::work()
+{
+	while (true)
+	{
+		pair<fs::path, string> file;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_queueChanged.wait(lock, [&]() { return m_finishing || !m_queue.empty(); });
+			if (m_queue.empty())
+				return;
+			file = move(m_queue.front());
+			m_queue.pop_front();
+		}
+
+		try
+		{
+			writeFile(file.first, file.second);
+		}
+		catch (fs::filesystem_error const& _exception)
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_errors.emplace_back("Could not write to file \"" + file.first.string() + "\": " + _exception.what());
+		}
+	}
+}
+
+void OutputWriter::writeFile(fs::path const& _path, string const& _data)
+{
+	boost::system::error_code error;
+	if (fs::file_size(_path, error) == _data.size() && !error)
+	{
+		ifstream existing(_path.string());
+		string contents{istreambuf_iterator<char>(existing), istreambuf_iterator<char>()};
+		if (existing && contents == _data)
+			return;
+	}
+
+	fs::path temporary = _path;
+	temporary += "." + fs::unique_path().string() + ".tmp";
+	{
+		ofstream outFile(temporary.string());
+		outFile << _data;
+		outFile.close();
+		if (!outFile)
+		{
+			fs::remove(temporary, error);
+			throw fs::filesystem_error(
+				"Could not write temporary file",
+				temporary,
+				boost::system::errc::make_error_code(boost::system::errc::io_error)
+			);
+		}
+	}
+	try
+	{
+		fs::rename(temporary, _path);
+	}
+	catch (fs::filesystem_error const&)
+	{
+		fs::remove(temporary, error);
+		throw;
+	}
+}
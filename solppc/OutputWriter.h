@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Background writer for the files of solppc --output-dir.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Writes files on a small pool of background threads.
+ *
+ * A file is written to a temporary file in the same directory and renamed afterwards, so
+ * readers never see a partially written file. Files that already have the given content
+ * are not touched at all, which keeps their modification time for build tools.
+ */
+class OutputWriter
+{
+public:
+	explicit OutputWriter(size_t _threads = std::min(4u, std::max(1u, std::thread::hardware_concurrency())));
+	~OutputWriter();
+
+	OutputWriter(OutputWriter const&) = delete;
+	OutputWriter& operator=(OutputWriter const&) = delete;
+
+	/// Queues writing @a _data to @a _path.
+	void write(boost::filesystem::path _path, std::string _data);
+
+	/// Waits until all queued files are written and stops the threads.
+	/// @returns the error messages of the files that could not be written.
+	std::vector<std::string> finish();
+
+private:
+	void work();
+	/// Writes a single file unless it already has the content @a _data.
+	static void writeFile(boost::filesystem::path const& _path, std::string const& _data);
+
+	std::mutex m_mutex;
+	std::condition_variable m_queueChanged;
+	std::deque<std::pair<boost::filesystem::path, std::string>> m_queue;
+	bool m_finishing = false;
+	std::vector<std::string> m_errors;
+	std::vector<std::thread> m_threads;
+};
+
+}
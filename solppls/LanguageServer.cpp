@@ -0,0 +1,512 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Language server for Solidity++.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include "LanguageServer.h"
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+
+#include <cctype>
+#include <cstdio>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::lsp;
+
+namespace
+{
+
+// JSON-RPC error codes.
+int const c_methodNotFound = -32601;
+int const c_internalError = -32603;
+// Message type of window/logMessage.
+int const c_messageTypeError = 1;
+
+/// @returns the number of UTF-16 code units of the UTF-8 text between @a _begin and @a _end.
+int utf16Length(string const& _text, size_t _begin, size_t _end)
+{
+	int units = 0;
+	for (size_t i = _begin; i < _end && i < _text.size(); ++i)
+	{
+		auto c = static_cast<unsigned char>(_text[i]);
+		// Code points above U+FFFF take four bytes in UTF-8 and a surrogate pair in UTF-16.
+		if ((c & 0xC0) != 0x80)
+			units += c >= 0xF0 ? 2 : 1;
+	}
+	return units;
+}
+
+/// @returns the LSP position of the byte offset @a _offset of @a _text.
+Json::Value toPosition(string const& _text, int _offset)
+{
+	size_t offset = static_cast<size_t>(max(_offset, 0));
+	int line = 0;
+	size_t lineStart = 0;
+	for (size_t i = 0; i < offset && i < _text.size(); ++i)
+		if (_text[i] == '\n')
+		{
+			++line;
+			lineStart = i + 1;
+		}
+	Json::Value position;
+	position["line"] = line;
+	position["character"] = utf16Length(_text, lineStart, offset);
+	return position;
+}
+
+/// @returns the byte offset of the LSP position @a _position in @a _text.
+optional<int> toOffset(string const& _text, Json::Value const& _position)
+{
+	if (!_position["line"].isUInt() || !_position["character"].isUInt())
+		return nullopt;
+	size_t offset = 0;
+	for (unsigned line = _position["line"].asUInt(); line > 0; --line)
+	{
+		offset = _text.find('\n', offset);
+		if (offset == string::npos)
+			return nullopt;
+		++offset;
+	}
+	for (unsigned units = 0; units < _position["character"].asUInt() && offset < _text.size() && _text[offset] != '\n';)
+	{
+		units += static_cast<unsigned char>(_text[offset]) >= 0xF0 ? 2 : 1;
+		do
+			++offset;
+		while (offset < _text.size() && (static_cast<unsigned char>(_text[offset]) & 0xC0) == 0x80);
+	}
+	return static_cast<int>(offset);
+}
+
+/// Finds the innermost node whose location contains an offset.
+class NodeFinder: public ASTConstVisitor
+{
+public:
+	explicit NodeFinder(int _offset): m_offset(_offset) {}
+	ASTNode const* node() const { return m_node; }
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		SourceLocation const& location = _node.location();
+		if (location.start < 0 || location.start > m_offset || m_offset > location.end)
+			return false;
+		m_node = &_node;
+		return true;
+	}
+
+	int m_offset;
+	ASTNode const* m_node = nullptr;
+};
+
+Declaration const* referencedDeclaration(ASTNode const& _node)
+{
+	if (auto identifier = dynamic_cast<Identifier const*>(&_node))
+		return identifier->annotation().referencedDeclaration;
+	if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+		return memberAccess->annotation().referencedDeclaration;
+	if (auto path = dynamic_cast<IdentifierPath const*>(&_node))
+		return path->annotation().referencedDeclaration;
+	return dynamic_cast<Declaration const*>(&_node);
+}
+
+/// Collects the nodes referring to a declaration.
+class ReferenceCollector: public ASTConstVisitor
+{
+public:
+	explicit ReferenceCollector(Declaration const& _declaration): m_declaration(_declaration) {}
+	vector<SourceLocation> const& locations() const { return m_locations; }
+
+private:
+	bool visit(Identifier const& _node) override { return check(_node); }
+	bool visit(MemberAccess const& _node) override { return check(_node); }
+	bool visit(IdentifierPath const& _node) override { return check(_node); }
+
+	bool check(ASTNode const& _node)
+	{
+		if (referencedDeclaration(_node) == &m_declaration)
+			m_locations.push_back(_node.location());
+		return true;
+	}
+
+	Declaration const& m_declaration;
+	vector<SourceLocation> m_locations;
+};
+
+string hoverText(ASTNode const& _node)
+{
+	if (auto literal = dynamic_cast<Literal const*>(&_node))
+	{
+		if (literal->looksLikeViteAddress() && literal->viteAddress())
+			return
+				"address " + literal->getViteAddressHex() +
+				((*literal->viteAddress())[20] ? " (contract)" : " (user)");
+		if (literal->looksLikeViteTokenId() && literal->viteTokenId())
+			return "tokenId " + literal->getViteTokenIdHex();
+	}
+	if (auto expression = dynamic_cast<Expression const*>(&_node))
+		if (expression->annotation().type)
+			return expression->annotation().type->toString(false);
+	if (auto variable = dynamic_cast<VariableDeclaration const*>(&_node))
+		if (variable->annotation().type)
+			return variable->annotation().type->toString(false) + " " + variable->name();
+	if (auto typeName = dynamic_cast<TypeName const*>(&_node))
+		if (typeName->annotation().type)
+			return typeName->annotation().type->toString(false);
+	if (auto path = dynamic_cast<IdentifierPath const*>(&_node))
+		if (auto variable = dynamic_cast<VariableDeclaration const*>(path->annotation().referencedDeclaration))
+			if (variable->annotation().type)
+				return variable->annotation().type->toString(false) + " " + variable->name();
+	return {};
+}
+
+ReadCallback::Result readFile(string const& _kind, string const& _path)
+{
+	if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+		return ReadCallback::Result{false, "Unsupported callback kind."};
+	try
+	{
+		if (!boost::filesystem::is_regular_file(_path))
+			return ReadCallback::Result{false, "File not found."};
+		return ReadCallback::Result{true, util::readFileAsString(_path)};
+	}
+	catch (...)
+	{
+		return ReadCallback::Result{false, "Could not read file."};
+	}
+}
+
+}
+
+LanguageServer::LanguageServer(
+	Transport& _transport,
+	vector<CompilerStack::Remapping> _remappings,
+	chrono::milliseconds _debounce
+):
+	m_transport(_transport),
+	m_analysis(readFile, [remappings = move(_remappings)](CompilerStack& _compiler) {
+		_compiler.setRemappings(remappings);
+		_compiler.setParserErrorRecovery(true);
+	}),
+	m_debounce(_debounce),
+	m_handlers{
+		{"initialize", &LanguageServer::handleInitialize},
+		{"shutdown", &LanguageServer::handleShutdown},
+		{"textDocument/didOpen", &LanguageServer::handleDidOpen},
+		{"textDocument/didChange", &LanguageServer::handleDidChange},
+		{"textDocument/didClose", &LanguageServer::handleDidClose},
+		{"textDocument/definition", &LanguageServer::handleDefinition},
+		{"textDocument/hover", &LanguageServer::handleHover},
+		{"textDocument/references", &LanguageServer::handleReferences}
+	}
+{
+}
+
+bool LanguageServer::run()
+{
+	while (true)
+	{
+		optional<Json::Value> message = m_transport.receive(m_analysisDue);
+		if (message && message->isNull())
+			return m_shutdownRequested;
+
+		// A timeout leaves no message: the debounced analysis is due.
+		string const method = message ? (*message)["method"].asString() : "";
+		Json::Value const id = message ? (*message)["id"] : Json::Value{};
+		if (method == "exit")
+			return m_shutdownRequested;
+
+		try
+		{
+			if (!message)
+				analyze();
+			else if (auto handler = m_handlers.find(method); handler != m_handlers.end())
+				(this->*handler->second)(id, (*message)["params"]);
+			// Unknown notifications are ignored, only requests get an error.
+			else if (!id.isNull())
+				m_transport.error(id, c_methodNotFound, "Unknown method " + method);
+		}
+		catch (boost::exception const& _exception)
+		{
+			reportInternalError(id, boost::diagnostic_information(_exception));
+		}
+		catch (std::exception const& _exception)
+		{
+			reportInternalError(id, _exception.what());
+		}
+	}
+}
+
+void LanguageServer::reportInternalError(Json::Value const& _id, string const& _message)
+{
+	if (!_id.isNull())
+		m_transport.error(_id, c_internalError, _message);
+	else
+	{
+		// Notifications and the debounced analysis have nobody to reply to, so the error is logged.
+		Json::Value params;
+		params["type"] = c_messageTypeError;
+		params["message"] = _message;
+		m_transport.notify("window/logMessage", params);
+	}
+}
+
+void LanguageServer::handleInitialize(Json::Value const& _id, Json::Value const&)
+{
+	Json::Value result;
+	result["serverInfo"]["name"] = "solppls";
+	result["serverInfo"]["version"] = string(SolidityppVersionNumber);
+	Json::Value& capabilities = result["capabilities"];
+	capabilities["textDocumentSync"]["openClose"] = true;
+	// Full text on every change.
+	capabilities["textDocumentSync"]["change"] = 1;
+	capabilities["definitionProvider"] = true;
+	capabilities["hoverProvider"] = true;
+	capabilities["referencesProvider"] = true;
+	m_transport.reply(_id, result);
+}
+
+void LanguageServer::handleShutdown(Json::Value const& _id, Json::Value const&)
+{
+	m_shutdownRequested = true;
+	m_transport.reply(_id, Json::nullValue);
+}
+
+void LanguageServer::handleDidOpen(Json::Value const&, Json::Value const& _params)
+{
+	string name = sourceName(_params["textDocument"]["uri"].asString());
+	m_openDocuments.insert(name);
+	m_analysis.setSource(name, _params["textDocument"]["text"].asString());
+	// Other queued messages are still handled first.
+	m_analysisDue = chrono::steady_clock::now();
+}
+
+void LanguageServer::handleDidChange(Json::Value const&, Json::Value const& _params)
+{
+	Json::Value const& changes = _params["contentChanges"];
+	if (!changes.isArray() || changes.empty())
+		return;
+	string name = sourceName(_params["textDocument"]["uri"].asString());
+	m_analysis.setSource(name, changes[changes.size() - 1]["text"].asString());
+	m_analysisDue = chrono::steady_clock::now() + m_debounce;
+}
+
+void LanguageServer::handleDidClose(Json::Value const&, Json::Value const& _params)
+{
+	string name = sourceName(_params["textDocument"]["uri"].asString());
+	m_openDocuments.erase(name);
+	// Unsaved changes are dropped, the file on disk is used again.
+	ReadCallback::Result file = readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), name);
+	if (file.success)
+		m_analysis.setSource(name, file.responseOrErrorMessage);
+	else
+	{
+		m_analysis.removeSource(name);
+		Json::Value params;
+		params["uri"] = uri(name);
+		params["diagnostics"] = Json::arrayValue;
+		m_transport.notify("textDocument/publishDiagnostics", params);
+	}
+	m_analysisDue = chrono::steady_clock::now() + m_debounce;
+}
+
+void LanguageServer::handleDefinition(Json::Value const& _id, Json::Value const& _params)
+{
+	Json::Value result;
+	if (ASTNode const* node = nodeAt(_params))
+	{
+		if (auto import = dynamic_cast<ImportDirective const*>(node))
+		{
+			if (import->annotation().sourceUnit)
+				result = toLocation(import->annotation().sourceUnit->location());
+		}
+		else if (Declaration const* declaration = referencedDeclaration(*node))
+			result = toLocation(declaration->location());
+	}
+	m_transport.reply(_id, result);
+}
+
+void LanguageServer::handleHover(Json::Value const& _id, Json::Value const& _params)
+{
+	Json::Value result;
+	if (ASTNode const* node = nodeAt(_params))
+	{
+		string text = hoverText(*node);
+		if (!text.empty())
+		{
+			result["contents"]["kind"] = "markdown";
+			result["contents"]["value"] = "```solidity\n" + text + "\n```";
+			result["range"] = toLocation(node->location())["range"];
+		}
+	}
+	m_transport.reply(_id, result);
+}
+
+void LanguageServer::handleReferences(Json::Value const& _id, Json::Value const& _params)
+{
+	ASTNode const* node = nodeAt(_params);
+	Declaration const* declaration = node ? referencedDeclaration(*node) : nullptr;
+	if (!declaration || !declaration->location().source)
+	{
+		m_transport.reply(_id, Json::arrayValue);
+		return;
+	}
+
+	// References can be in every source importing the declaration. Analysing them again
+	// replaces all ASTs, so the declaration has to be looked up again.
+	string declarationSource = declaration->location().source->name();
+	set<string> analysed;
+	for (string const& name: m_analysis.compiler()->sourceNames())
+		analysed.insert(name);
+	set<string> dependents = m_analysis.dependents(declarationSource);
+	if (!includes(analysed.begin(), analysed.end(), dependents.begin(), dependents.end()))
+	{
+		m_analysis.invalidate(declarationSource);
+		analyze();
+		node = nodeAt(_params);
+		declaration = node ? referencedDeclaration(*node) : nullptr;
+		if (!declaration)
+		{
+			m_transport.reply(_id, Json::arrayValue);
+			return;
+		}
+	}
+
+	ReferenceCollector collector(*declaration);
+	for (string const& name: m_analysis.compiler()->sourceNames())
+		if (SourceUnit const* ast = m_analysis.compiler()->astIfParsed(name))
+			ast->accept(collector);
+
+	Json::Value result = Json::arrayValue;
+	if (_params["context"]["includeDeclaration"].asBool())
+		result.append(toLocation(declaration->location()));
+	for (SourceLocation const& location: collector.locations())
+		if (Json::Value lspLocation = toLocation(location); !lspLocation.isNull())
+			result.append(lspLocation);
+	m_transport.reply(_id, result);
+}
+
+void LanguageServer::analyze()
+{
+	m_analysisDue.reset();
+	for (string const& name: m_analysis.analyze())
+	{
+		Json::Value diagnostics = Json::arrayValue;
+		for (shared_ptr<Error const> const& error: m_analysis.errors(name))
+		{
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+			Json::Value diagnostic;
+			diagnostic["range"] = toLocation(*location)["range"];
+			diagnostic["severity"] = error->type() == Error::Type::Warning ? 2 : 1;
+			diagnostic["code"] = Json::UInt64(error->errorId().error);
+			diagnostic["source"] = "solppls";
+			if (string const* message = boost::get_error_info<util::errinfo_comment>(*error))
+				diagnostic["message"] = *message;
+			if (auto secondary = boost::get_error_info<errinfo_secondarySourceLocation>(*error))
+				for (auto const& [message, secondaryLocation]: secondary->infos)
+					if (Json::Value lspLocation = toLocation(secondaryLocation); !lspLocation.isNull())
+					{
+						Json::Value information;
+						information["location"] = move(lspLocation);
+						information["message"] = message;
+						diagnostic["relatedInformation"].append(move(information));
+					}
+			diagnostics.append(move(diagnostic));
+		}
+
+		Json::Value params;
+		params["uri"] = uri(name);
+		params["diagnostics"] = move(diagnostics);
+		m_transport.notify("textDocument/publishDiagnostics", params);
+	}
+}
+
+ASTNode const* LanguageServer::nodeAt(Json::Value const& _params)
+{
+	string name = sourceName(_params["textDocument"]["uri"].asString());
+	if (m_analysisDue)
+		analyze();
+	if (!m_analysis.compiler() || !util::contains(m_analysis.compiler()->sourceNames(), name))
+	{
+		m_analysis.invalidate(name);
+		analyze();
+	}
+	CompilerStack const* compiler = m_analysis.compiler();
+	if (!compiler || !util::contains(compiler->sourceNames(), name))
+		return nullptr;
+
+	SourceUnit const* ast = compiler->astIfParsed(name);
+	optional<int> offset = toOffset(compiler->scanner(name).source(), _params["position"]);
+	if (!ast || !offset)
+		return nullptr;
+	NodeFinder finder(*offset);
+	ast->accept(finder);
+	return finder.node();
+}
+
+Json::Value LanguageServer::toLocation(SourceLocation const& _location) const
+{
+	if (!_location.source || _location.start < 0)
+		return Json::nullValue;
+	string const& text = _location.source->source();
+	Json::Value location;
+	location["uri"] = uri(_location.source->name());
+	location["range"]["start"] = toPosition(text, _location.start);
+	location["range"]["end"] = toPosition(text, max(_location.start, _location.end));
+	return location;
+}
+
+string LanguageServer::sourceName(string const& _uri)
+{
+	string path = boost::starts_with(_uri, "file://") ? _uri.substr(7) : _uri;
+	string name;
+	for (size_t i = 0; i < path.size(); ++i)
+		if (
+			path[i] == '%' && i + 2 < path.size() &&
+			isxdigit(static_cast<unsigned char>(path[i + 1])) &&
+			isxdigit(static_cast<unsigned char>(path[i + 2]))
+		)
+		{
+			name += static_cast<char>(stoi(path.substr(i + 1, 2), nullptr, 16));
+			i += 2;
+		}
+		else
+			name += path[i];
+	return name;
+}
+
+string LanguageServer::uri(string const& _sourceName)
+{
+	// Sources that are not files, e.g. from remappings to nothing, keep their name.
+	if (!boost::starts_with(_sourceName, "/"))
+		return _sourceName;
+	string result = "file://";
+	for (char c: _sourceName)
+		if (isalnum(static_cast<unsigned char>(c)) || c == '/' || c == '-' || c == '.' || c == '_' || c == '~')
+			result += c;
+		else
+		{
+			char escaped[4];
+			snprintf(escaped, sizeof(escaped), "%%%02X", static_cast<unsigned char>(c));
+			result += escaped;
+		}
+	return result;
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Language server for Solidity++.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include "Transport.h"
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/IncrementalAnalysis.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <json/json.h>
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+class ASTNode;
+class Declaration;
+class SourceUnit;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Language server offering diagnostics, go-to-definition, hover and find-references.
+ *
+ * Open documents are kept in an IncrementalAnalysis, so an edit only causes the edited
+ * source, its dependents and their imports to be analysed again. Edits are debounced:
+ * the analysis runs once no edit came in for the debounce interval, or earlier if a request
+ * needs its result. Imports of sources that are not open are read from disk.
+ */
+class LanguageServer
+{
+public:
+	LanguageServer(
+		Transport& _transport,
+		std::vector<frontend::CompilerStack::Remapping> _remappings,
+		std::chrono::milliseconds _debounce = std::chrono::milliseconds(300)
+	);
+
+	/// Handles messages until the client sends "exit" or closes the input.
+	/// @returns true if the client asked for a shutdown first.
+	bool run();
+
+private:
+	using Handler = void (LanguageServer::*)(Json::Value const& _id, Json::Value const& _params);
+
+	void handleInitialize(Json::Value const& _id, Json::Value const& _params);
+	void handleShutdown(Json::Value const& _id, Json::Value const& _params);
+	void handleDidOpen(Json::Value const& _id, Json::Value const& _params);
+	void handleDidChange(Json::Value const& _id, Json::Value const& _params);
+	void handleDidClose(Json::Value const& _id, Json::Value const& _params);
+	void handleDefinition(Json::Value const& _id, Json::Value const& _params);
+	void handleHover(Json::Value const& _id, Json::Value const& _params);
+	void handleReferences(Json::Value const& _id, Json::Value const& _params);
+
+	/// Answers the request @a _id with an internal error or, for notifications, logs @a _message.
+	void reportInternalError(Json::Value const& _id, std::string const& _message);
+
+	/// Runs the pending analysis, if any, and publishes the diagnostics of the analysed sources.
+	void analyze();
+	/// Analyses the source @a _sourceName and the sources importing it, unless the last
+	/// analysis already covered them.
+	void analyzeWithDependents(std::string const& _sourceName);
+	/// @returns the innermost node at the text document position of @a _params, if the
+	/// document was analysed.
+	frontend::ASTNode const* nodeAt(Json::Value const& _params);
+
+	/// @returns an LSP location for @a _location or a null value if it has no source.
+	Json::Value toLocation(langutil::SourceLocation const& _location) const;
+	static std::string sourceName(std::string const& _uri);
+	static std::string uri(std::string const& _sourceName);
+
+	Transport& m_transport;
+	frontend::IncrementalAnalysis m_analysis;
+	std::chrono::milliseconds m_debounce;
+	std::map<std::string, Handler> m_handlers;
+	std::set<std::string> m_openDocuments;
+	/// Time at which the debounced analysis of the last edits is due.
+	std::optional<std::chrono::steady_clock::time_point> m_analysisDue;
+	bool m_shutdownRequested = false;
+};
+
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * JSON-RPC message framing of the language server protocol.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include "Transport.h"
+
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <iostream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::lsp;
+
+Transport::Transport(istream& _in, ostream& _out):
+	m_in(_in),
+	m_out(_out),
+	m_reader([this] { readMessages(); })
+{
+}
+
+Transport::~Transport()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopReading = true;
+	}
+	if (m_reader.joinable())
+		m_reader.join();
+}
+
+optional<Json::Value> Transport::receive(optional<chrono::steady_clock::time_point> _deadline)
+{
+	unique_lock<mutex> lock(m_mutex);
+	auto ready = [&] { return !m_messages.empty() || m_closed; };
+	if (!_deadline)
+		m_received.wait(lock, ready);
+	else if (!m_received.wait_until(lock, *_deadline, ready))
+		return nullopt;
+
+	if (m_messages.empty())
+		return Json::Value{};
+	Json::Value message = move(m_messages.front());
+	m_messages.pop_front();
+	return message;
+}
+
+void Transport::reply(Json::Value const& _id, Json::Value _result)
+{
+	Json::Value message;
+	message["id"] = _id;
+	message["result"] = move(_result);
+	send(move(message));
+}
+
+void Transport::error(Json::Value const& _id, int _code, string const& _message)
+{
+	Json::Value message;
+	message["id"] = _id;
+	message["error"]["code"] = _code;
+	message["error"]["message"] = _message;
+	send(move(message));
+}
+
+void Transport::notify(string const& _method, Json::Value _params)
+{
+	Json::Value message;
+	message["method"] = _method;
+	message["params"] = move(_params);
+	send(move(message));
+}
+
+void Transport::readMessages()
+{
+	while (true)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (m_stopReading)
+				break;
+		}
+		optional<Json::Value> message = readMessage();
+		if (!message)
+			break;
+		// Malformed messages cannot be answered, since their id is unknown.
+		if (message->isNull())
+			continue;
+		bool const exit = (*message)["method"] == "exit";
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_messages.push_back(move(*message));
+			m_received.notify_one();
+		}
+		// Nothing is read after "exit", so that the destructor does not wait for more input.
+		if (exit)
+			break;
+	}
+	lock_guard<mutex> lock(m_mutex);
+	m_closed = true;
+	m_received.notify_one();
+}
+
+optional<Json::Value> Transport::readMessage()
+{
+	size_t length = 0;
+	bool hasLength = false;
+	string line;
+	while (getline(m_in, line))
+	{
+		boost::trim_right(line);
+		if (line.empty())
+			break;
+		if (boost::istarts_with(line, "Content-Length:"))
+		{
+			try
+			{
+				length = stoul(line.substr(15));
+				hasLength = true;
+			}
+			catch (logic_error const&)
+			{
+				hasLength = false;
+			}
+		}
+	}
+	if (!m_in)
+		return nullopt;
+	if (!hasLength)
+		return Json::Value{};
+
+	string content(length, '\0');
+	if (!m_in.read(content.data(), static_cast<streamsize>(length)))
+		return nullopt;
+
+	Json::Value message;
+	if (!util::jsonParseStrict(content, message) || !message.isObject())
+		return Json::Value{};
+	return message;
+}
+
+void Transport::send(Json::Value _message)
+{
+	_message["jsonrpc"] = "2.0";
+	string content = util::jsonCompactPrint(_message);
+	lock_guard<mutex> lock(m_mutex);
+	m_out << "Content-Length: " << content.size() << "\r\n\r\n" << content << flush;
+}
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * JSON-RPC message framing of the language server protocol.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace solidity::lsp
+{
+
+/**
+ * Reads and writes messages with a Content-Length header, as used by the language server
+ * protocol over stdio.
+ *
+ * Messages are read by a background thread, so that the server can wait for the next message
+ * with a timeout, which is used to debounce edits. The thread stops at the end of the input
+ * and after the "exit" notification, which is the last message of a session.
+ */
+class Transport
+{
+public:
+	Transport(std::istream& _in, std::ostream& _out);
+	/// Stops the reader thread and joins it. A read in progress cannot be interrupted, so this
+	/// waits until the reader has seen "exit", the end of the input or the next message.
+	~Transport();
+
+	Transport(Transport const&) = delete;
+	Transport& operator=(Transport const&) = delete;
+
+	/// Waits for the next message, at most until @a _deadline if given.
+	/// @returns nullopt on timeout and a null value once the input is closed.
+	std::optional<Json::Value> receive(
+		std::optional<std::chrono::steady_clock::time_point> _deadline = std::nullopt
+	);
+
+	void reply(Json::Value const& _id, Json::Value _result);
+	void error(Json::Value const& _id, int _code, std::string const& _message);
+	void notify(std::string const& _method, Json::Value _params);
+
+private:
+	/// Reads messages from m_in until the input ends.
+	void readMessages();
+	/// @returns the next message, a null value for a malformed one and nullopt at the end of the input.
+	std::optional<Json::Value> readMessage();
+	void send(Json::Value _message);
+
+	std::istream& m_in;
+	std::ostream& m_out;
+	std::mutex m_mutex;
+	std::condition_variable m_received;
+	std::deque<Json::Value> m_messages;
+	bool m_closed = false;
+	/// Set by the destructor, the reader does not start another message afterwards.
+	bool m_stopReading = false;
+	std::thread m_reader;
+};
+
+}
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Solidity++ language server, speaking the language server protocol over stdio.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include "LanguageServer.h"
+#include "Transport.h"
+
+#include <libsolidity/interface/Version.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+int main(int argc, char** argv)
+{
+	vector<CompilerStack::Remapping> remappings;
+	chrono::milliseconds debounce{300};
+	for (int i = 1; i < argc; ++i)
+	{
+		string argument = argv[i];
+		if (argument == "--help")
+		{
+			cout << "solppls, the Solidity++ language server " << SolidityppVersionString << endl;
+			cout << "Usage: solppls [--debounce <ms>] [context:prefix=path ...]" << endl;
+			cout << "Speaks the language server protocol on stdin and stdout." << endl;
+			return 0;
+		}
+		else if (argument == "--debounce" && i + 1 < argc)
+			try
+			{
+				debounce = chrono::milliseconds(stoul(argv[++i]));
+			}
+			catch (logic_error const&)
+			{
+				cerr << "Invalid debounce interval: " << argv[i] << endl;
+				return 1;
+			}
+		else if (auto remapping = CompilerStack::parseRemapping(argument))
+			remappings.push_back(move(*remapping));
+		else
+		{
+			cerr << "Invalid argument: " << argument << endl;
+			return 1;
+		}
+	}
+
+	lsp::Transport transport(cin, cout);
+	lsp::LanguageServer server(transport, move(remappings), debounce);
+	return server.run() ? 0 : 1;
+}
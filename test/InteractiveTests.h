@@ -25,6 +25,7 @@
 #include <test/libsolidity/SyntaxTest.h>
 #include <test/libsolidity/SemanticTest.h>
 #include <test/libsolidity/SMTCheckerTest.h>
+#include <test/libsolidity/ViteSemanticTest.h>
 #include <test/libyul/EwasmTranslationTest.h>
 #include <test/libyul/YulOptimizerTest.h>
 #include <test/libyul/YulInterpreterTest.h>
@@ -63,6 +64,7 @@ Testsuite const g_interactiveTestsuites[] = {
 	{"Syntax",              	"syntax", "",         				 false, false, &SyntaxTest::create},
 	// {"Error Recovery",      "libsolidity", "errorRecoveryTests",  false, false, &SyntaxTest::createErrorRecovery},
 	// {"Semantic",            "libsolidity", "semanticTests",       false, true,  &SemanticTest::create},
+	{"Semantic (ViteVM)",   	"semantic", "",         			 false, false, &ViteSemanticTest::create},
 	// {"JSON AST",            "libsolidity", "ASTJSON",             false, false, &ASTJSONTest::create},
 	// {"JSON ABI",            "libsolidity", "ABIJson",             false, false, &ABIJsonTest::create},
 	// {"SMT Checker",         "libsolidity", "smtCheckerTests",     true,  false, &SMTCheckerTest::create, {"nooptions"}},
@@ -0,0 +1,677 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * In-process ViteVM stand-in used by the test framework.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <test/ViteVM.h>
+
+#include <libsolutil/Blake2.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <functional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::evmasm;
+using namespace solidity::test;
+
+namespace
+{
+
+/// Thrown to abort the execution of a message (out of quota, stack underflow, bad jump, ...).
+struct ViteVMError {};
+
+size_t const c_maxMemory = 1 << 24;
+uint64_t const c_quotaLimit = 10000000;
+
+u256 toU256(h168 const& _address)
+{
+	return u256(h168::Arith(_address));
+}
+
+h168 toAddress(u256 const& _value)
+{
+	return h168(h168::Arith(_value & ((u256(1) << 168) - 1)));
+}
+
+}
+
+h168 const ViteVM::defaultSender = h168("0x00aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa01");
+u256 const ViteVM::viteTokenId = u256("0x5649544520544f4b454e");
+
+uint64_t ViteQuotaSchedule::staticQuota(Instruction _instruction) const
+{
+	switch (_instruction)
+	{
+	case Instruction::EXP:
+		return expQuota;
+	case Instruction::KECCAK256:
+	case Instruction::BLAKE2B:
+		return hashQuota;
+	case Instruction::SLOAD:
+		return sloadQuota;
+	case Instruction::SSTORE:
+		return sstoreQuota;
+	case Instruction::JUMPDEST:
+		return jumpdestQuota;
+	case Instruction::CALL:
+	case Instruction::SYNCCALL:
+		return callQuota;
+	case Instruction::CALLBACKDEST:
+		return callbackDestQuota;
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return createQuota;
+	default:
+		if (isLogInstruction(_instruction))
+			return logQuota + logTopicQuota * getLogNumber(_instruction);
+		Tier tier = instructionInfo(_instruction).gasPriceTier;
+		if (tier >= Tier::Special)
+			return 0;
+		return tierStepQuota[static_cast<unsigned>(tier)];
+	}
+}
+
+optional<h168> ViteVM::deploy(bytes const& _creationCode, u256 const& _amount, h168 const& _sender)
+{
+	ViteMessage message;
+	message.from = _sender;
+	message.to = newAddress();
+	message.tokenId = viteTokenId;
+	message.amount = _amount;
+	if (_amount > balance(_sender))
+		return nullopt;
+
+	m_accounts[_sender].balances[viteTokenId] -= _amount;
+	m_accounts[message.to].balances[viteTokenId] += _amount;
+	ViteExecutionResult result = execute(message, _creationCode, true);
+	m_history.emplace_back(message, result);
+	if (!result.success)
+	{
+		m_accounts.erase(message.to);
+		m_accounts[_sender].balances[viteTokenId] += _amount;
+		return nullopt;
+	}
+	m_accounts[message.to].code = result.output;
+	runQueue();
+	return message.to;
+}
+
+ViteExecutionResult ViteVM::call(
+	h168 const& _to,
+	bytes const& _data,
+	u256 const& _amount,
+	u256 const& _tokenId,
+	h168 const& _sender
+)
+{
+	ViteMessage message{ViteMessage::Kind::Call, _sender, _to, _tokenId, _amount, _data, 0, true};
+	if (_amount > balance(_sender, _tokenId))
+	{
+		m_history.emplace_back(std::move(message), ViteExecutionResult{});
+		return m_history.back().second;
+	}
+
+	size_t first = m_history.size();
+	m_accounts[_sender].balances[_tokenId] -= _amount;
+	send(std::move(message));
+	runQueue();
+	solAssert(m_history.size() > first, "");
+	return m_history[first].second;
+}
+
+size_t ViteVM::runQueue(size_t _maxMessages)
+{
+	size_t executed = 0;
+	while (!m_queue.empty() && executed < _maxMessages)
+	{
+		ViteMessage message = std::move(m_queue.front());
+		m_queue.pop_front();
+
+		Account& receiver = m_accounts[message.to];
+		receiver.balances[message.tokenId] += message.amount;
+		receiver.height++;
+
+		ViteExecutionResult result;
+		if (receiver.code.empty())
+			result.success = true;
+		else
+			result = execute(message, receiver.code, false);
+
+		// The amount is refunded if the receive block fails.
+		if (!result.success && message.amount > 0)
+		{
+			m_accounts[message.to].balances[message.tokenId] -= message.amount;
+			m_accounts[message.from].balances[message.tokenId] += message.amount;
+		}
+
+		m_history.emplace_back(std::move(message), std::move(result));
+		executed++;
+	}
+	return executed;
+}
+
+u256 ViteVM::storage(h168 const& _account, u256 const& _key) const
+{
+	auto account = m_accounts.find(_account);
+	if (account == m_accounts.end())
+		return 0;
+	auto slot = account->second.storage.find(_key);
+	return slot == account->second.storage.end() ? u256(0) : slot->second;
+}
+
+u256 ViteVM::balance(h168 const& _account, u256 const& _tokenId) const
+{
+	auto account = m_accounts.find(_account);
+	if (account == m_accounts.end())
+		return 0;
+	auto balance = account->second.balances.find(_tokenId);
+	return balance == account->second.balances.end() ? u256(0) : balance->second;
+}
+
+void ViteVM::setBalance(h168 const& _account, u256 const& _amount, u256 const& _tokenId)
+{
+	m_accounts[_account].balances[_tokenId] = _amount;
+}
+
+bytes const& ViteVM::code(h168 const& _account) const
+{
+	static bytes const empty;
+	auto account = m_accounts.find(_account);
+	return account == m_accounts.end() ? empty : account->second.code;
+}
+
+uint64_t ViteVM::totalQuota() const
+{
+	uint64_t total = 0;
+	for (auto const& entry: m_history)
+		total += entry.second.quotaUsed;
+	return total;
+}
+
+h168 ViteVM::newAddress()
+{
+	bytes seed = toBigEndian(u256(++m_nonce));
+	h256 hash = blake2b(seed);
+	// Contract addresses end with 0x01 in Vite.
+	bytes address(hash.data(), hash.data() + 20);
+	address.push_back(0x01);
+	return h168(address);
+}
+
+ViteExecutionResult ViteVM::execute(ViteMessage const& _message, bytes const& _code, bool _creation)
+{
+	ViteExecutionResult result;
+	Account& self = m_accounts[_message.to];
+	// Undoes the changes of this message in reverse order if it fails.
+	vector<function<void()>> journal;
+	size_t const queueSize = m_queue.size();
+	vector<u256> stack;
+	bytes memory;
+	bytes returnData;
+	size_t pc = 0;
+	// The sync call that has to be answered once this execution finishes, if any.
+	optional<ViteMessage> origin;
+	if (_message.kind == ViteMessage::Kind::SyncCall)
+		origin = _message;
+
+	// The callback data starts with the callback id, the remainder is the return data of the callee.
+	if (_message.kind == ViteMessage::Kind::Callback)
+		returnData = bytes(_message.data.begin() + min<size_t>(4, _message.data.size()), _message.data.end());
+
+	bytes const& calldata = _message.data;
+
+	auto charge = [&](Instruction _instruction, uint64_t _quota)
+	{
+		result.quotaUsed += _quota;
+		result.quotaByInstruction[_instruction] += _quota;
+		if (result.quotaUsed > c_quotaLimit)
+			throw ViteVMError{};
+	};
+	auto pop = [&]() -> u256
+	{
+		if (stack.empty())
+			throw ViteVMError{};
+		u256 value = stack.back();
+		stack.pop_back();
+		return value;
+	};
+	auto push = [&](u256 _value)
+	{
+		if (stack.size() >= 1024)
+			throw ViteVMError{};
+		stack.push_back(std::move(_value));
+	};
+	auto touchMemory = [&](Instruction _instruction, u256 const& _offset, u256 const& _size)
+	{
+		if (_size == 0)
+			return;
+		if (_offset + _size > c_maxMemory)
+			throw ViteVMError{};
+		size_t end = static_cast<size_t>(_offset + _size);
+		size_t newSize = (end + 31) / 32 * 32;
+		if (newSize > memory.size())
+		{
+			size_t oldWords = memory.size() / 32;
+			size_t newWords = newSize / 32;
+			auto cost = [&](size_t _words) { return m_schedule.memoryQuota * _words + _words * _words / 512; };
+			charge(_instruction, cost(newWords) - cost(oldWords));
+			memory.resize(newSize);
+		}
+	};
+	auto copyToMemory = [&](Instruction _instruction, bytes const& _source, u256 const& _memOffset, u256 const& _srcOffset, u256 const& _size)
+	{
+		touchMemory(_instruction, _memOffset, _size);
+		charge(_instruction, m_schedule.copyQuota * static_cast<uint64_t>((_size + 31) / 32));
+		for (size_t i = 0; i < static_cast<size_t>(_size); ++i)
+		{
+			u256 index = _srcOffset + i;
+			memory[static_cast<size_t>(_memOffset) + i] = index < _source.size() ? _source[static_cast<size_t>(index)] : 0;
+		}
+	};
+	auto memoryRange = [&](u256 const& _offset, u256 const& _size) -> bytes
+	{
+		if (_size == 0)
+			return {};
+		auto begin = memory.begin() + static_cast<ptrdiff_t>(_offset);
+		return bytes(begin, begin + static_cast<ptrdiff_t>(_size));
+	};
+	auto isJumpDest = [&](u256 const& _target) -> bool
+	{
+		if (_target >= _code.size() || _code[static_cast<size_t>(_target)] != uint8_t(Instruction::JUMPDEST))
+			return false;
+		// Make sure the target is not inside push data.
+		size_t i = 0;
+		while (i < static_cast<size_t>(_target))
+			i += isPushInstruction(Instruction(_code[i])) ? getPushNumber(Instruction(_code[i])) + 1 : 1;
+		return i == static_cast<size_t>(_target);
+	};
+	auto enqueueCall = [&](ViteMessage::Kind _kind, uint32_t _callbackId) -> h168
+	{
+		h168 to = toAddress(pop());
+		u256 tokenId = pop();
+		u256 amount = pop();
+		u256 argsOffset = pop();
+		u256 argsLength = pop();
+		touchMemory(_kind == ViteMessage::Kind::SyncCall ? Instruction::SYNCCALL : Instruction::CALL, argsOffset, argsLength);
+		if (self.balances[tokenId] < amount)
+			throw ViteVMError{};
+		journal.emplace_back([&self, tokenId, previous = self.balances[tokenId]]() { self.balances[tokenId] = previous; });
+		self.balances[tokenId] -= amount;
+		send(ViteMessage{_kind, _message.to, to, tokenId, amount, memoryRange(argsOffset, argsLength), _callbackId, true});
+		return to;
+	};
+
+	bool halted = false;
+	try
+	{
+		while (!halted && pc < _code.size())
+		{
+			Instruction instruction = Instruction(_code[pc]);
+			if (!isValidInstruction(instruction))
+				throw ViteVMError{};
+			charge(instruction, m_schedule.staticQuota(instruction));
+
+			if (isPushInstruction(instruction))
+			{
+				unsigned size = getPushNumber(instruction);
+				u256 value = 0;
+				for (unsigned i = 1; i <= size; ++i)
+					value = (value << 8) | (pc + i < _code.size() ? _code[pc + i] : 0);
+				push(value);
+				pc += size + 1;
+				continue;
+			}
+			if (isDupInstruction(instruction))
+			{
+				unsigned n = getDupNumber(instruction);
+				if (stack.size() < n)
+					throw ViteVMError{};
+				push(stack[stack.size() - n]);
+				pc++;
+				continue;
+			}
+			if (isSwapInstruction(instruction))
+			{
+				unsigned n = getSwapNumber(instruction);
+				if (stack.size() <= n)
+					throw ViteVMError{};
+				swap(stack.back(), stack[stack.size() - 1 - n]);
+				pc++;
+				continue;
+			}
+			if (isLogInstruction(instruction))
+			{
+				u256 offset = pop();
+				u256 size = pop();
+				for (unsigned i = 0; i < getLogNumber(instruction); ++i)
+					pop();
+				touchMemory(instruction, offset, size);
+				charge(instruction, m_schedule.logDataQuota * static_cast<uint64_t>(size));
+				pc++;
+				continue;
+			}
+
+			size_t nextPC = pc + 1;
+			switch (instruction)
+			{
+			case Instruction::STOP:
+				nextPC = _code.size();
+				break;
+			case Instruction::ADD: { u256 a = pop(); u256 b = pop(); push(a + b); break; }
+			case Instruction::MUL: { u256 a = pop(); u256 b = pop(); push(a * b); break; }
+			case Instruction::SUB: { u256 a = pop(); u256 b = pop(); push(a - b); break; }
+			case Instruction::DIV: { u256 a = pop(); u256 b = pop(); push(b == 0 ? u256(0) : a / b); break; }
+			case Instruction::SDIV:
+			{
+				s256 a = u2s(pop());
+				s256 b = u2s(pop());
+				push(b == 0 ? u256(0) : s2u(a / b));
+				break;
+			}
+			case Instruction::MOD: { u256 a = pop(); u256 b = pop(); push(b == 0 ? u256(0) : a % b); break; }
+			case Instruction::SMOD:
+			{
+				s256 a = u2s(pop());
+				s256 b = u2s(pop());
+				push(b == 0 ? u256(0) : s2u(a % b));
+				break;
+			}
+			case Instruction::ADDMOD:
+			{
+				bigint a = pop();
+				bigint b = pop();
+				bigint m = pop();
+				push(m == 0 ? u256(0) : u256((a + b) % m));
+				break;
+			}
+			case Instruction::MULMOD:
+			{
+				bigint a = pop();
+				bigint b = pop();
+				bigint m = pop();
+				push(m == 0 ? u256(0) : u256((a * b) % m));
+				break;
+			}
+			case Instruction::EXP:
+			{
+				u256 base = pop();
+				u256 exponent = pop();
+				charge(instruction, m_schedule.expByteQuota * bytesRequired(exponent));
+				push(u256(boost::multiprecision::powm(bigint(base), bigint(exponent), bigint(1) << 256)));
+				break;
+			}
+			case Instruction::SIGNEXTEND:
+			{
+				u256 position = pop();
+				u256 value = pop();
+				if (position < 31)
+				{
+					unsigned bit = static_cast<unsigned>(position) * 8 + 7;
+					u256 mask = (u256(1) << bit) - 1;
+					value = boost::multiprecision::bit_test(value, bit) ? value | ~mask : value & mask;
+				}
+				push(value);
+				break;
+			}
+			case Instruction::LT: { u256 a = pop(); u256 b = pop(); push(a < b ? 1 : 0); break; }
+			case Instruction::GT: { u256 a = pop(); u256 b = pop(); push(a > b ? 1 : 0); break; }
+			case Instruction::SLT: { s256 a = u2s(pop()); s256 b = u2s(pop()); push(a < b ? 1 : 0); break; }
+			case Instruction::SGT: { s256 a = u2s(pop()); s256 b = u2s(pop()); push(a > b ? 1 : 0); break; }
+			case Instruction::EQ: { u256 a = pop(); u256 b = pop(); push(a == b ? 1 : 0); break; }
+			case Instruction::ISZERO: push(pop() == 0 ? 1 : 0); break;
+			case Instruction::AND: { u256 a = pop(); u256 b = pop(); push(a & b); break; }
+			case Instruction::OR: { u256 a = pop(); u256 b = pop(); push(a | b); break; }
+			case Instruction::XOR: { u256 a = pop(); u256 b = pop(); push(a ^ b); break; }
+			case Instruction::NOT: push(~pop()); break;
+			case Instruction::BYTE:
+			{
+				u256 index = pop();
+				u256 value = pop();
+				push(index >= 32 ? u256(0) : (value >> (8 * (31 - static_cast<unsigned>(index)))) & 0xff);
+				break;
+			}
+			case Instruction::SHL: { u256 shift = pop(); u256 value = pop(); push(shift >= 256 ? u256(0) : value << static_cast<unsigned>(shift)); break; }
+			case Instruction::SHR: { u256 shift = pop(); u256 value = pop(); push(shift >= 256 ? u256(0) : value >> static_cast<unsigned>(shift)); break; }
+			case Instruction::SAR:
+			{
+				u256 shift = pop();
+				s256 value = u2s(pop());
+				if (shift >= 256)
+					push(value < 0 ? ~u256(0) : u256(0));
+				else
+					push(s2u(value >> static_cast<unsigned>(shift)));
+				break;
+			}
+			case Instruction::KECCAK256:
+			case Instruction::BLAKE2B:
+			{
+				u256 offset = pop();
+				u256 size = pop();
+				touchMemory(instruction, offset, size);
+				charge(instruction, m_schedule.hashWordQuota * static_cast<uint64_t>((size + 31) / 32));
+				bytes data = memoryRange(offset, size);
+				h256 hash = instruction == Instruction::BLAKE2B ? blake2b(data) : keccak256(data);
+				push(u256(h256::Arith(hash)));
+				break;
+			}
+			case Instruction::ADDRESS: push(toU256(_message.to)); break;
+			case Instruction::BALANCE: push(self.balances[pop()]); break;
+			case Instruction::SELFBALANCE: push(self.balances[viteTokenId]); break;
+			case Instruction::ORIGIN:
+			case Instruction::CALLER: push(toU256(_message.from)); break;
+			case Instruction::CALLVALUE: push(_message.amount); break;
+			case Instruction::TOKENID: push(_message.tokenId); break;
+			case Instruction::CALLDATALOAD:
+			{
+				u256 offset = pop();
+				u256 value = 0;
+				for (size_t i = 0; i < 32; ++i)
+					value = (value << 8) | (offset + i < calldata.size() ? calldata[static_cast<size_t>(offset) + i] : 0);
+				push(value);
+				break;
+			}
+			case Instruction::CALLDATASIZE: push(calldata.size()); break;
+			case Instruction::CALLDATACOPY:
+			{
+				u256 memOffset = pop();
+				u256 offset = pop();
+				u256 size = pop();
+				copyToMemory(instruction, calldata, memOffset, offset, size);
+				break;
+			}
+			case Instruction::CODESIZE: push(_code.size()); break;
+			case Instruction::CODECOPY:
+			{
+				u256 memOffset = pop();
+				u256 offset = pop();
+				u256 size = pop();
+				copyToMemory(instruction, _code, memOffset, offset, size);
+				break;
+			}
+			case Instruction::RETURNDATASIZE: push(returnData.size()); break;
+			case Instruction::RETURNDATACOPY:
+			{
+				u256 memOffset = pop();
+				u256 offset = pop();
+				u256 size = pop();
+				if (offset + size > returnData.size())
+					throw ViteVMError{};
+				copyToMemory(instruction, returnData, memOffset, offset, size);
+				break;
+			}
+			case Instruction::NUMBER: push(m_height); break;
+			case Instruction::ACCOUNTHEIGHT: push(self.height); break;
+			case Instruction::TIMESTAMP: push(m_height); break;
+			case Instruction::PREVHASH:
+			case Instruction::FROMHASH:
+			case Instruction::SEED:
+			case Instruction::RANDOM:
+				push(u256(h256::Arith(blake2b(toBigEndian(self.height) + toBigEndian(u256(uint8_t(instruction)))))));
+				break;
+			case Instruction::CHAINID: push(1); break;
+			case Instruction::POP: pop(); break;
+			case Instruction::MLOAD:
+			{
+				u256 offset = pop();
+				touchMemory(instruction, offset, 32);
+				push(fromBigEndian<u256>(memoryRange(offset, 32)));
+				break;
+			}
+			case Instruction::MSTORE:
+			{
+				u256 offset = pop();
+				u256 value = pop();
+				touchMemory(instruction, offset, 32);
+				bytesRef word(memory.data() + static_cast<size_t>(offset), 32);
+				toBigEndian(value, word);
+				break;
+			}
+			case Instruction::MSTORE8:
+			{
+				u256 offset = pop();
+				u256 value = pop();
+				touchMemory(instruction, offset, 1);
+				memory[static_cast<size_t>(offset)] = static_cast<uint8_t>(value & 0xff);
+				break;
+			}
+			case Instruction::SLOAD: push(self.storage[pop()]); break;
+			case Instruction::SSTORE:
+			{
+				u256 key = pop();
+				u256 value = pop();
+				auto slot = self.storage.find(key);
+				optional<u256> previous;
+				if (slot != self.storage.end())
+					previous = slot->second;
+				journal.emplace_back([&self, key, previous]() {
+					if (previous)
+						self.storage[key] = *previous;
+					else
+						self.storage.erase(key);
+				});
+				self.storage[key] = value;
+				break;
+			}
+			case Instruction::JUMP:
+			{
+				u256 target = pop();
+				if (!isJumpDest(target))
+					throw ViteVMError{};
+				nextPC = static_cast<size_t>(target);
+				break;
+			}
+			case Instruction::JUMPI:
+			{
+				u256 target = pop();
+				if (pop() != 0)
+				{
+					if (!isJumpDest(target))
+						throw ViteVMError{};
+					nextPC = static_cast<size_t>(target);
+				}
+				break;
+			}
+			case Instruction::PC: push(pc); break;
+			case Instruction::MSIZE: push(memory.size()); break;
+			case Instruction::GAS: push(c_quotaLimit - result.quotaUsed); break;
+			case Instruction::JUMPDEST: break;
+			case Instruction::CALL:
+				enqueueCall(ViteMessage::Kind::Call, 0);
+				break;
+			case Instruction::SYNCCALL:
+			{
+				// Stack (top): [callbackId, addr, tokenId, amount, argsOffset, argsLength]
+				uint32_t callbackId = static_cast<uint32_t>(pop());
+				ContinuationKey key{enqueueCall(ViteMessage::Kind::SyncCall, callbackId), callbackId};
+				// Save the context; execution is expected to STOP right after and resume at CALLBACKDEST.
+				self.continuations[key].push_back(Continuation{stack, memory, origin});
+				journal.emplace_back([&self, key]() {
+					auto& pending = self.continuations[key];
+					pending.pop_back();
+					if (pending.empty())
+						self.continuations.erase(key);
+				});
+				result.suspended = true;
+				break;
+			}
+			case Instruction::CALLBACKDEST:
+			{
+				if (_message.kind != ViteMessage::Kind::Callback)
+					throw ViteVMError{};
+				// Callbacks of the same callee and callback id arrive in the order of the sync calls.
+				ContinuationKey key{_message.from, _message.callbackId};
+				auto pending = self.continuations.find(key);
+				if (pending == self.continuations.end())
+					throw ViteVMError{};
+				Continuation continuation = pending->second.front();
+				pending->second.pop_front();
+				if (pending->second.empty())
+					self.continuations.erase(pending);
+				journal.emplace_back([&self, key, continuation]() { self.continuations[key].push_front(continuation); });
+				stack = continuation.stack;
+				memory = continuation.memory;
+				origin = continuation.origin;
+				push(_message.success ? 1 : 0);
+				break;
+			}
+			case Instruction::RETURN:
+			case Instruction::REVERT:
+			{
+				u256 offset = pop();
+				u256 size = pop();
+				touchMemory(instruction, offset, size);
+				result.output = memoryRange(offset, size);
+				result.success = instruction == Instruction::RETURN;
+				result.suspended = false;
+				halted = true;
+				break;
+			}
+			case Instruction::INVALID:
+				throw ViteVMError{};
+			default:
+				// CREATE, DELEGATECALL, SELFDESTRUCT and the EVM-only opcodes are not supported by this stand-in.
+				throw ViteVMError{};
+			}
+			pc = nextPC;
+		}
+		if (!halted)
+			result.success = true;
+	}
+	catch (ViteVMError const&)
+	{
+		result.success = false;
+		result.suspended = false;
+		result.output.clear();
+	}
+
+	if (!result.success)
+	{
+		for (auto undo = journal.rbegin(); undo != journal.rend(); ++undo)
+			(*undo)();
+		m_queue.erase(m_queue.begin() + static_cast<ptrdiff_t>(queueSize), m_queue.end());
+	}
+
+	// RETURN and REVERT answer the pending sync call with a callback, unless the callee suspended itself again.
+	if (origin && !result.suspended && !_creation)
+	{
+		bytes callbackId = toBigEndian(u256(origin->callbackId));
+		send(ViteMessage{
+			ViteMessage::Kind::Callback,
+			_message.to,
+			origin->from,
+			viteTokenId,
+			0,
+			bytes(callbackId.end() - 4, callbackId.end()) + result.output,
+			origin->callbackId,
+			result.success
+		});
+	}
+	return result;
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * In-process ViteVM stand-in used by the test framework.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/FixedHash.h>
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::test
+{
+
+/// Quota schedule of the ViteVM, indexed by instruction.
+/// The numbers follow the base quota table of go-vite; instructions that are
+/// not listed are charged by their gas price tier.
+struct ViteQuotaSchedule
+{
+	uint64_t tierStepQuota[static_cast<unsigned>(evmasm::Tier::Invalid)] = {0, 2, 3, 5, 8, 10, 20, 700, 400, 0};
+	uint64_t expQuota = 10;
+	uint64_t expByteQuota = 50;
+	uint64_t hashQuota = 30;
+	uint64_t hashWordQuota = 6;
+	uint64_t sloadQuota = 200;
+	uint64_t sstoreQuota = 5000;
+	uint64_t jumpdestQuota = 1;
+	uint64_t logQuota = 375;
+	uint64_t logTopicQuota = 375;
+	uint64_t logDataQuota = 8;
+	uint64_t callQuota = 700;
+	uint64_t callbackDestQuota = 700;
+	uint64_t createQuota = 32000;
+	uint64_t memoryQuota = 3;
+	uint64_t copyQuota = 3;
+
+	/// @returns the static quota of @a _instruction, not including memory expansion or copy costs.
+	uint64_t staticQuota(evmasm::Instruction _instruction) const;
+};
+
+/// A message (send block) travelling between accounts.
+struct ViteMessage
+{
+	enum class Kind { Call, SyncCall, Callback };
+
+	Kind kind = Kind::Call;
+	util::h168 from;
+	util::h168 to;
+	u256 tokenId;
+	u256 amount;
+	bytes data;
+	/// Callback id of a sync call, or the id being answered by a callback.
+	uint32_t callbackId = 0;
+	/// Success flag carried by a callback.
+	bool success = true;
+};
+
+/// Result of executing one message.
+struct ViteExecutionResult
+{
+	bool success = false;
+	bool suspended = false;
+	bytes output;
+	uint64_t quotaUsed = 0;
+	/// Quota charged per executed instruction.
+	std::map<evmasm::Instruction, uint64_t> quotaByInstruction;
+};
+
+/**
+ * Minimal interpreter of ViteVM bytecode.
+ *
+ * Calls are asynchronous: CALL and SYNCCALL only enqueue a message, which is
+ * executed once the current message finishes. A SYNCCALL suspends the caller,
+ * and the context is restored at CALLBACKDEST when the callee sends back its
+ * callback on RETURN or REVERT.
+ *
+ * If a message fails, its storage writes, balance changes, continuations and
+ * queued messages are rolled back and only its amount is refunded to the sender.
+ */
+class ViteVM
+{
+public:
+	static util::h168 const defaultSender;
+	static u256 const viteTokenId;
+
+	explicit ViteVM(ViteQuotaSchedule _schedule = {}): m_schedule(std::move(_schedule)) {}
+
+	/// Runs the creation code and stores the returned runtime code at a fresh address.
+	/// @returns the address of the new contract, or nullopt if creation failed or
+	/// @a _amount exceeds the balance of @a _sender.
+	std::optional<util::h168> deploy(
+		bytes const& _creationCode,
+		u256 const& _amount = 0,
+		util::h168 const& _sender = defaultSender
+	);
+
+	/// Sends a message from @a _sender to @a _to and executes the resulting
+	/// message queue until it is empty.
+	/// @returns the result of executing the first message. The message fails without being
+	/// executed if @a _amount exceeds the balance of @a _sender.
+	ViteExecutionResult call(
+		util::h168 const& _to,
+		bytes const& _data,
+		u256 const& _amount = 0,
+		u256 const& _tokenId = viteTokenId,
+		util::h168 const& _sender = defaultSender
+	);
+
+	/// Enqueues a message without executing it.
+	void send(ViteMessage _message) { m_queue.push_back(std::move(_message)); }
+	/// Executes queued messages until the queue is empty or @a _maxMessages have been processed.
+	/// @returns the number of messages executed.
+	size_t runQueue(size_t _maxMessages = 1024);
+
+	u256 storage(util::h168 const& _account, u256 const& _key) const;
+	u256 balance(util::h168 const& _account, u256 const& _tokenId = viteTokenId) const;
+	void setBalance(util::h168 const& _account, u256 const& _amount, u256 const& _tokenId = viteTokenId);
+	bytes const& code(util::h168 const& _account) const;
+	/// Installs @a _runtimeCode at @a _account without running any creation code.
+	void setCode(util::h168 const& _account, bytes _runtimeCode) { m_accounts[_account].code = std::move(_runtimeCode); }
+
+	/// @returns the results of all messages executed so far, in execution order.
+	std::vector<std::pair<ViteMessage, ViteExecutionResult>> const& history() const { return m_history; }
+	/// @returns the total quota of all messages executed so far.
+	uint64_t totalQuota() const;
+
+	void setHeight(u256 _height) { m_height = std::move(_height); }
+
+private:
+	/// Execution context saved by SYNCCALL and restored by CALLBACKDEST.
+	struct Continuation
+	{
+		std::vector<u256> stack;
+		bytes memory;
+		/// The sync call that is answered once the suspended execution finishes.
+		std::optional<ViteMessage> origin;
+	};
+
+	/// Callee and callback id of a sync call.
+	using ContinuationKey = std::pair<util::h168, uint32_t>;
+
+	struct Account
+	{
+		bytes code;
+		std::map<u256, u256> storage;
+		std::map<u256, u256> balances;
+		u256 height;
+		/// Pending continuations of the sync calls of this account, in the order of the calls.
+		std::map<ContinuationKey, std::deque<Continuation>> continuations;
+	};
+
+	ViteExecutionResult execute(ViteMessage const& _message, bytes const& _code, bool _creation);
+	util::h168 newAddress();
+
+	ViteQuotaSchedule m_schedule;
+	std::map<util::h168, Account> m_accounts;
+	std::deque<ViteMessage> m_queue;
+	std::vector<std::pair<ViteMessage, ViteExecutionResult>> m_history;
+	u256 m_height = 1;
+	uint64_t m_nonce = 0;
+};
+
+}
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Import time of AST snapshots compared with the JSON AST import and with parsing the sources again.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <libsolidity/ast/ASTJsonImporter.h>
+#include <libsolidity/ast/ASTSnapshot.h>
+#include <libsolidity/ast/SolidityppASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/MappedFile.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// A source in the three import formats.
+struct Input
+{
+	string name;
+	string source;
+	string json;
+	string snapshot;
+};
+
+/// @returns a contract of about @a _size bytes with state variables, loops and internal calls.
+string syntheticSource(size_t _size)
+{
+	string source = "pragma soliditypp >=0.8.0;\n\ncontract Synthetic {\n    mapping(address => uint256) balances;\n";
+	for (size_t i = 0; source.size() < _size; ++i)
+	{
+		string index = to_string(i);
+		source +=
+			"    /// @notice Sums the balances of the given accounts.\n"
+			"    function sum" + index + "(address[] calldata accounts, uint256 offset) external view returns (uint256 total) {\n"
+			"        for (uint256 j = 0; j < accounts.length; j++)\n"
+			"            total += balances[accounts[j]] * (offset + " + index + ") / 2;\n"
+			"        if (total > 1000 && accounts.length != 0)\n"
+			"            total = scale" + index + "(total, offset);\n"
+			"    }\n\n"
+			"    function scale" + index + "(uint256 value, uint256 factor) internal pure returns (uint256) {\n"
+			"        return factor == 0 ? value : value - value / factor;\n"
+			"    }\n\n";
+	}
+	return source + "}\n";
+}
+
+/// @returns @a _source in all import formats, or nullopt if it does not compile on its own or
+/// the JSON importer does not support it, e.g. because it uses Solidity++ expressions.
+optional<Input> prepare(string const& _name, string _source)
+{
+	CompilerStack compiler;
+	compiler.setSources({{_name, _source}});
+	if (!compiler.parseAndAnalyze())
+		return nullopt;
+
+	Input input{_name, move(_source), {}, compiler.astSnapshot()};
+	input.json = util::jsonCompactPrint(
+		SolidityppASTJsonConverter(compiler.state(), compiler.sourceIndices()).toJson(compiler.ast(_name))
+	);
+	try
+	{
+		Json::Value ast;
+		if (!util::jsonParseStrict(input.json, ast))
+			return nullopt;
+		ASTJsonImporter(langutil::EVMVersion()).jsonToSourceUnit({{_name, ast}});
+	}
+	catch (...)
+	{
+		return nullopt;
+	}
+	return input;
+}
+
+/// Runs @a _import for every input @a _repetitions times and prints the time under @a _label.
+void measure(
+	string const& _label,
+	vector<Input> const& _inputs,
+	size_t _repetitions,
+	function<size_t(Input const&)> const& _import
+)
+{
+	size_t bytes = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+		for (Input const& input: _inputs)
+			bytes += _import(input);
+	chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+
+	cout << left << setw(24) << _label << right
+		<< setw(10) << fixed << setprecision(2) << static_cast<double>(bytes) / (1024 * 1024) << " MiB read"
+		<< setw(10) << setprecision(3) << seconds.count() << " s"
+		<< setw(12) << setprecision(3) << seconds.count() * 1000 / static_cast<double>(_repetitions) << " ms/run" << endl;
+}
+
+/// Measures all import paths over @a _inputs.
+void measureAll(string const& _title, vector<Input> const& _inputs, size_t _repetitions)
+{
+	cout << _title << ": " << _inputs.size() << " sources" << endl;
+	langutil::EVMVersion evmVersion;
+
+	measure("  parse", _inputs, _repetitions, [&](Input const& _input) {
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		Parser parser{errorReporter, evmVersion, false};
+		parser.parse(make_shared<Scanner>(CharStream(_input.source, _input.name)));
+		return _input.source.size();
+	});
+	measure("  JSON import", _inputs, _repetitions, [&](Input const& _input) {
+		Json::Value ast;
+		util::jsonParseStrict(_input.json, ast);
+		ASTJsonImporter(evmVersion).jsonToSourceUnit({{_input.name, move(ast)}});
+		return _input.json.size();
+	});
+	measure("  snapshot import", _inputs, _repetitions, [&](Input const& _input) {
+		ASTSnapshotReader(evmVersion).read(_input.snapshot);
+		return _input.snapshot.size();
+	});
+}
+
+/// Compares reading a snapshot file into a string with mapping it into memory.
+void measureFileRead(Input const& _input, size_t _repetitions)
+{
+	fs::path path = fs::temp_directory_path() / fs::unique_path("astsnapshotbench-%%%%%%%%.snapshot");
+	ofstream(path.string(), ios::binary) << _input.snapshot;
+	langutil::EVMVersion evmVersion;
+
+	cout << "snapshot file: " << _input.snapshot.size() << " bytes" << endl;
+	vector<Input> inputs{_input};
+	measure("  read file and import", inputs, _repetitions, [&](Input const&) {
+		string snapshot = util::readFileAsString(path.string());
+		ASTSnapshotReader(evmVersion).read(snapshot);
+		return snapshot.size();
+	});
+	measure("  map file and import", inputs, _repetitions, [&](Input const&) {
+		util::MappedFile snapshot(path.string());
+		ASTSnapshotReader(evmVersion).read(snapshot.data());
+		return snapshot.data().size();
+	});
+	fs::remove(path);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	fs::path corpus = "test/syntax";
+	size_t repetitions = 10;
+	size_t syntheticSize = 4 * 1024 * 1024;
+	for (int i = 1; i < argc; ++i)
+	{
+		string argument = argv[i];
+		if (argument == "--help")
+		{
+			cout << "Usage: astsnapshotbench [--repeat <n>] [--synthetic <bytes>] [corpus directory]" << endl;
+			cout << "Measures the import of AST snapshots against the JSON AST import and against parsing" << endl;
+			cout << "the sources again, over the .sol and .solpp files of the corpus directory (default:" << endl;
+			cout << "test/syntax) that compile on their own, and over a synthetic source of the given size." << endl;
+			return 0;
+		}
+		else if ((argument == "--repeat" || argument == "--synthetic") && i + 1 < argc)
+			try
+			{
+				(argument == "--repeat" ? repetitions : syntheticSize) = stoul(argv[++i]);
+			}
+			catch (logic_error const&)
+			{
+				cerr << "Invalid number: " << argv[i] << endl;
+				return 1;
+			}
+		else
+			corpus = argument;
+	}
+
+	vector<Input> corpusInputs;
+	size_t skipped = 0;
+	if (fs::is_directory(corpus))
+		for (auto const& entry: fs::recursive_directory_iterator(corpus))
+			if (fs::is_regular_file(entry.path()) && (entry.path().extension() == ".sol" || entry.path().extension() == ".solpp"))
+			{
+				if (optional<Input> input = prepare(entry.path().string(), util::readFileAsString(entry.path().string())))
+					corpusInputs.emplace_back(move(*input));
+				else
+					++skipped;
+			}
+	if (corpusInputs.empty())
+	{
+		cerr << "No .sol or .solpp files that compile on their own found in " << corpus.string() << endl;
+		return 1;
+	}
+
+	optional<Input> synthetic = prepare("synthetic.solpp", syntheticSource(syntheticSize));
+	if (!synthetic)
+	{
+		cerr << "The synthetic source does not compile." << endl;
+		return 1;
+	}
+
+	measureAll("corpus (" + to_string(skipped) + " sources skipped)", corpusInputs, repetitions);
+	measureAll("synthetic", {*synthetic}, repetitions);
+	measureFileRead(*synthetic, repetitions);
+	return 0;
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Scanning throughput over the syntax test corpus and large synthetic sources.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// @returns a source of about @a _size bytes that, like typical contracts, is mostly NatSpec
+/// comments and indentation, with identifiers, keywords, sized types and Vite literals in between.
+string syntheticSource(size_t _size)
+{
+	string source = "pragma soliditypp >=0.8.0;\n\ncontract Synthetic {\n";
+	for (size_t i = 0; source.size() < _size; ++i)
+	{
+		string index = to_string(i);
+		source +=
+			"    /**\n"
+			"     * @notice Transfers the balance of account " + index + " to the given recipient.\n"
+			"     * @dev The recipient has to accept the token, otherwise the call is reverted.\n"
+			"     * @param recipient The address that receives the transferred balance.\n"
+			"     */\n"
+			"    function transferBalance" + index + "(address recipient, uint256 amount) external payable {\n"
+			"        // Only whole vite are transferred, the rest stays in the contract.\n"
+			"        uint256 wholeAmount = amount / 1 vite * 1 vite;\n"
+			"        bytes32 memo = \"transfer\";\n"
+			"        if (wholeAmount > 0 && recipient != address(0))\n"
+			"            payable(recipient).transfer(\"tti_5649544520544f4b454e6e40\", wholeAmount);\n"
+			"    }\n\n";
+	}
+	return source + "}\n";
+}
+
+/// Scans @a _sources @a _repetitions times and prints the throughput under @a _label.
+void measure(string const& _label, vector<string> const& _sources, size_t _repetitions)
+{
+	size_t bytes = 0;
+	for (string const& source: _sources)
+		bytes += source.size();
+
+	size_t tokens = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+		for (string const& source: _sources)
+		{
+			Scanner scanner(CharStream(source, ""));
+			while (scanner.currentToken() != Token::EOS)
+			{
+				scanner.next();
+				++tokens;
+			}
+		}
+	chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+
+	double megabytes = static_cast<double>(bytes * _repetitions) / (1024 * 1024);
+	cout << left << setw(12) << _label << right
+		<< setw(10) << _sources.size() << " sources"
+		<< setw(10) << fixed << setprecision(2) << megabytes << " MiB"
+		<< setw(12) << tokens << " tokens"
+		<< setw(10) << setprecision(3) << seconds.count() << " s"
+		<< setw(10) << setprecision(1) << megabytes / seconds.count() << " MiB/s" << endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	fs::path corpus = "test/syntax";
+	size_t repetitions = 10;
+	size_t syntheticSize = 16 * 1024 * 1024;
+	for (int i = 1; i < argc; ++i)
+	{
+		string argument = argv[i];
+		if (argument == "--help")
+		{
+			cout << "Usage: scannerbench [--repeat <n>] [--synthetic <bytes>] [corpus directory]" << endl;
+			cout << "Measures the scanning throughput over the .sol and .solpp files of the corpus directory" << endl;
+			cout << "(default: test/syntax) and over a synthetic source of the given size." << endl;
+			return 0;
+		}
+		else if ((argument == "--repeat" || argument == "--synthetic") && i + 1 < argc)
+			try
+			{
+				(argument == "--repeat" ? repetitions : syntheticSize) = stoul(argv[++i]);
+			}
+			catch (logic_error const&)
+			{
+				cerr << "Invalid number: " << argv[i] << endl;
+				return 1;
+			}
+		else
+			corpus = argument;
+	}
+
+	vector<string> corpusSources;
+	if (fs::is_directory(corpus))
+		for (auto const& entry: fs::recursive_directory_iterator(corpus))
+			if (fs::is_regular_file(entry.path()) && (entry.path().extension() == ".sol" || entry.path().extension() == ".solpp"))
+				corpusSources.emplace_back(util::readFileAsString(entry.path().string()));
+	if (corpusSources.empty())
+	{
+		cerr << "No .sol or .solpp files found in " << corpus.string() << endl;
+		return 1;
+	}
+
+	measure("corpus", corpusSources, repetitions);
+	measure("synthetic", {syntheticSource(syntheticSize)}, repetitions);
+	return 0;
+}
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary AST snapshot of --ast-snapshot and --import-ast.
+ */
+
+#include <libsolidity/ast/ASTSnapshot.h>
+#include <libsolidity/ast/SolidityppASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <test/Common.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+using namespace solidity::util;
+namespace fs = boost::filesystem;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// AST JSON of all sources and the bytecode of all contracts of a compilation.
+struct Outputs
+{
+	Json::Value asts{Json::objectValue};
+	map<string, string> bytecode;
+};
+
+Outputs collectOutputs(CompilerStack const& _compiler)
+{
+	Outputs outputs;
+	for (string const& name: _compiler.sourceNames())
+		outputs.asts[name] = SolidityppASTJsonConverter(_compiler.state(), _compiler.sourceIndices()).toJson(_compiler.ast(name));
+	if (_compiler.compilationSuccessful())
+		for (string const& contract: _compiler.contractNames())
+			outputs.bytecode[contract] = _compiler.object(contract).toHex();
+	return outputs;
+}
+
+/// Compiles @a _source, imports its snapshot into a new compiler stack and checks that both
+/// stacks produce the same AST JSON and bytecode.
+/// @returns false if the source was skipped because it does not parse.
+bool checkRoundTrip(string const& _name, string const& _source)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	string snapshot;
+	Outputs expected;
+	{
+		CompilerStack compiler;
+		compiler.setEVMVersion(evmVersion);
+		compiler.setSources({{_name, _source}});
+		try
+		{
+			if (!compiler.parse())
+				return false;
+			snapshot = compiler.astSnapshot();
+			if (compiler.analyze())
+				compiler.compile();
+		}
+		catch (Exception const&)
+		{
+			// Tests of internal and unimplemented errors are not compared.
+			return false;
+		}
+		expected = collectOutputs(compiler);
+	}
+
+	CompilerStack compiler;
+	compiler.setEVMVersion(evmVersion);
+	compiler.importASTSnapshot(snapshot);
+	if (compiler.analyze())
+		compiler.compile();
+	Outputs imported = collectOutputs(compiler);
+
+	BOOST_CHECK_MESSAGE(
+		imported.asts == expected.asts,
+		_name + ": AST after import differs:\n" + jsonPrettyPrint(imported.asts) + "\n!=\n" + jsonPrettyPrint(expected.asts)
+	);
+	BOOST_CHECK_MESSAGE(imported.bytecode == expected.bytecode, _name + ": bytecode after import differs.");
+	return true;
+}
+
+/// Runs checkRoundTrip() on the single source tests below @a _directory.
+void checkCorpus(fs::path const& _directory)
+{
+	size_t checked = 0;
+	for (auto const& entry: fs::recursive_directory_iterator(_directory))
+	{
+		string extension = entry.path().extension().string();
+		if (!fs::is_regular_file(entry.path()) || (extension != ".sol" && extension != ".solpp"))
+			continue;
+		string source = readFileAsString(entry.path().string());
+		// Tests with several sources are covered by their single sources.
+		if (source.find("==== Source:") != string::npos || source.find("==== ExternalSource:") != string::npos)
+			continue;
+		if (checkRoundTrip(entry.path().filename().string(), source))
+			++checked;
+	}
+	BOOST_CHECK(checked > 0);
+}
+
+string const c_source = R"(
+	pragma soliditypp >=0.8.0;
+	contract C {
+		uint256 public x;
+		function f(uint256 a) external returns (uint256 r) {
+			assembly { r := add(a, 1) }
+			x = r;
+			assembly { sstore(0, r) }
+		}
+	}
+)";
+
+string validSnapshot()
+{
+	CompilerStack compiler;
+	compiler.setSources({{"c.solpp", c_source}});
+	BOOST_REQUIRE(compiler.parse());
+	return compiler.astSnapshot();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTSnapshotTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(round_trip_inline_assembly)
+{
+	BOOST_CHECK(checkRoundTrip("c.solpp", c_source));
+}
+
+BOOST_AUTO_TEST_CASE(round_trip_syntax_corpus)
+{
+	checkCorpus(solidity::test::CommonOptions::get().testPath / "syntax");
+}
+
+BOOST_AUTO_TEST_CASE(round_trip_semantic_corpus)
+{
+	checkCorpus(solidity::test::CommonOptions::get().testPath / "semantic");
+}
+
+BOOST_AUTO_TEST_CASE(bad_magic)
+{
+	string snapshot = validSnapshot();
+	snapshot[0] = 'X';
+	BOOST_CHECK(!ASTSnapshotReader::isSnapshot(snapshot));
+	BOOST_CHECK_THROW(ASTSnapshotReader(EVMVersion{}).read(snapshot), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_CASE(bad_format_version)
+{
+	string snapshot = validSnapshot();
+	// The format version follows the eight magic bytes.
+	snapshot[8] = 0x7f;
+	BOOST_CHECK_THROW(ASTSnapshotReader(EVMVersion{}).read(snapshot), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_CASE(bad_compiler_version)
+{
+	string snapshot = validSnapshot();
+	// The compiler version follows the format version and its length.
+	snapshot[10] = snapshot[10] == '0' ? '1' : '0';
+	try
+	{
+		ASTSnapshotReader(EVMVersion{}).read(snapshot);
+		BOOST_ERROR("Snapshot of another compiler version was accepted.");
+	}
+	catch (InvalidAstError const& _error)
+	{
+		BOOST_CHECK(string(_error.what()).find("compiler version") != string::npos);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(truncated_snapshot)
+{
+	string snapshot = validSnapshot();
+	BOOST_CHECK_NO_THROW(ASTSnapshotReader(EVMVersion{}).read(snapshot));
+	for (size_t length = 8; length < snapshot.size(); ++length)
+		BOOST_CHECK_THROW(ASTSnapshotReader(EVMVersion{}).read(string_view(snapshot).substr(0, length)), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_CASE(trailing_data)
+{
+	string snapshot = validSnapshot() + '\0';
+	BOOST_CHECK_THROW(ASTSnapshotReader(EVMVersion{}).read(snapshot), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
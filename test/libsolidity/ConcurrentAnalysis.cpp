@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the analysis passes that run over the sources concurrently.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// @returns a source with @a _unknownPragmas syntax errors.
+string source(size_t _unknownPragmas)
+{
+	string source = "// SPDX-License-Identifier: GPL-3.0\npragma soliditypp >=0.8.0;\n";
+	for (size_t i = 0; i < _unknownPragmas; ++i)
+		source += "pragma unknown" + to_string(i) + ";\n";
+	return source + "contract C {}\n";
+}
+
+/// Analyses three sources with @a _threads threads, where b.sol has more syntax errors than
+/// are reported and its syntax check fails with a fatal error.
+/// @returns the errors as "<source>: <description>" in the order they were reported.
+vector<string> analyse(size_t _threads)
+{
+	CompilerStack compiler;
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setThreads(_threads);
+	compiler.setSources({{"a.sol", source(1)}, {"b.sol", source(300)}, {"c.sol", source(1)}});
+	BOOST_CHECK(!compiler.parseAndAnalyze());
+
+	vector<string> errors;
+	for (shared_ptr<Error const> const& error: compiler.errors())
+	{
+		// The warning about pre-release builds.
+		if (error->errorId().error == 3805)
+			continue;
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+		errors.emplace_back(
+			(location && location->source ? location->source->name() : "") + ": " + error->what()
+		);
+	}
+	return errors;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ConcurrentAnalysis, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(fatal_error_in_middle_source)
+{
+	vector<string> errors = analyse(1);
+
+	// 256 errors are reported over all sources, followed by the note that the analysis was aborted.
+	BOOST_REQUIRE_EQUAL(errors.size(), 257);
+	BOOST_CHECK_EQUAL(errors.front(), "a.sol: Unknown pragma \"unknown0\"");
+	for (size_t i = 1; i < 256; ++i)
+		BOOST_CHECK_EQUAL(errors[i], "b.sol: Unknown pragma \"unknown" + to_string(i - 1) + "\"");
+	BOOST_CHECK_EQUAL(errors.back(), ": There are more than 256 errors. Aborting.");
+
+	// The errors do not depend on the number of threads or their scheduling.
+	for (size_t threads: {2, 3, 8})
+		for (size_t run = 0; run < 5; ++run)
+			BOOST_CHECK(analyse(threads) == errors);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
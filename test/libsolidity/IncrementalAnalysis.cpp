@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the incremental re-analysis of changed sources.
+ */
+
+#include <libsolidity/interface/IncrementalAnalysis.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string source(string const& _body)
+{
+	return "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n" + _body;
+}
+
+IncrementalAnalysis project()
+{
+	IncrementalAnalysis analysis({}, [](CompilerStack& _compiler) {
+		_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	});
+	analysis.setSource("a.sol", source("contract A { function f() public pure returns (uint) { return 1; } }"));
+	analysis.setSource("b.sol", source("import \"a.sol\"; contract B is A {}"));
+	analysis.setSource("c.sol", source("import \"b.sol\"; contract C is B {}"));
+	analysis.setSource("d.sol", source("contract D {}"));
+	return analysis;
+}
+
+/// Adds a project of @a _libraries base contracts and @a _contracts contracts, each of which
+/// imports one of the base contracts, to @a _analysis.
+void generatedProject(IncrementalAnalysis& _analysis, size_t _libraries, size_t _contracts)
+{
+	for (size_t i = 0; i < _libraries; ++i)
+		_analysis.setSource(
+			"lib" + to_string(i) + ".sol",
+			source("contract L" + to_string(i) + " { function f() public pure virtual returns (uint) { return " + to_string(i) + "; } }")
+		);
+	for (size_t i = 0; i < _contracts; ++i)
+		_analysis.setSource(
+			"c" + to_string(i) + ".sol",
+			source(
+				"import \"lib" + to_string(i % _libraries) + ".sol\"; contract C" + to_string(i) +
+				" is L" + to_string(i % _libraries) + " { function g() public pure returns (uint) { return f() + 1; } }"
+			)
+		);
+}
+
+/// Runs analyze() on @a _analysis and reports its latency under @a _label.
+set<string> timedAnalysis(IncrementalAnalysis& _analysis, string const& _label)
+{
+	auto start = chrono::steady_clock::now();
+	set<string> analysed = _analysis.analyze();
+	chrono::duration<double, milli> latency = chrono::steady_clock::now() - start;
+	BOOST_TEST_MESSAGE(_label << ": " << analysed.size() << " sources analysed in " << latency.count() << " ms");
+	return analysed;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalAnalysisTest)
+
+BOOST_AUTO_TEST_CASE(only_changed_sources_and_dependents)
+{
+	IncrementalAnalysis analysis = project();
+	BOOST_CHECK(analysis.analyze() == (set<string>{"a.sol", "b.sol", "c.sol", "d.sol"}));
+	BOOST_CHECK(analysis.analyze().empty());
+	BOOST_CHECK(analysis.dependents("a.sol") == (set<string>{"b.sol", "c.sol"}));
+
+	analysis.setSource("d.sol", source("contract D { uint x; }"));
+	BOOST_CHECK(analysis.analyze() == set<string>{"d.sol"});
+
+	// The imports of the dependents are analysed as well.
+	analysis.setSource("b.sol", source("import \"a.sol\"; contract B is A { uint y; }"));
+	BOOST_CHECK(analysis.analyze() == (set<string>{"a.sol", "b.sol", "c.sol"}));
+
+	// Setting the same content again does not invalidate anything.
+	analysis.setSource("b.sol", source("import \"a.sol\"; contract B is A { uint y; }"));
+	BOOST_CHECK(analysis.analyze().empty());
+}
+
+BOOST_AUTO_TEST_CASE(generated_project)
+{
+	// 20 base contracts, each imported by 9 of the 180 other sources.
+	IncrementalAnalysis analysis = project();
+	generatedProject(analysis, 20, 180);
+	BOOST_CHECK_EQUAL(timedAnalysis(analysis, "full analysis").size(), 204);
+
+	// Only the edited source and the base contract it imports are parsed and analysed again.
+	analysis.setSource("c7.sol", source("import \"lib7.sol\"; contract C7 is L7 { uint x; }"));
+	BOOST_CHECK(timedAnalysis(analysis, "edit of a contract") == (set<string>{"c7.sol", "lib7.sol"}));
+	BOOST_CHECK(Error::containsOnlyWarnings(analysis.errors("c7.sol")));
+
+	// An edit of a base contract reaches its 9 dependents.
+	analysis.setSource("lib3.sol", source("contract L3 { function f() public pure virtual returns (bool) { return true; } }"));
+	set<string> analysed = timedAnalysis(analysis, "edit of a base contract");
+	BOOST_CHECK_EQUAL(analysed.size(), 10);
+	BOOST_CHECK(analysed == (set<string>{"lib3.sol"} + analysis.dependents("lib3.sol")));
+	BOOST_CHECK(!Error::containsOnlyWarnings(analysis.errors("c23.sol")));
+	BOOST_CHECK(Error::containsOnlyWarnings(analysis.errors("c24.sol")));
+}
+
+BOOST_AUTO_TEST_CASE(errors_follow_edits)
+{
+	IncrementalAnalysis analysis = project();
+	analysis.analyze();
+	BOOST_CHECK(Error::containsOnlyWarnings(analysis.errors("c.sol")));
+
+	analysis.setSource("c.sol", source("import \"b.sol\"; contract C is B { function g() public pure returns (uint) { return f(); } }"));
+	analysis.analyze();
+	BOOST_CHECK(Error::containsOnlyWarnings(analysis.errors("c.sol")));
+
+	// Changing the return type in a.sol breaks c.sol, which is analysed again.
+	analysis.setSource("a.sol", source("contract A { function f() public pure returns (bool) { return true; } }"));
+	BOOST_CHECK(analysis.analyze().count("c.sol"));
+	BOOST_CHECK(!Error::containsOnlyWarnings(analysis.errors("c.sol")));
+	BOOST_CHECK(Error::containsOnlyWarnings(analysis.errors("d.sol")));
+}
+
+BOOST_AUTO_TEST_CASE(missing_import_added_later)
+{
+	IncrementalAnalysis analysis;
+	analysis.setSource("e.sol", source("import \"f.sol\"; contract E is F {}"));
+	analysis.analyze();
+	BOOST_CHECK(!Error::containsOnlyWarnings(analysis.errors("e.sol")));
+
+	analysis.setSource("f.sol", source("contract F {}"));
+	BOOST_CHECK(analysis.analyze() == (set<string>{"e.sol", "f.sol"}));
+	BOOST_CHECK(Error::containsOnlyWarnings(analysis.errors("e.sol")));
+
+	analysis.removeSource("f.sol");
+	BOOST_CHECK(analysis.analyze() == set<string>{"e.sol"});
+	BOOST_CHECK(!Error::containsOnlyWarnings(analysis.errors("e.sol")));
+}
+
+BOOST_AUTO_TEST_CASE(adopted_compiler_and_code_generation)
+{
+	// This is how solppc --watch continues from its first compilation.
+	auto compiler = make_shared<CompilerStack>();
+	compiler->setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler->setSources({
+		{"a.sol", source("contract A { function f() public pure returns (uint) { return 1; } }")},
+		{"b.sol", source("import \"a.sol\"; contract B is A {}")},
+		{"d.sol", source("contract D {}")}
+	});
+	BOOST_REQUIRE(compiler->compile());
+
+	IncrementalAnalysis analysis = project();
+	analysis.adopt(compiler);
+	compiler.reset();
+	BOOST_CHECK(analysis.dependents("a.sol") == set<string>{"b.sol"});
+	// c.sol is not part of the adopted stack, so it is still out of date.
+	BOOST_CHECK(analysis.analyze(CompilerStack::State::CompilationSuccessful) == (set<string>{"a.sol", "b.sol", "c.sol"}));
+	BOOST_CHECK(analysis.compiler()->compilationSuccessful());
+	BOOST_CHECK(!analysis.compiler()->object("c.sol:C").bytecode.empty());
+
+	analysis.setSource("d.sol", source("contract D { uint x; }"));
+	BOOST_CHECK(analysis.analyze(CompilerStack::State::CompilationSuccessful) == set<string>{"d.sol"});
+	BOOST_CHECK(!analysis.compiler()->object("d.sol:D").bytecode.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the Solidity++ additions to the libsolc interface.
+ */
+
+#include <libsolc/libsolc.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string const c_library = "pragma soliditypp >=0.8.0;\nlibrary Lib { function one() internal pure returns (uint256) { return 1; } }";
+
+/// @returns a standard JSON input compiling @a _source as @a _name.
+string input(string const& _name, string const& _source)
+{
+	Json::Value input;
+	input["language"] = "Solidity";
+	input["sources"][_name]["content"] = _source;
+	input["settings"]["outputSelection"]["*"]["*"].append("evm.bytecode.object");
+	return jsonCompactPrint(input);
+}
+
+struct CollectedOutput
+{
+	string output;
+	size_t chunks = 0;
+};
+
+/// Collects the output chunks in the CollectedOutput @a _context.
+void collectOutput(void* _context, char const* _data, size_t _length)
+{
+	auto& collected = *static_cast<CollectedOutput*>(_context);
+	collected.output.append(_data, _length);
+	++collected.chunks;
+}
+
+/// Provides lib.solpp and counts the calls in the size_t @a _context.
+void readLibrary(void* _context, char const*, char const* _path, char** o_contents, char** o_error)
+{
+	++*static_cast<size_t*>(_context);
+	string const response = string(_path) == "lib.solpp" ? c_library : "not found";
+	char* copy = solidity_alloc(response.size() + 1);
+	memcpy(copy, response.c_str(), response.size() + 1);
+	*(string(_path) == "lib.solpp" ? o_contents : o_error) = copy;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(LibSolc, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(compile_batch)
+{
+	string const user = input("user.solpp", "pragma soliditypp >=0.8.0;\nimport \"lib.solpp\";\ncontract User { function f() external pure returns (uint256) { return Lib.one(); } }");
+	string const invalid = input("e.solpp", "pragma soliditypp >=0.8.0;\ncontract E { function f() public { undeclared = 1; } }");
+	vector<char const*> inputs{user.c_str(), invalid.c_str(), user.c_str()};
+
+	size_t reads = 0;
+	CollectedOutput collected;
+	solidity_compile_batch(inputs.data(), inputs.size(), readLibrary, &reads, collectOutput, &collected);
+	solidity_reset();
+
+	// The output is streamed, not passed on at once.
+	BOOST_CHECK_GT(collected.chunks, inputs.size());
+	BOOST_CHECK_EQUAL(reads, 1);
+	Json::Value outputs;
+	BOOST_REQUIRE_MESSAGE(jsonParseStrict(collected.output, outputs), collected.output);
+	BOOST_REQUIRE(outputs.isArray());
+	BOOST_REQUIRE_EQUAL(outputs.size(), 3);
+	BOOST_CHECK(outputs[0]["contracts"]["user.solpp"].isMember("User"));
+	BOOST_CHECK(!outputs[1].isMember("contracts"));
+	BOOST_CHECK_EQUAL(outputs[1]["errors"][0]["severity"].asString(), "error");
+	BOOST_CHECK(outputs[2] == outputs[0]);
+}
+
+BOOST_AUTO_TEST_CASE(compile_batch_without_read_callback)
+{
+	string const registry = input("b.solpp", "pragma soliditypp >=0.8.0;\ncontract Registry { uint256 public value; }");
+	char const* inputs[] = {registry.c_str()};
+	CollectedOutput collected;
+	solidity_compile_batch(inputs, 1, nullptr, nullptr, collectOutput, &collected);
+	solidity_reset();
+
+	Json::Value outputs;
+	BOOST_REQUIRE_MESSAGE(jsonParseStrict(collected.output, outputs), collected.output);
+	BOOST_REQUIRE_EQUAL(outputs.size(), 1);
+	BOOST_CHECK(outputs[0]["contracts"]["b.solpp"].isMember("Registry"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the Solidity++ additions to the standard JSON interface.
+ */
+
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// @returns a standard JSON input with the given sources and all contracts selected.
+Json::Value input(map<string, string> const& _sources)
+{
+	Json::Value input;
+	input["language"] = "Solidity";
+	for (auto const& [name, content]: _sources)
+		input["sources"][name]["content"] = content;
+	Json::Value selection(Json::arrayValue);
+	selection.append("abi");
+	selection.append("evm.bytecode.object");
+	selection.append("evm.methodIdentifiers");
+	input["settings"]["outputSelection"]["*"]["*"] = selection;
+	input["settings"]["outputSelection"]["*"][""].append("ast");
+	return input;
+}
+
+/// @returns the chunks of the streamed output of @a _input.
+vector<string> compileChunked(Json::Value const& _input)
+{
+	vector<string> chunks;
+	StandardCompiler().compile(jsonCompactPrint(_input), [&](string const& _chunk) { chunks.push_back(_chunk); });
+	return chunks;
+}
+
+/// Checks that the streamed output of @a _input parses and equals the output of the non-streaming interface.
+/// @returns the number of chunks.
+size_t checkChunkedMatches(Json::Value const& _input)
+{
+	vector<string> chunks = compileChunked(_input);
+	string chunked;
+	for (string const& chunk: chunks)
+		chunked += chunk;
+
+	Json::Value streamed;
+	string errors;
+	BOOST_REQUIRE_MESSAGE(jsonParseStrict(chunked, streamed, &errors), errors + "\n" + chunked);
+	Json::Value expected = StandardCompiler().compile(_input);
+	BOOST_CHECK_MESSAGE(streamed == expected, jsonPrettyPrint(streamed) + "\n!=\n" + jsonPrettyPrint(expected));
+	return chunks.size();
+}
+
+string const c_tokens = R"(
+	pragma soliditypp >=0.8.0;
+	contract Token { uint256 public supply; function mint(uint256 _amount) external { supply += _amount; } }
+	contract Vault { function deposit() external payable {} }
+)";
+
+string const c_registry = R"(
+	pragma soliditypp >=0.8.0;
+	contract Registry { mapping(address => uint256) public entries; function set(uint256 _value) external { entries[msg.sender] = _value; } }
+)";
+
+string const c_importsLibrary = R"(
+	pragma soliditypp >=0.8.0;
+	import "lib.solpp";
+	contract User { function f() external pure returns (uint256) { return Lib.one(); } }
+)";
+
+/// @returns the output of compileBatch() for @a _inputs, parsed.
+Json::Value compileBatch(StandardCompiler& _compiler, vector<string> const& _inputs)
+{
+	size_t nextInput = 0;
+	string output;
+	_compiler.compileBatch(
+		[&]() -> optional<string>
+		{
+			if (nextInput == _inputs.size())
+				return nullopt;
+			return _inputs[nextInput++];
+		},
+		[&](string const& _chunk) { output += _chunk; }
+	);
+	Json::Value parsed;
+	string errors;
+	BOOST_REQUIRE_MESSAGE(jsonParseStrict(output, parsed, &errors), errors + "\n" + output);
+	return parsed;
+}
+
+/// @returns a read callback that provides lib.solpp and counts its calls in @a _reads.
+ReadCallback::Callback libraryReader(size_t& _reads)
+{
+	return [&_reads](string const&, string const& _path)
+	{
+		++_reads;
+		if (_path == "lib.solpp")
+			return ReadCallback::Result{true, "pragma soliditypp >=0.8.0;\nlibrary Lib { function one() internal pure returns (uint256) { return 1; } }"};
+		return ReadCallback::Result{false, "not found"};
+	};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolidityppStandardCompiler, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(chunked_output_multiple_contracts)
+{
+	Json::Value in = input({{"a.solpp", c_tokens}, {"b.solpp", c_registry}});
+	// One chunk per contract and one for the rest of the output.
+	BOOST_CHECK_EQUAL(checkChunkedMatches(in), 4);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_output_with_warnings)
+{
+	// Contracts and error entries are both present.
+	Json::Value in = input({
+		{"a.solpp", c_tokens},
+		{"w.solpp", "pragma soliditypp >=0.8.0;\ncontract W { function f(uint256 x) public pure returns (uint256) { uint256 unused; return x; } }"}
+	});
+	checkChunkedMatches(in);
+	Json::Value output = StandardCompiler().compile(in);
+	BOOST_CHECK(output.isMember("contracts"));
+	BOOST_REQUIRE(output.isMember("errors"));
+	BOOST_CHECK_EQUAL(output["errors"][0]["severity"].asString(), "warning");
+}
+
+BOOST_AUTO_TEST_CASE(chunked_output_with_errors)
+{
+	Json::Value in = input({
+		{"a.solpp", c_tokens},
+		{"e.solpp", "pragma soliditypp >=0.8.0;\ncontract E { function f() public { undeclared = 1; } }"}
+	});
+	// Analysis fails, so only the envelope is written.
+	BOOST_CHECK_EQUAL(checkChunkedMatches(in), 1);
+	Json::Value output = StandardCompiler().compile(in);
+	BOOST_CHECK(!output.isMember("contracts"));
+	BOOST_CHECK(output.isMember("errors"));
+}
+
+BOOST_AUTO_TEST_CASE(chunked_output_invalid_json)
+{
+	vector<string> chunks;
+	StandardCompiler().compile(string("{ invalid"), [&](string const& _chunk) { chunks.push_back(_chunk); });
+	BOOST_REQUIRE_EQUAL(chunks.size(), 1);
+	Json::Value output;
+	BOOST_REQUIRE(jsonParseStrict(chunks[0], output));
+	BOOST_CHECK_EQUAL(output["errors"][0]["type"].asString(), "JSONError");
+}
+
+BOOST_AUTO_TEST_CASE(batch_outputs_in_input_order)
+{
+	vector<string> inputs{
+		jsonCompactPrint(input({{"a.solpp", c_tokens}})),
+		"{ invalid",
+		jsonCompactPrint(input({{"b.solpp", c_registry}}))
+	};
+	StandardCompiler compiler;
+	Json::Value outputs = compileBatch(compiler, inputs);
+	BOOST_REQUIRE(outputs.isArray());
+	BOOST_REQUIRE_EQUAL(outputs.size(), inputs.size());
+	// The state of one input does not leak into the next one.
+	for (Json::ArrayIndex i = 0; i < outputs.size(); ++i)
+	{
+		Json::Value expected;
+		BOOST_REQUIRE(jsonParseStrict(StandardCompiler().compile(inputs[i]), expected));
+		BOOST_CHECK_MESSAGE(outputs[i] == expected, jsonPrettyPrint(outputs[i]) + "\n!=\n" + jsonPrettyPrint(expected));
+	}
+	BOOST_CHECK(outputs[0]["contracts"]["a.solpp"].isMember("Token"));
+	BOOST_CHECK_EQUAL(outputs[1]["errors"][0]["type"].asString(), "JSONError");
+	BOOST_CHECK(outputs[2]["contracts"]["b.solpp"].isMember("Registry"));
+}
+
+BOOST_AUTO_TEST_CASE(batch_empty)
+{
+	StandardCompiler compiler;
+	Json::Value outputs = compileBatch(compiler, {});
+	BOOST_CHECK(outputs.isArray());
+	BOOST_CHECK_EQUAL(outputs.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(batch_unreadable_input)
+{
+	size_t calls = 0;
+	string output;
+	StandardCompiler().compileBatch(
+		[&]() -> optional<string>
+		{
+			if (++calls == 1)
+				throw runtime_error("unreadable");
+			if (calls == 2)
+				return jsonCompactPrint(input({{"b.solpp", c_registry}}));
+			return nullopt;
+		},
+		[&](string const& _chunk) { output += _chunk; }
+	);
+	Json::Value outputs;
+	BOOST_REQUIRE(jsonParseStrict(output, outputs));
+	BOOST_REQUIRE_EQUAL(outputs.size(), 2);
+	BOOST_CHECK_EQUAL(outputs[0]["errors"][0]["message"].asString(), "Error reading input.");
+	BOOST_CHECK(outputs[1]["contracts"]["b.solpp"].isMember("Registry"));
+}
+
+BOOST_AUTO_TEST_CASE(batch_read_cache)
+{
+	string const user = jsonCompactPrint(input({{"user.solpp", c_importsLibrary}}));
+
+	size_t reads = 0;
+	StandardCompiler compiler(libraryReader(reads));
+	Json::Value outputs = compileBatch(compiler, {user, user, user});
+	BOOST_REQUIRE_EQUAL(outputs.size(), 3);
+	for (Json::Value const& output: outputs)
+		BOOST_CHECK(output["contracts"]["user.solpp"].isMember("User"));
+	BOOST_CHECK_EQUAL(reads, 1);
+
+	// A file larger than the limit is read again for every input.
+	reads = 0;
+	StandardCompiler uncached(libraryReader(reads));
+	uncached.setReadCacheLimit(10);
+	compileBatch(uncached, {user, user});
+	BOOST_CHECK_EQUAL(reads, 2);
+}
+
+BOOST_AUTO_TEST_CASE(batch_max_in_flight)
+{
+	string const registry = jsonCompactPrint(input({{"b.solpp", c_registry}}));
+	for (size_t maxInFlight: vector<size_t>{1, 2, 4})
+	{
+		StandardCompiler compiler;
+		compiler.setMaxInFlight(maxInFlight);
+		mutex counters;
+		size_t requested = 0;
+		size_t completed = 0;
+		size_t maxHeld = 0;
+		compiler.compileBatch(
+			[&]() -> optional<string>
+			{
+				lock_guard<mutex> lock(counters);
+				if (requested == 8)
+					return nullopt;
+				++requested;
+				maxHeld = max(maxHeld, requested - completed);
+				return registry;
+			},
+			[&](string const& _chunk)
+			{
+				// The last chunk of an output with contracts closes the "contracts" member.
+				lock_guard<mutex> lock(counters);
+				if (_chunk.substr(0, 2) == "}}")
+					++completed;
+			}
+		);
+		BOOST_CHECK_EQUAL(completed, 8);
+		BOOST_CHECK_LE(maxHeld, maxInFlight);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Semantic tests executed on the in-process ViteVM, with quota expectations.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#include <test/libsolidity/ViteSemanticTest.h>
+#include <test/Common.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolutil/AnsiColorized.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/FunctionSelector.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <optional>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+using namespace solidity::frontend::test;
+
+ViteSemanticTest::ViteSemanticTest(string const& _filename):
+	EVMVersionRestrictedTestCase(_filename)
+{
+	m_source = m_reader.source();
+	parseExpectations(m_reader.simpleExpectations());
+}
+
+u256 ViteSemanticTest::parseWord(string const& _word)
+{
+	if (_word == "true")
+		return 1;
+	if (_word == "false")
+		return 0;
+	if (boost::starts_with(_word, "-"))
+		return s2u(-s256(u256(_word.substr(1))));
+	return u256(_word);
+}
+
+void ViteSemanticTest::parseExpectations(string const& _expectations)
+{
+	stringstream expectation;
+	istringstream lines(_expectations);
+	string line;
+	while (getline(lines, line))
+	{
+		boost::trim(line);
+		if (line.empty())
+			continue;
+
+		if (boost::starts_with(line, "quota:"))
+		{
+			if (m_calls.empty())
+				BOOST_THROW_EXCEPTION(runtime_error("Quota expectation without a preceding call."));
+			string quota = boost::trim_copy(line.substr(6));
+			if (quota.empty() || quota.find_first_not_of("0123456789") != string::npos)
+				BOOST_THROW_EXCEPTION(runtime_error("Invalid quota expectation: \"" + line + "\". Expected the exact quota."));
+			expectation << "quota: " << quota << endl;
+			continue;
+		}
+
+		size_t arrow = line.find("->");
+		if (arrow == string::npos)
+			BOOST_THROW_EXCEPTION(runtime_error("Invalid call expectation: \"" + line + "\"."));
+
+		Call call;
+		call.text = boost::trim_copy(line.substr(0, arrow));
+		string result = boost::trim_copy(line.substr(arrow + 2));
+
+		size_t colon = call.text.find("):");
+		call.signature = colon == string::npos ? call.text : call.text.substr(0, colon + 1);
+		if (colon != string::npos)
+		{
+			vector<string> arguments;
+			string argumentList = call.text.substr(colon + 2);
+			boost::split(arguments, argumentList, boost::is_any_of(","));
+			for (string& argument: arguments)
+				if (!boost::trim_copy(argument).empty())
+					call.arguments.push_back(parseWord(boost::trim_copy(argument)));
+		}
+
+		expectation << call.text << " ->" << (result.empty() ? "" : " " + result) << endl;
+		m_calls.emplace_back(move(call));
+	}
+	m_expectation = expectation.str();
+}
+
+TestCase::TestResult ViteSemanticTest::run(ostream& _stream, string const& _linePrefix, bool _formatted)
+{
+	CompilerStack compiler;
+	compiler.setSources({{"", m_source}});
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+	if (!compiler.compile())
+	{
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED})
+			<< _linePrefix << "Compilation failed:" << endl;
+		for (auto const& error: compiler.errors())
+			_stream << _linePrefix << "  " << error->what() << endl;
+		return TestResult::FatalError;
+	}
+
+	solidity::test::ViteVM vm;
+	optional<h168> contract = vm.deploy(compiler.object(compiler.lastContractName()).bytecode);
+	if (!contract)
+	{
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED})
+			<< _linePrefix << "Deployment failed." << endl;
+		return TestResult::FatalError;
+	}
+
+	stringstream obtained;
+	for (Call const& call: m_calls)
+	{
+		bytes data;
+		if (call.signature != "()")
+		{
+			bytes selector = toBigEndian(u256(selectorFromSignature32(call.signature)));
+			data = bytes(selector.end() - 4, selector.end());
+		}
+		for (u256 const& argument: call.arguments)
+			data += toBigEndian(argument);
+
+		size_t firstMessage = vm.history().size();
+		solidity::test::ViteExecutionResult result = vm.call(*contract, data);
+
+		// The result of a suspended call is the output of its last callback.
+		uint64_t quota = 0;
+		for (size_t i = firstMessage; i < vm.history().size(); ++i)
+		{
+			quota += vm.history()[i].second.quotaUsed;
+			if (result.suspended && vm.history()[i].first.to == *contract)
+				result = vm.history()[i].second;
+		}
+
+		obtained << call.text << " ->";
+		if (!result.success)
+			obtained << " FAILURE";
+		else
+		{
+			vector<string> words;
+			for (size_t offset = 0; offset < result.output.size(); offset += 32)
+			{
+				bytes word(result.output.begin() + static_cast<ptrdiff_t>(offset), result.output.begin() + static_cast<ptrdiff_t>(min(offset + 32, result.output.size())));
+				word.resize(32, 0);
+				words.push_back(formatNumber(fromBigEndian<u256>(word)));
+			}
+			if (!words.empty())
+				obtained << " " << boost::join(words, ", ");
+		}
+		obtained << endl;
+		obtained << "quota: " << quota << endl;
+	}
+	m_obtainedResult = obtained.str();
+
+	return checkResult(_stream, _linePrefix, _formatted);
+}
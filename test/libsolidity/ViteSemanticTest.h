@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @author Charles <charles@vite.org>
+ * @date 2021
+ * Semantic tests executed on the in-process ViteVM, with quota expectations.
+ *
+ * Solidity++ is modified from Solidity under the terms of the GNU General Public License.
+ */
+
+#pragma once
+
+#include <test/TestCase.h>
+#include <test/ViteVM.h>
+
+#include <string>
+#include <vector>
+
+namespace solidity::frontend::test
+{
+
+/**
+ * Compiles the last contract of the source, deploys it on a ViteVM and runs the calls
+ * listed in the expectations, one per line:
+ *
+ *   // f(uint256,bool): 1, true -> 2
+ *   // quota: 1234
+ *   // g() -> 3
+ *   // quota: 5000
+ *
+ * Arguments and results are 32-byte words (decimal, hex, true or false). A call that
+ * fails is expected as "-> FAILURE". Every call is followed by its exact quota, the total
+ * of all queued messages and callbacks it triggered. The measured quota is always part of
+ * the obtained result, so updating the expectations in isoltest records it.
+ */
+class ViteSemanticTest: public EVMVersionRestrictedTestCase
+{
+public:
+	static std::unique_ptr<TestCase> create(Config const& _config)
+	{
+		return std::make_unique<ViteSemanticTest>(_config.filename);
+	}
+
+	explicit ViteSemanticTest(std::string const& _filename);
+
+	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool _formatted = false) override;
+
+private:
+	struct Call
+	{
+		/// The call as written in the test file, without the result.
+		std::string text;
+		std::string signature;
+		std::vector<u256> arguments;
+	};
+
+	void parseExpectations(std::string const& _expectations);
+	static u256 parseWord(std::string const& _word);
+
+	std::vector<Call> m_calls;
+};
+
+}
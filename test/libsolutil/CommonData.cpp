@@ -6,6 +6,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ViteAddress.h>
 #include <libsolidity/ast/Types.h> // for IntegerType
 
 #include <test/Common.h>
@@ -174,6 +175,17 @@ BOOST_AUTO_TEST_CASE(test_vite_tokenid_hex)
 	BOOST_CHECK_EQUAL(getViteTokenIdHex("tti_5649544520544f4b454e6e40"), "0x5649544520544f4b454e");
 }
 
+BOOST_AUTO_TEST_CASE(test_vite_address_decode)
+{
+	BOOST_CHECK(decodeViteAddress("vite_8cf2663cc949442db2d3f78f372621733292d1fb0b846f1651") == h168("0x8cf2663cc949442db2d3f78f372621733292d1fb01"));
+	BOOST_CHECK(decodeViteAddress("VITE_8cf2663cc949442db2d3f78f372621733292d1fb0b846f1651") == nullopt);
+	BOOST_CHECK(decodeViteAddress("vite_8cf2663cc949442db2d3f78f372621733292d1fb0b846f165") == nullopt);
+	BOOST_CHECK(decodeViteAddress("vite_8cf2663cc949442db2d3f78f372621733292d1fx0b846f1651") == nullopt);
+	BOOST_CHECK(decodeViteTokenId("tti_5649544520544f4b454e6e40") == h80("0x5649544520544f4b454e"));
+	BOOST_CHECK(decodeViteTokenId("tti_5649544520544f4b454e6e4") == nullopt);
+	BOOST_CHECK_THROW(getViteTokenIdHex("tti_5649544520544f4b454e0000"), InvalidAddress);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
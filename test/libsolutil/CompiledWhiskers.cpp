@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the compiled Whiskers templates.
+ */
+#include <libsolutil/CompiledWhiskers.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// Renders @a _template with Whiskers and CompiledWhiskers and checks that the results agree.
+template <class Fill>
+string renderBoth(string const& _template, Fill const& _fill)
+{
+	Whiskers whiskers(_template);
+	CompiledWhiskers compiled(_template);
+	_fill(whiskers);
+	_fill(compiled);
+	string result = compiled.render();
+	BOOST_CHECK_EQUAL(whiskers.render(), result);
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompiledWhiskersTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(no_templates)
+{
+	string templ = "this is a test < with > brackets";
+	BOOST_CHECK_EQUAL(renderBoth(templ, [](auto&) {}), templ);
+}
+
+BOOST_AUTO_TEST_CASE(basic_replacement)
+{
+	string result = renderBoth("a <b> x <c> -> <b>.", [](auto& _w) { _w("b", "X")("c", "Y"); });
+	BOOST_CHECK_EQUAL(result, "a X x Y -> X.");
+}
+
+BOOST_AUTO_TEST_CASE(conditionals)
+{
+	string templ = "<?b>yes<!b>no</b> <?+c>set<!+c>empty</+c> <?b>only</b>";
+	BOOST_CHECK_EQUAL(renderBoth(templ, [](auto& _w) { _w("b", true)("c", "x"); }), "yes set only");
+	BOOST_CHECK_EQUAL(renderBoth(templ, [](auto& _w) { _w("b", false)("c", ""); }), "no empty ");
+}
+
+BOOST_AUTO_TEST_CASE(lists)
+{
+	string templ = "<#list><a>=<b><?+a>;</+a></list> <x>";
+	vector<map<string, string>> list{{{"a", "1"}, {"b", "2"}}, {{"a", ""}, {"b", "4"}}};
+	string result = renderBoth(templ, [&](auto& _w) { _w("list", list)("x", "end"); });
+	BOOST_CHECK_EQUAL(result, "1=2;=4 end");
+}
+
+BOOST_AUTO_TEST_CASE(unmatched_tags)
+{
+	string templ = "<#a> <?b> </c> <!d> <x>";
+	BOOST_CHECK_EQUAL(renderBoth(templ, [](auto& _w) { _w("x", "X"); }), "<#a> <?b> </c> <!d> X");
+}
+
+BOOST_AUTO_TEST_CASE(parameter_errors)
+{
+	CompiledWhiskers missing("<a>");
+	BOOST_CHECK_THROW(missing.render(), WhiskersError);
+	CompiledWhiskers unknown("<a>");
+	BOOST_CHECK_THROW(unknown("b", "x"), WhiskersError);
+	BOOST_CHECK_THROW(unknown("a", true), WhiskersError);
+	unknown("a", "x");
+	BOOST_CHECK_THROW(unknown("a", "y"), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(render_into_buffer)
+{
+	CompiledWhiskers templ("<a>;");
+	templ("a", "x");
+	string buffer = "begin:";
+	templ.render(buffer);
+	templ.render(buffer);
+	BOOST_CHECK_EQUAL(buffer, "begin:x;x;");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
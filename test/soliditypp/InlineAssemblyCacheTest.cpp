@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of inline assembly snippets of the code generator.
+ */
+
+#include <libsolidity/codegen/CompilerContext.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+using namespace std;
+using namespace solidity::evmasm;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string const c_snippet = "{ x := add(mul(x, 2), y) }";
+
+/// @returns a context that uses @a _cache and has the locals x and y on the stack,
+/// below @a _extraSlots other slots.
+unique_ptr<CompilerContext> makeContext(shared_ptr<InlineAssemblyCache> _cache, EVMVersion _evmVersion = EVMVersion{}, unsigned _extraSlots = 0)
+{
+	auto context = make_unique<CompilerContext>(_evmVersion, RevertStrings::Default);
+	context->setInlineAssemblyCache(move(_cache));
+	*context << u256(3) << u256(4);
+	for (unsigned i = 0; i < _extraSlots; ++i)
+		*context << u256(i);
+	return context;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(InlineAssemblyCacheTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(hit_on_identical_snippet)
+{
+	auto cache = make_shared<InlineAssemblyCache>();
+	auto first = makeContext(cache);
+	first->appendInlineAssembly(c_snippet, {"x", "y"});
+	BOOST_CHECK_EQUAL(cache->misses(), 1);
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+
+	auto second = makeContext(cache);
+	second->appendInlineAssembly(c_snippet, {"x", "y"});
+	BOOST_CHECK_EQUAL(cache->misses(), 1);
+	BOOST_CHECK_EQUAL(cache->hits(), 1);
+	BOOST_CHECK(first->assembly().items() == second->assembly().items());
+}
+
+BOOST_AUTO_TEST_CASE(hit_at_other_stack_height)
+{
+	// The cached AST does not depend on the stack layout, the DUP and SWAP
+	// instructions for the locals are generated again.
+	auto cache = make_shared<InlineAssemblyCache>();
+	makeContext(cache)->appendInlineAssembly(c_snippet, {"x", "y"});
+
+	auto cached = makeContext(cache, EVMVersion{}, 2);
+	cached->appendInlineAssembly(c_snippet, {"x", "y"});
+	BOOST_CHECK_EQUAL(cache->hits(), 1);
+
+	auto uncached = makeContext(make_shared<InlineAssemblyCache>(), EVMVersion{}, 2);
+	uncached->appendInlineAssembly(c_snippet, {"x", "y"});
+	BOOST_CHECK(cached->assembly().items() == uncached->assembly().items());
+}
+
+BOOST_AUTO_TEST_CASE(miss_on_other_evm_version)
+{
+	auto cache = make_shared<InlineAssemblyCache>();
+	makeContext(cache, EVMVersion::byzantium())->appendInlineAssembly(c_snippet, {"x", "y"});
+	makeContext(cache, EVMVersion::istanbul())->appendInlineAssembly(c_snippet, {"x", "y"});
+	BOOST_CHECK_EQUAL(cache->misses(), 2);
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(miss_on_other_local_variables)
+{
+	auto cache = make_shared<InlineAssemblyCache>();
+	makeContext(cache)->appendInlineAssembly(c_snippet, {"x", "y"});
+	// Same names in another order refer to other stack slots.
+	makeContext(cache)->appendInlineAssembly(c_snippet, {"y", "x"});
+	BOOST_CHECK_EQUAL(cache->misses(), 2);
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(miss_on_other_source_name)
+{
+	auto cache = make_shared<InlineAssemblyCache>();
+	makeContext(cache)->appendInlineAssembly(c_snippet, {"x", "y"});
+	makeContext(cache)->appendInlineAssembly(c_snippet, {"x", "y"}, {}, false, OptimiserSettings::none(), "other");
+	BOOST_CHECK_EQUAL(cache->misses(), 2);
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(system_snippets_are_not_cached)
+{
+	auto cache = make_shared<InlineAssemblyCache>();
+	for (unsigned i = 0; i < 2; ++i)
+	{
+		auto context = make_unique<CompilerContext>(EVMVersion{}, RevertStrings::Default);
+		context->setInlineAssemblyCache(cache);
+		context->appendInlineAssembly("{ function f() -> r { r := 1 } }", {}, {"f"}, true);
+	}
+	BOOST_CHECK_EQUAL(cache->misses(), 0);
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
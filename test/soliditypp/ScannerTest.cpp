@@ -28,6 +28,45 @@ BOOST_AUTO_TEST_CASE(vite_subdenominations)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(keyword_table)
+{
+	// Every keyword is found in the hash table, identifiers that start with a keyword are not.
+#define KEYWORD(name, keyword, precedence) \
+	BOOST_CHECK_EQUAL(get<0>(TokenTraits::fromIdentifierOrKeyword(keyword)), Token::name); \
+	BOOST_CHECK_EQUAL(get<0>(TokenTraits::fromIdentifierOrKeyword(keyword "_")), Token::Identifier); \
+	BOOST_CHECK_EQUAL(get<0>(TokenTraits::fromIdentifierOrKeyword(keyword + string(keyword).substr(1))), Token::Identifier);
+#define TOKEN(name, string, precedence)
+	TOKEN_LIST(TOKEN, KEYWORD)
+#undef KEYWORD
+#undef TOKEN
+
+	Scanner scanner(CharStream("vitetoken uint248 bytes32 ufixed128x18 fixed8x81 uint0248 vitex", ""));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::TokenId);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UIntM);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::BytesM);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UFixedMxN);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(sized_types_with_leading_zeros)
+{
+	// Same as upstream, see test/syntax/solidity/types/weird_sized_types.sol.
+	Scanner scanner(CharStream("bytes01 int01 uint000099000 fixed01x1 ufixed1x01 fixed0x0 int0 bytes1 fixed8x0 uint300", ""));
+	for (unsigned i = 0; i < 7; ++i)
+	{
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+		scanner.next();
+	}
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::BytesM);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::FixedMxN);
+	BOOST_CHECK_EQUAL(get<1>(scanner.currentTokenInfo()), 0);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
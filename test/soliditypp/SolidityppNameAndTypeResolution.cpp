@@ -3,12 +3,15 @@
 #include <test/Common.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libsolutil/Keccak256.h>
 
+#include <boost/algorithm/string/join.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace solidity::langutil;
@@ -16,6 +19,20 @@ using namespace solidity::langutil;
 namespace solidity::frontend::test
 {
 
+namespace
+{
+
+/// @returns the comma-separated live variables of an await of the report.
+string liveVariables(Json::Value const& _await)
+{
+	vector<string> names;
+	for (Json::Value const& name: _await["live"])
+		names.push_back(name.asString());
+	return boost::algorithm::join(names, ",");
+}
+
+}
+
 BOOST_FIXTURE_TEST_SUITE(SolidityppNameAndTypeResolution, AnalysisFramework)
 
 BOOST_AUTO_TEST_CASE(function_canonical_signature_type_aliases)
@@ -38,6 +55,165 @@ BOOST_AUTO_TEST_CASE(function_canonical_signature_type_aliases)
 		}
 }
 
+BOOST_AUTO_TEST_CASE(await_liveness)
+{
+	char const* text = R"(
+		contract C {
+			function f(uint a) external pure returns (uint) {
+				return a;
+			}
+			function g(uint a, uint b) external returns (uint r) {
+				uint unused = a;
+				uint[] memory m = new uint[](2);
+				uint x = await this.f(b);
+				r = x + m[0];
+			}
+		}
+	)";
+	parseAndAnalyse(text);
+	Json::Value report = compiler().awaitReport("C");
+	BOOST_REQUIRE_EQUAL(report["awaits"].size(), 1);
+	Json::Value const& await = report["awaits"][0];
+	BOOST_CHECK_EQUAL(await["function"].asString(), "g");
+	BOOST_CHECK_EQUAL(await["slotsInScope"].asUInt64(), 5);
+	BOOST_CHECK_EQUAL(await["liveSlots"].asUInt64(), 2);
+	BOOST_REQUIRE_EQUAL(await["live"].size(), 2);
+	BOOST_CHECK_EQUAL(await["live"][0].asString(), "r");
+	BOOST_CHECK_EQUAL(await["live"][1].asString(), "m");
+	BOOST_REQUIRE_EQUAL(await["liveMemory"].size(), 1);
+	BOOST_CHECK_EQUAL(await["liveMemory"][0].asString(), "m");
+}
+
+BOOST_AUTO_TEST_CASE(await_liveness_operand_order)
+{
+	char const* text = R"(
+		contract C {
+			function f(uint a) external pure returns (uint) {
+				return a;
+			}
+			function readAfter(uint a) external returns (uint r) {
+				uint x = a;
+				r = x - await this.f(1);
+			}
+			function readBefore(uint a) external returns (uint r) {
+				uint x = a;
+				r = await this.f(1) - x;
+			}
+			function compound(uint a) external {
+				uint x = a;
+				x += await this.f(1);
+			}
+			function indexAfter(uint a) external {
+				uint[] memory m = new uint[](2);
+				m[a] = await this.f(1);
+			}
+		}
+	)";
+	parseAndAnalyse(text);
+	Json::Value report = compiler().awaitReport("C");
+	BOOST_REQUIRE_EQUAL(report["awaits"].size(), 4);
+	// The right operand is evaluated first, so x is read after the callback.
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][0]), "r,x");
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][1]), "r");
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][2]), "x");
+	// The left-hand side of an assignment is evaluated after the value.
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][3]), "a,m");
+	BOOST_CHECK_EQUAL(report["awaits"][3]["liveMemory"][0].asString(), "m");
+}
+
+BOOST_AUTO_TEST_CASE(await_liveness_loops)
+{
+	char const* text = R"(
+		contract C {
+			function f(uint a) external pure returns (uint) {
+				return a;
+			}
+			function g(uint a) external {
+				uint before = a;
+				uint counter = before;
+				for (uint i = 0; i < a; i++) {
+					uint t = i;
+					counter += await this.f(t);
+				}
+			}
+			function h(uint a) external {
+				uint n = a;
+				while (n > 0)
+					n = await this.f(n - 1);
+			}
+		}
+	)";
+	parseAndAnalyse(text);
+	Json::Value report = compiler().awaitReport("C");
+	BOOST_REQUIRE_EQUAL(report["awaits"].size(), 2);
+	// The condition and the loop expression read a and i in the next iteration,
+	// t is declared again in every iteration.
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][0]), "a,counter,i");
+	BOOST_CHECK_EQUAL(report["awaits"][0]["slotsInScope"].asUInt64(), 5);
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][1]), "n");
+}
+
+BOOST_AUTO_TEST_CASE(await_liveness_short_circuit)
+{
+	char const* text = R"(
+		contract C {
+			function b(uint a) external pure returns (bool) {
+				return a > 0;
+			}
+			function leftFirst(bool c, uint a) external returns (bool r) {
+				bool d = c;
+				r = d && await this.b(a);
+			}
+			function rightAfter(bool c, uint a) external returns (bool r) {
+				bool e = c;
+				r = await this.b(a) || e;
+			}
+		}
+	)";
+	parseAndAnalyse(text);
+	Json::Value report = compiler().awaitReport("C");
+	BOOST_REQUIRE_EQUAL(report["awaits"].size(), 2);
+	// && and || evaluate their left operand first.
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][0]), "r");
+	BOOST_CHECK_EQUAL(liveVariables(report["awaits"][1]), "r,e");
+}
+
+BOOST_AUTO_TEST_CASE(packed_storage_layout)
+{
+	char const* text = R"(
+		pragma storagelayout packed;
+		contract A {
+			address a;
+			uint b;
+			vitetoken c;
+		}
+		contract B is A {
+			bool d;
+			uint e;
+			uint64 public f;
+			bool g;
+		}
+	)";
+	SourceUnit const* sourceUnit = parseAndAnalyse(text);
+	map<string, pair<u256, unsigned>> offsets;
+	for (auto const& [variable, slot, offset]: TypeProvider::contract(*retrieveContractByName(*sourceUnit, "B"))->stateVariables())
+		offsets[variable->name()] = {slot, offset};
+	// a and c share a slot after b; the base layout is a prefix of the derived one.
+	BOOST_CHECK(offsets["b"] == make_pair(u256(0), 0u));
+	BOOST_CHECK(offsets["a"] == make_pair(u256(1), 0u));
+	BOOST_CHECK(offsets["c"] == make_pair(u256(1), 21u));
+	// Reordering B does not save a slot, so it keeps the declaration order.
+	BOOST_CHECK(offsets["e"] == make_pair(u256(2), 0u));
+	BOOST_CHECK(offsets["f"] == make_pair(u256(3), 0u));
+	BOOST_CHECK(offsets["d"] == make_pair(u256(1), 31u));
+	BOOST_CHECK(offsets["g"] == make_pair(u256(3), 8u));
+
+	Json::Value const& packing = compiler().storageLayout("B")["packing"];
+	BOOST_CHECK_EQUAL(packing["slots"].asString(), "4");
+	BOOST_CHECK_EQUAL(packing["declarationOrderSlots"].asString(), "5");
+	BOOST_CHECK_EQUAL(packing["slotsSaved"].asString(), "1");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
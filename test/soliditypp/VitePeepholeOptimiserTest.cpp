@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the Vite specific peephole rules.
+ */
+
+#include <test/ViteVM.h>
+
+#include <libevmasm/Assembly.h>
+#include <libevmasm/VitePeepholeOptimiser.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+
+using namespace std;
+using namespace solidity::evmasm;
+using namespace solidity::util;
+
+namespace solidity::test
+{
+
+namespace
+{
+
+h168 const c_contract("0x00bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb01");
+u256 const c_addressMask = (u256(1) << 168) - 1;
+
+struct Comparison
+{
+	AssemblyItems optimisedItems;
+	ViteExecutionResult original;
+	ViteExecutionResult optimised;
+	size_t originalSize = 0;
+	size_t optimisedSize = 0;
+};
+
+/// Runs the code generated by @a _generate with and without the Vite rules and checks that
+/// both versions store the same values in the first @a _slots slots.
+Comparison compare(function<void(Assembly&)> const& _generate, unsigned _slots)
+{
+	Comparison comparison;
+	Assembly original;
+	_generate(original);
+	Assembly optimised;
+	_generate(optimised);
+	VitePeepholeOptimiser{optimised.items()}.optimise();
+	comparison.optimisedItems = optimised.items();
+
+	ViteVM originalVM;
+	bytes originalCode = original.assemble().bytecode;
+	comparison.originalSize = originalCode.size();
+	originalVM.setCode(c_contract, originalCode);
+	comparison.original = originalVM.call(c_contract, bytes());
+
+	ViteVM optimisedVM;
+	bytes optimisedCode = optimised.assemble().bytecode;
+	comparison.optimisedSize = optimisedCode.size();
+	optimisedVM.setCode(c_contract, optimisedCode);
+	comparison.optimised = optimisedVM.call(c_contract, bytes());
+
+	BOOST_CHECK_EQUAL(comparison.original.success, comparison.optimised.success);
+	for (unsigned slot = 0; slot < _slots; ++slot)
+		BOOST_CHECK_EQUAL(originalVM.storage(c_contract, slot), optimisedVM.storage(c_contract, slot));
+	return comparison;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(VitePeepholeOptimiserTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(address_mask_after_caller)
+{
+	Comparison result = compare([](Assembly& _assembly) {
+		_assembly << Instruction::CALLER << c_addressMask << Instruction::AND;
+		_assembly << u256(0) << Instruction::SSTORE << Instruction::STOP;
+	}, 1);
+	BOOST_CHECK_EQUAL(result.optimisedItems.size(), 4);
+	// PUSH21 + AND
+	BOOST_CHECK_EQUAL(result.original.quotaUsed - result.optimised.quotaUsed, 6);
+}
+
+BOOST_AUTO_TEST_CASE(repeated_mask)
+{
+	Comparison result = compare([](Assembly& _assembly) {
+		_assembly << u256(0) << Instruction::CALLDATALOAD;
+		_assembly << c_addressMask << Instruction::AND << u256(0xffffffff) << Instruction::AND;
+		_assembly << u256(0xffffffff) << Instruction::AND << c_addressMask << Instruction::AND;
+		_assembly << u256(0) << Instruction::SSTORE << Instruction::STOP;
+	}, 1);
+	// The last two masks cannot change the value.
+	BOOST_CHECK_EQUAL(result.optimisedItems.size(), 9);
+	BOOST_CHECK_EQUAL(result.original.quotaUsed - result.optimised.quotaUsed, 12);
+}
+
+BOOST_AUTO_TEST_CASE(mask_on_clean_constant)
+{
+	Comparison result = compare([](Assembly& _assembly) {
+		_assembly << u256(0x1234) << c_addressMask << Instruction::AND << u256(0) << Instruction::SSTORE;
+		// Not clean, has to stay.
+		_assembly << (u256(1) << 200) << c_addressMask << Instruction::AND << u256(1) << Instruction::SSTORE;
+		_assembly << Instruction::STOP;
+	}, 2);
+	BOOST_CHECK_EQUAL(result.optimisedItems.size(), 9);
+	BOOST_CHECK_EQUAL(result.original.quotaUsed - result.optimised.quotaUsed, 6);
+}
+
+BOOST_AUTO_TEST_CASE(deduplicate_token_id)
+{
+	Comparison result = compare([](Assembly& _assembly) {
+		_assembly << ViteVM::viteTokenId << ViteVM::viteTokenId << Instruction::EQ;
+		_assembly << ViteVM::viteTokenId << Instruction::SWAP1 << u256(0) << Instruction::SSTORE;
+		_assembly << ViteVM::viteTokenId << Instruction::EQ << u256(1) << Instruction::SSTORE;
+		_assembly << Instruction::STOP;
+	}, 2);
+	AssemblyItems const& items = result.optimisedItems;
+	BOOST_REQUIRE_EQUAL(items.size(), 12);
+	BOOST_CHECK(items[1] == Instruction::DUP1);
+	// The first copy has been consumed by EQ, but the third push is still on the stack.
+	BOOST_CHECK(items[3].type() == Push);
+	BOOST_CHECK(items[7] == Instruction::DUP1);
+	BOOST_CHECK_EQUAL(result.original.quotaUsed, result.optimised.quotaUsed);
+	// Two PUSH10 replaced by DUP1.
+	BOOST_CHECK_EQUAL(result.originalSize - result.optimisedSize, 20);
+}
+
+BOOST_AUTO_TEST_CASE(no_deduplication_across_blocks)
+{
+	Assembly assembly;
+	AssemblyItem tag = assembly.newTag();
+	assembly << ViteVM::viteTokenId << tag << ViteVM::viteTokenId << Instruction::EQ << Instruction::STOP;
+	AssemblyItems items = assembly.items();
+	VitePeepholeOptimiser{items}.optimise();
+	BOOST_CHECK(items == assembly.items());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
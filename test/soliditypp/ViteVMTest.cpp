@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the in-process ViteVM used by the semantic tests.
+ */
+
+#include <test/ViteVM.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::evmasm;
+using namespace solidity::util;
+
+namespace solidity::test
+{
+
+namespace
+{
+
+h168 const c_caller("0x00aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa01");
+h168 const c_callee("0x00bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb01");
+
+bytes assemble(Assembly const& _assembly)
+{
+	return _assembly.assemble().bytecode;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ViteVMTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(arithmetic_and_quota)
+{
+	Assembly code;
+	code << u256(2) << u256(3) << Instruction::ADD << u256(0) << Instruction::SSTORE << Instruction::STOP;
+
+	ViteVM vm;
+	vm.setCode(c_callee, assemble(code));
+	ViteExecutionResult result = vm.call(c_callee, bytes());
+
+	BOOST_CHECK(result.success);
+	BOOST_CHECK_EQUAL(vm.storage(c_callee, 0), 5);
+	// 3 * PUSH1 + ADD + SSTORE
+	BOOST_CHECK_EQUAL(result.quotaUsed, 3 * 3 + 3 + 5000);
+	BOOST_CHECK_EQUAL(result.quotaByInstruction[Instruction::SSTORE], 5000);
+}
+
+BOOST_AUTO_TEST_CASE(failure_refunds_value)
+{
+	Assembly code;
+	code << Instruction::INVALID;
+
+	ViteVM vm;
+	vm.setCode(c_callee, assemble(code));
+	vm.setBalance(c_caller, 100);
+	ViteExecutionResult result = vm.call(c_callee, bytes(), 10, ViteVM::viteTokenId, c_caller);
+
+	BOOST_CHECK(!result.success);
+	BOOST_CHECK_EQUAL(vm.balance(c_callee), 0);
+	BOOST_CHECK_EQUAL(vm.balance(c_caller), 100);
+}
+
+BOOST_AUTO_TEST_CASE(async_call_is_queued)
+{
+	// Callee stores the received amount.
+	Assembly callee;
+	callee << Instruction::CALLVALUE << u256(0) << Instruction::SSTORE << Instruction::STOP;
+
+	// Caller sends 7 VITE without waiting for the callee and then writes its own slot.
+	Assembly caller;
+	caller << u256(0) << u256(0) << u256(7) << ViteVM::viteTokenId << u256(h168::Arith(c_callee));
+	caller << Instruction::CALL;
+	caller << u256(1) << u256(0) << Instruction::SSTORE << Instruction::STOP;
+
+	ViteVM vm;
+	vm.setCode(c_callee, assemble(callee));
+	vm.setCode(c_caller, assemble(caller));
+	vm.setBalance(c_caller, 7);
+	vm.call(c_caller, bytes());
+
+	BOOST_REQUIRE_EQUAL(vm.history().size(), 2);
+	BOOST_CHECK(vm.history()[0].second.success);
+	BOOST_CHECK(vm.history()[1].first.kind == ViteMessage::Kind::Call);
+	BOOST_CHECK_EQUAL(vm.storage(c_caller, 0), 1);
+	BOOST_CHECK_EQUAL(vm.storage(c_callee, 0), 7);
+	BOOST_CHECK_EQUAL(vm.balance(c_callee), 7);
+}
+
+BOOST_AUTO_TEST_CASE(sync_call_resumes_at_callback_dest)
+{
+	uint32_t const callbackId = 1;
+
+	// Callee returns the word 42.
+	Assembly callee;
+	callee << u256(42) << u256(0) << Instruction::MSTORE << u256(32) << u256(0) << Instruction::RETURN;
+
+	Assembly caller;
+	AssemblyItem start = caller.newTag();
+	AssemblyItem continuation = caller.newTag();
+	// Empty calldata starts the call, otherwise dispatch the callback id.
+	caller << Instruction::CALLDATASIZE << Instruction::ISZERO;
+	caller.appendJumpI(start);
+	caller << u256(0) << Instruction::CALLDATALOAD << u256(224) << Instruction::SHR << u256(callbackId) << Instruction::EQ;
+	caller.appendJumpI(continuation);
+	caller << Instruction::INVALID;
+	caller << start;
+	// A stack slot that has to survive the suspension.
+	caller << u256(11);
+	caller << u256(0) << u256(0) << u256(0) << ViteVM::viteTokenId << u256(h168::Arith(c_callee)) << u256(callbackId);
+	caller << Instruction::SYNCCALL << Instruction::STOP;
+	caller << continuation << Instruction::CALLBACKDEST;
+	// Stack: 11 success
+	caller << u256(0) << Instruction::SSTORE;
+	caller << u256(1) << Instruction::SSTORE;
+	caller << u256(32) << u256(0) << u256(0) << Instruction::RETURNDATACOPY;
+	caller << u256(0) << Instruction::MLOAD << u256(2) << Instruction::SSTORE << Instruction::STOP;
+
+	ViteVM vm;
+	vm.setCode(c_callee, assemble(callee));
+	vm.setCode(c_caller, assemble(caller));
+	ViteExecutionResult result = vm.call(c_caller, bytes());
+
+	BOOST_CHECK(result.suspended);
+	BOOST_REQUIRE_EQUAL(vm.history().size(), 3);
+	BOOST_CHECK(vm.history()[1].first.kind == ViteMessage::Kind::SyncCall);
+	BOOST_CHECK(vm.history()[2].first.kind == ViteMessage::Kind::Callback);
+	BOOST_CHECK(vm.history()[2].second.success);
+	BOOST_CHECK_EQUAL(vm.storage(c_caller, 0), 1);
+	BOOST_CHECK_EQUAL(vm.storage(c_caller, 1), 11);
+	BOOST_CHECK_EQUAL(vm.storage(c_caller, 2), 42);
+	BOOST_CHECK_EQUAL(vm.history()[2].second.quotaByInstruction.at(Instruction::CALLBACKDEST), 700);
+}
+
+BOOST_AUTO_TEST_CASE(failure_rolls_back_state)
+{
+	// Writes storage, sends 1 VITE to the callee and reverts.
+	Assembly caller;
+	caller << u256(1) << u256(0) << Instruction::SSTORE;
+	caller << u256(0) << u256(0) << u256(1) << ViteVM::viteTokenId << u256(h168::Arith(c_callee));
+	caller << Instruction::CALL;
+	caller << u256(0) << u256(0) << Instruction::REVERT;
+
+	ViteVM vm;
+	vm.setCode(c_caller, assemble(caller));
+	vm.setBalance(c_caller, 5);
+	ViteExecutionResult result = vm.call(c_caller, bytes());
+
+	BOOST_CHECK(!result.success);
+	BOOST_CHECK_EQUAL(vm.history().size(), 1);
+	BOOST_CHECK_EQUAL(vm.storage(c_caller, 0), 0);
+	BOOST_CHECK_EQUAL(vm.balance(c_caller), 5);
+	BOOST_CHECK_EQUAL(vm.balance(c_callee), 0);
+}
+
+BOOST_AUTO_TEST_CASE(call_above_balance_fails)
+{
+	ViteVM vm;
+	vm.setBalance(c_caller, 5);
+	ViteExecutionResult result = vm.call(c_callee, bytes(), 10, ViteVM::viteTokenId, c_caller);
+
+	BOOST_CHECK(!result.success);
+	BOOST_CHECK_EQUAL(vm.balance(c_caller), 5);
+	BOOST_CHECK_EQUAL(vm.balance(c_callee), 0);
+}
+
+BOOST_AUTO_TEST_CASE(sync_calls_with_same_callback_id)
+{
+	uint32_t const callbackId = 1;
+
+	Assembly callee;
+	callee << u256(0) << u256(0) << Instruction::RETURN;
+
+	Assembly caller;
+	AssemblyItem start = caller.newTag();
+	AssemblyItem continuation = caller.newTag();
+	caller << Instruction::CALLDATASIZE << Instruction::ISZERO;
+	caller.appendJumpI(start);
+	caller << u256(0) << Instruction::CALLDATALOAD << u256(224) << Instruction::SHR << u256(callbackId) << Instruction::EQ;
+	caller.appendJumpI(continuation);
+	caller << Instruction::INVALID;
+	caller << start;
+	// Two calls in flight with the same callee and callback id, saving different stacks.
+	caller << u256(11);
+	caller << u256(0) << u256(0) << u256(0) << ViteVM::viteTokenId << u256(h168::Arith(c_callee)) << u256(callbackId);
+	caller << Instruction::SYNCCALL;
+	caller << u256(22);
+	caller << u256(0) << u256(0) << u256(0) << ViteVM::viteTokenId << u256(h168::Arith(c_callee)) << u256(callbackId);
+	caller << Instruction::SYNCCALL << Instruction::STOP;
+	// Stores the top of the saved stack at the slot of the same number.
+	caller << continuation << Instruction::CALLBACKDEST << Instruction::POP;
+	caller << Instruction::DUP1 << Instruction::DUP1 << Instruction::SSTORE << Instruction::STOP;
+
+	ViteVM vm;
+	vm.setCode(c_callee, assemble(callee));
+	vm.setCode(c_caller, assemble(caller));
+	vm.call(c_caller, bytes());
+
+	BOOST_REQUIRE_EQUAL(vm.history().size(), 5);
+	BOOST_CHECK(vm.history()[3].second.success);
+	BOOST_CHECK(vm.history()[4].second.success);
+	BOOST_CHECK_EQUAL(vm.storage(c_caller, 11), 11);
+	BOOST_CHECK_EQUAL(vm.storage(c_caller, 22), 22);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
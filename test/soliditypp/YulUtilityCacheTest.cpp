@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of optimised Yul utility functions.
+ */
+
+#include <libsolidity/codegen/YulUtilityCache.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity::langutil;
+using namespace solidity::util;
+namespace fs = boost::filesystem;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string const c_code = "{ function abi_decode(x) -> y { y := x } }";
+
+/// Resets the process-wide cache around each test and provides a cache directory.
+class YulUtilityCacheFixture
+{
+public:
+	YulUtilityCacheFixture():
+		m_directory(fs::temp_directory_path() / fs::unique_path("solppc-yul-cache-test-%%%%-%%%%"))
+	{
+		YulUtilityCache::instance().clear();
+	}
+	~YulUtilityCacheFixture()
+	{
+		YulUtilityCache::instance().setDirectory({});
+		YulUtilityCache::instance().setMemoryLimit(64 * 1024 * 1024);
+		YulUtilityCache::instance().clear();
+		boost::system::error_code error;
+		fs::remove_all(m_directory, error);
+	}
+
+	h256 key(OptimiserSettings const& _settings = OptimiserSettings::standard()) const
+	{
+		return YulUtilityCache::key(c_code, {"abi_decode"}, _settings, EVMVersion{}, false);
+	}
+
+protected:
+	YulUtilityCache& m_cache = YulUtilityCache::instance();
+	fs::path m_directory;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(YulUtilityCacheTest, YulUtilityCacheFixture, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(hit_and_miss)
+{
+	BOOST_CHECK(!m_cache.find(key()));
+	m_cache.insert(key(), "optimised");
+	BOOST_CHECK(m_cache.find(key()) == string("optimised"));
+	BOOST_CHECK_EQUAL(m_cache.misses(), 1);
+	BOOST_CHECK_EQUAL(m_cache.hits(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(key_covers_settings)
+{
+	OptimiserSettings noCSE = OptimiserSettings::standard();
+	noCSE.runCSE = false;
+	OptimiserSettings otherSteps = OptimiserSettings::standard();
+	otherSteps.yulOptimiserSteps = "d";
+	OptimiserSettings otherRuns = OptimiserSettings::standard();
+	otherRuns.expectedExecutionsPerDeployment = 1;
+
+	h256 base = key();
+	BOOST_CHECK(base == key());
+	BOOST_CHECK(base != key(noCSE));
+	BOOST_CHECK(base != key(otherSteps));
+	BOOST_CHECK(base != key(otherRuns));
+	BOOST_CHECK(base != YulUtilityCache::key(c_code, {"abi_decode"}, OptimiserSettings::standard(), EVMVersion{}, true));
+	BOOST_CHECK(base != YulUtilityCache::key(c_code, {"abi_decode"}, OptimiserSettings::standard(), EVMVersion::byzantium(), false));
+	BOOST_CHECK(base != YulUtilityCache::key(c_code, {}, OptimiserSettings::standard(), EVMVersion{}, false));
+	BOOST_CHECK(base != YulUtilityCache::key(c_code + " ", {"abi_decode"}, OptimiserSettings::standard(), EVMVersion{}, false));
+}
+
+BOOST_AUTO_TEST_CASE(disk_entry_survives_clear)
+{
+	m_cache.setDirectory(m_directory);
+	m_cache.insert(key(), "optimised");
+	m_cache.clear();
+	BOOST_CHECK(m_cache.find(key()) == string("optimised"));
+	BOOST_CHECK_EQUAL(m_cache.hits(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(corrupt_disk_entry)
+{
+	m_cache.setDirectory(m_directory);
+	m_cache.insert(key(), "optimised");
+	m_cache.clear();
+
+	fs::path file = m_directory / (key().hex() + ".yul");
+	BOOST_REQUIRE(fs::exists(file));
+	string content = readFileAsString(file.string());
+	content.back() = '!';
+	ofstream(file.string(), ios::binary | ios::trunc) << content;
+
+	BOOST_CHECK(!m_cache.find(key()));
+	BOOST_CHECK_EQUAL(m_cache.misses(), 1);
+	BOOST_CHECK(!fs::exists(file));
+
+	// Regenerated code replaces the entry.
+	m_cache.insert(key(), "optimised");
+	m_cache.clear();
+	BOOST_CHECK(m_cache.find(key()) == string("optimised"));
+}
+
+BOOST_AUTO_TEST_CASE(truncated_disk_entry)
+{
+	m_cache.setDirectory(m_directory);
+	fs::create_directories(m_directory);
+	ofstream((m_directory / (key().hex() + ".yul")).string(), ios::binary) << "0123";
+	BOOST_CHECK(!m_cache.find(key()));
+	BOOST_CHECK_EQUAL(m_cache.misses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(memory_limit)
+{
+	OptimiserSettings other = OptimiserSettings::standard();
+	other.runPeephole = false;
+	m_cache.setMemoryLimit(10);
+	m_cache.insert(key(), "12345");
+	m_cache.insert(key(other), "67890");
+	// Both fit; using the first one makes the second the least recently used.
+	BOOST_CHECK(m_cache.find(key()));
+	m_cache.insert(YulUtilityCache::key(c_code, {}, other, EVMVersion{}, false), "abc");
+	BOOST_CHECK(m_cache.find(key()));
+	BOOST_CHECK(!m_cache.find(key(other)));
+
+	// Entries larger than the limit are not kept.
+	m_cache.insert(key(other), "12345678901");
+	BOOST_CHECK(!m_cache.find(key(other)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
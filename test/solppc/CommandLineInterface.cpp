@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the --output-dir files and the --standard-json batches of the command line interface.
+ */
+
+#include <solppc/CommandLineInterface.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace solidity::util;
+namespace fs = boost::filesystem;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Provides a directory with the source a.solpp and runs solppc on it.
+class CommandLineFixture
+{
+public:
+	CommandLineFixture():
+		m_directory(fs::temp_directory_path() / fs::unique_path("solppc-cli-test-%%%%-%%%%"))
+	{
+		fs::create_directories(m_directory);
+		ofstream((m_directory / "a.solpp").string()) <<
+			"pragma soliditypp >=0.8.0;\ncontract A { function f() external pure returns (uint256) { return 1; } }\n";
+	}
+	~CommandLineFixture()
+	{
+		boost::system::error_code error;
+		fs::remove_all(m_directory, error);
+	}
+
+	/// Runs solppc with @a _arguments followed by the source.
+	/// @returns true on success, the standard error output is stored in m_errors.
+	bool run(vector<string> _arguments)
+	{
+		_arguments.push_back((m_directory / "a.solpp").string());
+		return runWithoutSource(move(_arguments));
+	}
+
+	/// Runs solppc with @a _arguments only. The standard output is stored in m_output.
+	bool runWithoutSource(vector<string> _arguments)
+	{
+		_arguments.insert(_arguments.begin(), "solppc");
+		vector<char*> argv;
+		for (string& argument: _arguments)
+			argv.push_back(argument.data());
+
+		ostringstream errors;
+		ostringstream output;
+		streambuf* cerrBuffer = cerr.rdbuf(errors.rdbuf());
+		streambuf* coutBuffer = cout.rdbuf(output.rdbuf());
+		bool success = false;
+		try
+		{
+			CommandLineInterface cli;
+			success =
+				cli.parseArguments(static_cast<int>(argv.size()), argv.data()) &&
+				cli.processInput() &&
+				cli.actOnInput();
+		}
+		catch (...)
+		{
+			cerr.rdbuf(cerrBuffer);
+			cout.rdbuf(coutBuffer);
+			throw;
+		}
+		cerr.rdbuf(cerrBuffer);
+		cout.rdbuf(coutBuffer);
+		m_errors = errors.str();
+		m_output = output.str();
+		return success;
+	}
+
+	fs::path outputFile(string const& _name) const { return m_directory / "out" / _name; }
+	string outputDirectory() const { return (m_directory / "out").string(); }
+
+protected:
+	fs::path m_directory;
+	string m_errors;
+	string m_output;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(CommandLineInterfaceTest, CommandLineFixture, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(output_dir_files_are_written)
+{
+	BOOST_REQUIRE_MESSAGE(run({"--bin", "--abi", "--output-dir", outputDirectory()}), m_errors);
+	BOOST_REQUIRE(fs::is_regular_file(outputFile("A.bin")));
+	BOOST_REQUIRE(fs::is_regular_file(outputFile("A.abi")));
+	BOOST_CHECK(!readFileAsString(outputFile("A.bin").string()).empty());
+	BOOST_CHECK(readFileAsString(outputFile("A.abi").string()).find("\"name\":\"f\"") != string::npos);
+
+	// No temporary files are left behind.
+	size_t files = 0;
+	for (auto const& entry: fs::directory_iterator(outputDirectory()))
+		if (fs::is_regular_file(entry.path()))
+			++files;
+	BOOST_CHECK_EQUAL(files, 2);
+}
+
+BOOST_AUTO_TEST_CASE(existing_files_are_not_overwritten)
+{
+	BOOST_REQUIRE_MESSAGE(run({"--bin", "--output-dir", outputDirectory()}), m_errors);
+	BOOST_CHECK(!run({"--bin", "--output-dir", outputDirectory()}));
+	BOOST_CHECK(m_errors.find("Refusing to overwrite existing file") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(unchanged_files_are_skipped)
+{
+	BOOST_REQUIRE_MESSAGE(run({"--bin", "--abi", "--output-dir", outputDirectory()}), m_errors);
+	time_t const past = time(nullptr) - 3600;
+	fs::last_write_time(outputFile("A.bin"), past);
+	fs::last_write_time(outputFile("A.abi"), past);
+	// A file with other content is replaced.
+	ofstream(outputFile("A.abi").string(), ios::app) << " ";
+	fs::last_write_time(outputFile("A.abi"), past);
+
+	BOOST_REQUIRE_MESSAGE(run({"--bin", "--abi", "--overwrite", "--output-dir", outputDirectory()}), m_errors);
+	BOOST_CHECK_EQUAL(fs::last_write_time(outputFile("A.bin")), past);
+	BOOST_CHECK(fs::last_write_time(outputFile("A.abi")) != past);
+	BOOST_CHECK(readFileAsString(outputFile("A.abi").string()).back() != ' ');
+}
+
+BOOST_AUTO_TEST_CASE(output_dir_cannot_be_created)
+{
+	// A regular file is in the way of the output directory.
+	ofstream(outputDirectory()) << "not a directory";
+	BOOST_CHECK(!run({"--bin", "--output-dir", outputDirectory()}));
+	BOOST_CHECK(m_errors.find("Could not create output directory") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(output_file_cannot_be_written)
+{
+	// A directory is in the way of one of the files, the other file is still written.
+	fs::create_directories(outputFile("A.bin"));
+	BOOST_CHECK(!run({"--bin", "--abi", "--overwrite", "--output-dir", outputDirectory()}));
+	BOOST_CHECK(m_errors.find("Could not write to file") != string::npos);
+	BOOST_CHECK(fs::is_regular_file(outputFile("A.abi")));
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_batch)
+{
+	auto writeInput = [&](string const& _name, string const& _contract)
+	{
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["c.solpp"]["content"] = "pragma soliditypp >=0.8.0;\ncontract " + _contract + " {}\n";
+		input["settings"]["outputSelection"]["*"]["*"].append("abi");
+		ofstream((m_directory / _name).string()) << jsonCompactPrint(input);
+		return (m_directory / _name).string();
+	};
+	string const first = writeInput("first.json", "First");
+	string const second = writeInput("second.json", "Second");
+	string const invalid = (m_directory / "invalid.json").string();
+	ofstream(invalid) << "{ invalid";
+
+	BOOST_REQUIRE_MESSAGE(runWithoutSource({"--standard-json", "--max-in-flight", "1", second, invalid, first}), m_errors);
+	Json::Value outputs;
+	BOOST_REQUIRE_MESSAGE(jsonParseStrict(m_output, outputs), m_output);
+	BOOST_REQUIRE(outputs.isArray());
+	BOOST_REQUIRE_EQUAL(outputs.size(), 3);
+	BOOST_CHECK(outputs[0]["contracts"]["c.solpp"].isMember("Second"));
+	BOOST_CHECK_EQUAL(outputs[1]["errors"][0]["type"].asString(), "JSONError");
+	BOOST_CHECK(outputs[2]["contracts"]["c.solpp"].isMember("First"));
+
+	BOOST_CHECK(!runWithoutSource({"--standard-json", first, (m_directory / "missing.json").string()}));
+	BOOST_CHECK(m_errors.find("File not found") != string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
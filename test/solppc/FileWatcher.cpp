@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the change notifications of solppc --watch.
+ */
+
+#include <solppc/FileWatcher.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <future>
+#include <thread>
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+chrono::milliseconds const c_debounce(50);
+
+/// Provides a directory with the files a.solpp and b.solpp.
+class FileWatcherFixture
+{
+public:
+	FileWatcherFixture():
+		m_directory(fs::temp_directory_path() / fs::unique_path("solppc-watch-test-%%%%-%%%%"))
+	{
+		fs::create_directories(m_directory);
+		m_directory = fs::canonical(m_directory);
+		write("a.solpp", "contract A {}");
+		write("b.solpp", "contract B {}");
+	}
+	~FileWatcherFixture()
+	{
+		boost::system::error_code error;
+		fs::remove_all(m_directory, error);
+	}
+
+	fs::path file(string const& _name) const { return m_directory / _name; }
+	void write(string const& _name, string const& _content) const
+	{
+		ofstream(file(_name).string(), ios::binary | ios::trunc) << _content;
+	}
+
+	/// Runs @a _change after the watcher started waiting.
+	/// @returns the changes reported by @a _watcher.
+	set<fs::path> waitFor(FileWatcher& _watcher, function<void()> _change) const
+	{
+		auto changed = async(launch::async, [&]() { return _watcher.wait(c_debounce); });
+		this_thread::sleep_for(chrono::milliseconds(100));
+		_change();
+		BOOST_REQUIRE(changed.wait_for(chrono::seconds(10)) == future_status::ready);
+		return changed.get();
+	}
+
+protected:
+	fs::path m_directory;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(FileWatcherTest, FileWatcherFixture, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(polling_reports_written_file)
+{
+	FileWatcher watcher(true);
+	watcher.watch({file("a.solpp"), file("b.solpp")});
+	// The content has another size, so the change is seen within the same second.
+	set<fs::path> changed = waitFor(watcher, [&]() { write("b.solpp", "contract B { uint x; }"); });
+	BOOST_CHECK(changed == set<fs::path>{file("b.solpp")});
+}
+
+BOOST_AUTO_TEST_CASE(polling_reports_changes_together)
+{
+	FileWatcher watcher(true);
+	watcher.watch({file("a.solpp"), file("b.solpp")});
+	set<fs::path> changed = waitFor(watcher, [&]() {
+		write("a.solpp", "contract A { uint x; }");
+		fs::remove(file("b.solpp"));
+	});
+	BOOST_CHECK(changed == (set<fs::path>{file("a.solpp"), file("b.solpp")}));
+
+	// A removed file that is created again is a change as well.
+	changed = waitFor(watcher, [&]() { write("b.solpp", "contract B {}"); });
+	BOOST_CHECK(changed == set<fs::path>{file("b.solpp")});
+}
+
+BOOST_AUTO_TEST_CASE(polling_ignores_unwatched_files)
+{
+	FileWatcher watcher(true);
+	watcher.watch({file("a.solpp")});
+	set<fs::path> changed = waitFor(watcher, [&]() {
+		write("b.solpp", "contract B { uint x; }");
+		write("a.solpp", "contract A { uint x; }");
+	});
+	BOOST_CHECK(changed == set<fs::path>{file("a.solpp")});
+}
+
+BOOST_AUTO_TEST_CASE(default_watcher_reports_written_file)
+{
+	FileWatcher watcher;
+	watcher.watch({file("a.solpp"), file("b.solpp")});
+	set<fs::path> changed = waitFor(watcher, [&]() { write("a.solpp", "contract A { uint x; }"); });
+	BOOST_CHECK(changed == set<fs::path>{file("a.solpp")});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the message exchange of the language server.
+ */
+
+#include <solppls/LanguageServer.h>
+#include <solppls/Transport.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace solidity::lsp::test
+{
+
+namespace
+{
+
+string frame(Json::Value _message)
+{
+	_message["jsonrpc"] = "2.0";
+	string content = jsonCompactPrint(_message);
+	return "Content-Length: " + to_string(content.size()) + "\r\n\r\n" + content;
+}
+
+Json::Value request(Json::Value const& _id, string const& _method, Json::Value _params = Json::objectValue)
+{
+	Json::Value message;
+	if (!_id.isNull())
+		message["id"] = _id;
+	message["method"] = _method;
+	message["params"] = move(_params);
+	return message;
+}
+
+Json::Value position(string const& _uri, unsigned _line, unsigned _character)
+{
+	Json::Value params;
+	params["textDocument"]["uri"] = _uri;
+	params["position"]["line"] = _line;
+	params["position"]["character"] = _character;
+	return params;
+}
+
+/// Runs the server on the messages @a _input.
+/// @returns the messages sent by the server, read back with a second transport.
+vector<Json::Value> exchange(vector<Json::Value> const& _input, bool& _shutdownRequested)
+{
+	string input;
+	for (Json::Value const& message: _input)
+		input += frame(message);
+	istringstream in(input);
+	ostringstream out;
+	{
+		Transport transport(in, out);
+		LanguageServer server(transport, {}, chrono::milliseconds(0));
+		_shutdownRequested = server.run();
+	}
+
+	istringstream replies(out.str());
+	ostringstream unused;
+	Transport reader(replies, unused);
+	vector<Json::Value> messages;
+	for (optional<Json::Value> message = reader.receive(); !message->isNull(); message = reader.receive())
+		messages.push_back(move(*message));
+	return messages;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(LanguageServerExchange, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(initialize_open_and_diagnostics)
+{
+	Json::Value open;
+	open["textDocument"]["uri"] = "a.solpp";
+	open["textDocument"]["languageId"] = "soliditypp";
+	open["textDocument"]["version"] = 1;
+	open["textDocument"]["text"] =
+		"pragma soliditypp >=0.8.0;\n"
+		"contract A { function f() public { undeclared = 1; } }\n";
+
+	bool shutdownRequested = false;
+	vector<Json::Value> messages = exchange({
+		request(1, "initialize"),
+		request(Json::Value{}, "initialized"),
+		request(Json::Value{}, "textDocument/didOpen", open),
+		// Requests run the pending analysis before they are answered.
+		request(2, "textDocument/hover", position("a.solpp", 1, 9)),
+		request(3, "unknown/method"),
+		request(4, "shutdown"),
+		request(Json::Value{}, "exit")
+	}, shutdownRequested);
+	BOOST_CHECK(shutdownRequested);
+
+	BOOST_REQUIRE_EQUAL(messages.size(), 5);
+	BOOST_CHECK_EQUAL(messages[0]["id"].asInt(), 1);
+	Json::Value const& capabilities = messages[0]["result"]["capabilities"];
+	BOOST_CHECK(capabilities["textDocumentSync"]["openClose"].asBool());
+	BOOST_CHECK(capabilities["hoverProvider"].asBool());
+	BOOST_CHECK_EQUAL(messages[0]["result"]["serverInfo"]["name"].asString(), "solppls");
+
+	BOOST_CHECK_EQUAL(messages[1]["method"].asString(), "textDocument/publishDiagnostics");
+	BOOST_CHECK_EQUAL(messages[1]["params"]["uri"].asString(), "a.solpp");
+	Json::Value const& diagnostics = messages[1]["params"]["diagnostics"];
+	BOOST_REQUIRE_EQUAL(diagnostics.size(), 1);
+	BOOST_CHECK_EQUAL(diagnostics[0]["severity"].asInt(), 1);
+	BOOST_CHECK_EQUAL(diagnostics[0]["source"].asString(), "solppls");
+	BOOST_CHECK_EQUAL(diagnostics[0]["range"]["start"]["line"].asInt(), 1);
+	BOOST_CHECK(diagnostics[0]["message"].asString().find("Undeclared identifier") != string::npos);
+
+	BOOST_CHECK_EQUAL(messages[2]["id"].asInt(), 2);
+	BOOST_CHECK(messages[2].isMember("result"));
+	BOOST_CHECK_EQUAL(messages[3]["id"].asInt(), 3);
+	BOOST_CHECK_EQUAL(messages[3]["error"]["code"].asInt(), -32601);
+	BOOST_CHECK_EQUAL(messages[4]["id"].asInt(), 4);
+	BOOST_CHECK(messages[4]["result"].isNull());
+}
+
+BOOST_AUTO_TEST_CASE(exit_without_shutdown)
+{
+	bool shutdownRequested = true;
+	vector<Json::Value> messages = exchange({request(Json::Value{}, "exit")}, shutdownRequested);
+	BOOST_CHECK(!shutdownRequested);
+	BOOST_CHECK(messages.empty());
+}
+
+BOOST_AUTO_TEST_CASE(fixed_source_clears_diagnostics)
+{
+	Json::Value open;
+	open["textDocument"]["uri"] = "a.solpp";
+	open["textDocument"]["text"] = "pragma soliditypp >=0.8.0;\ncontract A { function f() public { undeclared = 1; } }\n";
+	Json::Value change;
+	change["textDocument"]["uri"] = "a.solpp";
+	change["contentChanges"][0]["text"] = "pragma soliditypp >=0.8.0;\ncontract A { function f() public {} }\n";
+
+	bool shutdownRequested = false;
+	vector<Json::Value> messages = exchange({
+		request(1, "initialize"),
+		request(Json::Value{}, "textDocument/didOpen", open),
+		request(2, "textDocument/hover", position("a.solpp", 1, 9)),
+		request(Json::Value{}, "textDocument/didChange", change),
+		request(3, "textDocument/hover", position("a.solpp", 1, 9)),
+		request(Json::Value{}, "exit")
+	}, shutdownRequested);
+
+	vector<Json::Value> diagnostics;
+	for (Json::Value const& message: messages)
+		if (message["method"] == "textDocument/publishDiagnostics")
+			diagnostics.push_back(message["params"]["diagnostics"]);
+	BOOST_REQUIRE_EQUAL(diagnostics.size(), 2);
+	BOOST_CHECK_EQUAL(diagnostics[0].size(), 1);
+	BOOST_CHECK_EQUAL(diagnostics[1].size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
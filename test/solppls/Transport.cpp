@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the message framing of the language server.
+ */
+
+#include <solppls/Transport.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace solidity::lsp::test
+{
+
+namespace
+{
+
+string frame(string const& _content)
+{
+	return "Content-Length: " + to_string(_content.size()) + "\r\n\r\n" + _content;
+}
+
+/// @returns the messages of the framed output @a _output, checking the headers.
+vector<Json::Value> parseFrames(string const& _output)
+{
+	vector<Json::Value> messages;
+	size_t position = 0;
+	while (position < _output.size())
+	{
+		string const header = "Content-Length: ";
+		BOOST_REQUIRE(_output.compare(position, header.size(), header) == 0);
+		size_t end = _output.find("\r\n\r\n", position);
+		BOOST_REQUIRE(end != string::npos);
+		size_t length = stoul(_output.substr(position + header.size(), end - position - header.size()));
+		BOOST_REQUIRE(end + 4 + length <= _output.size());
+		Json::Value message;
+		BOOST_REQUIRE(jsonParseStrict(_output.substr(end + 4, length), message));
+		BOOST_CHECK_EQUAL(message["jsonrpc"].asString(), "2.0");
+		messages.push_back(move(message));
+		position = end + 4 + length;
+	}
+	return messages;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(LanguageServerTransport, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(reads_framed_messages)
+{
+	istringstream in(
+		"Content-Length: 46\r\nContent-Type: application/vscode-jsonrpc; charset=utf-8\r\n\r\n"
+		R"({"jsonrpc":"2.0","id":1,"method":"initialize"})" +
+		frame("{ not json") +
+		frame(R"([1, 2])") +
+		frame(R"({"jsonrpc":"2.0","method":"initialized","params":{}})")
+	);
+	ostringstream out;
+	Transport transport(in, out);
+
+	optional<Json::Value> message = transport.receive();
+	BOOST_REQUIRE(message && !message->isNull());
+	BOOST_CHECK_EQUAL((*message)["id"].asInt(), 1);
+	BOOST_CHECK_EQUAL((*message)["method"].asString(), "initialize");
+
+	// Malformed messages and messages that are not objects are skipped.
+	message = transport.receive();
+	BOOST_REQUIRE(message && !message->isNull());
+	BOOST_CHECK_EQUAL((*message)["method"].asString(), "initialized");
+
+	// The end of the input is reported as a null message.
+	message = transport.receive();
+	BOOST_REQUIRE(message);
+	BOOST_CHECK(message->isNull());
+	BOOST_CHECK(out.str().empty());
+}
+
+BOOST_AUTO_TEST_CASE(truncated_message)
+{
+	istringstream in(frame(R"({"jsonrpc":"2.0","method":"initialized"})").substr(0, 30));
+	ostringstream out;
+	Transport transport(in, out);
+	optional<Json::Value> message = transport.receive();
+	BOOST_REQUIRE(message);
+	BOOST_CHECK(message->isNull());
+}
+
+BOOST_AUTO_TEST_CASE(stops_reading_after_exit)
+{
+	istringstream in(
+		frame(R"({"jsonrpc":"2.0","method":"exit"})") +
+		frame(R"({"jsonrpc":"2.0","id":2,"method":"shutdown"})")
+	);
+	ostringstream out;
+	Transport transport(in, out);
+	optional<Json::Value> message = transport.receive();
+	BOOST_REQUIRE(message && !message->isNull());
+	BOOST_CHECK_EQUAL((*message)["method"].asString(), "exit");
+	message = transport.receive();
+	BOOST_REQUIRE(message);
+	BOOST_CHECK(message->isNull());
+}
+
+BOOST_AUTO_TEST_CASE(writes_framed_messages)
+{
+	istringstream in;
+	ostringstream out;
+	{
+		Transport transport(in, out);
+		transport.reply(1, "result");
+		Json::Value params;
+		params["uri"] = "a.solpp";
+		transport.notify("textDocument/publishDiagnostics", params);
+		transport.error("request", -32601, "Unknown method");
+	}
+
+	vector<Json::Value> messages = parseFrames(out.str());
+	BOOST_REQUIRE_EQUAL(messages.size(), 3);
+	BOOST_CHECK_EQUAL(messages[0]["id"].asInt(), 1);
+	BOOST_CHECK_EQUAL(messages[0]["result"].asString(), "result");
+	BOOST_CHECK(!messages[1].isMember("id"));
+	BOOST_CHECK_EQUAL(messages[1]["method"].asString(), "textDocument/publishDiagnostics");
+	BOOST_CHECK_EQUAL(messages[1]["params"]["uri"].asString(), "a.solpp");
+	BOOST_CHECK_EQUAL(messages[2]["id"].asString(), "request");
+	BOOST_CHECK_EQUAL(messages[2]["error"]["code"].asInt(), -32601);
+	BOOST_CHECK_EQUAL(messages[2]["error"]["message"].asString(), "Unknown method");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}